@@ -0,0 +1,236 @@
+/**
+ * @file adc_sampler.h
+ * @author QuantumSpawner jet22854111@gmail.com
+ * @brief STM32 mcu module for sampling adc channels by circular dma and feeding
+ * them to filters.
+ */
+
+#ifndef STM32_MODULE_ADC_SAMPLER_H
+#define STM32_MODULE_ADC_SAMPLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// glibc include
+#include <stdbool.h>
+#include <stdint.h>
+
+// stm32 include
+#include "stm32_module/stm32_hal.h"
+
+// freertos include
+#include "FreeRTOS.h"
+
+// stm32_module include
+#include "stm32_module/error_handler.h"
+#include "stm32_module/filter.h"
+#include "stm32_module/filter_bank.h"
+#include "stm32_module/module_common.h"
+
+#if defined(HAL_ADC_MODULE_ENABLED)
+
+/* macro ---------------------------------------------------------------------*/
+// parameter
+#define ADC_SAMPLER_TASK_PRIORITY TaskPriorityHigh
+#define ADC_SAMPLER_TASK_STACK_SIZE (4 * configMINIMAL_STACK_SIZE)
+#define ADC_SAMPLER_MAX_CHANNELS 16
+
+// buffer size
+/// @brief Number of uint16_t in the dma buffer of AdcSampler, i.e. two halves
+/// of NUM_SAMPLES conversions of every channel.
+#define ADC_SAMPLER_DMA_BUFFER_SIZE(NUM_CHANNELS, NUM_SAMPLES) \
+  (2 * (NUM_CHANNELS) * (NUM_SAMPLES))
+
+// assert macro
+#define IS_ADC_SAMPLER_CHANNEL(CHANNEL) \
+  ((CHANNEL) >= 0 && (CHANNEL) < ADC_SAMPLER_MAX_CHANNELS)
+
+/* class inherited from Task -------------------------------------------------*/
+/**
+ * @brief Class for sampling adc channels by circular dma and feeding them to
+ * filters in block.
+ *
+ * The dma buffer is split into two halves of interleaved conversions of every
+ * channel. When dma completes a half, the half is handed to the task without
+ * copying while dma fills the other half, and the task feeds every conversion
+ * to the filter bank and de-interleaves every channel to its filter in block
+ * by Filter_update_block(), which should be processed before dma completes the
+ * other half.
+ *
+ * If dma completes a half while the other half, which dma is now writing to,
+ * is not yet processed, the half is overrun and ERROR_CODE_ADC is set to the
+ * error handler until a half is processed without overrun. The task then
+ * drops the stale half being overwritten by dma and skips to the newest half,
+ * so that it never processes a half dma is writing to.
+ */
+typedef struct adc_sampler {
+  // inherited class
+  Task super_;
+
+  // member variable
+  ADC_HandleTypeDef* adc_handle_;
+
+  ErrorHandler* error_handler_;
+
+  /// @brief Circular dma buffer of two halves of interleaved conversions.
+  uint16_t* dma_buffer_;
+
+  int num_channels_;
+
+  /// @brief Number of conversions of every channel in each half.
+  int num_samples_;
+
+  /// @brief Buffer for de-interleaving a channel of a half.
+  float* channel_buffer_;
+
+  /// @brief Filter of each channel, NULL if the channel is not filtered.
+  Filter* filter_[ADC_SAMPLER_MAX_CHANNELS];
+
+  FilterBank* filter_bank_;
+
+  /// @brief Buffer for converting a conversion of every channel to float for
+  /// the filter bank.
+  float frame_[ADC_SAMPLER_MAX_CHANNELS];
+
+  /// @brief Bits of halves handed to the task but not yet processed.
+  volatile uint32_t pending_;
+
+  /// @brief Half for the task to process next.
+  uint32_t next_half_;
+
+  /// @brief Number of halves processed.
+  volatile uint32_t block_count_;
+
+  /// @brief Number of halves overrun.
+  volatile uint32_t overrun_count_;
+
+  /// @brief Number of stale halves dropped without processing.
+  volatile uint32_t skipped_count_;
+
+  /// @brief Overrun count when the task last checked for overrun.
+  uint32_t reported_overrun_count_;
+
+  /// @brief If ERROR_CODE_ADC is currently set by the sampler.
+  bool is_overrun_;
+
+  StackType_t task_stack_[ADC_SAMPLER_TASK_STACK_SIZE];
+
+  /// @brief List control block for tracking the list of adc samplers.
+  struct list_cb adc_sampler_list_cb;
+} AdcSampler;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for AdcSampler.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] adc_handle Adc handler, configured for scanning num_channels
+ * channels continuously with circular dma of half word.
+ * @param[in] dma_buffer The dma buffer, must have length of at least
+ * ADC_SAMPLER_DMA_BUFFER_SIZE(num_channels, num_samples).
+ * @param[in] num_channels The number of channels scanned by adc.
+ * @param[in] num_samples The number of conversions of every channel in each
+ * half of dma buffer.
+ * @param[in] channel_buffer The buffer for de-interleaving a channel, must have
+ * length of at least num_samples.
+ * @param[in,out] error_handler The error handler to report overrun, NULL if no
+ * need to report overrun.
+ * @return None.
+ * @note User is resposible for managing memory for dma_buffer and
+ * channel_buffer.
+ * @note The dma buffer is read by the task without copying or cache
+ * maintenance, hence it must be placed in memory accessible by dma and not
+ * cached, e.g. by mpu on mcu with data cache.
+ */
+void AdcSampler_ctor(AdcSampler* const self,
+                     ADC_HandleTypeDef* const adc_handle,
+                     uint16_t* const dma_buffer, const int num_channels,
+                     const int num_samples, float* const channel_buffer,
+                     ErrorHandler* const error_handler);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function to add adc sampler to freertos task and start adc with
+ * circular dma.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return ModuleRet Error code.
+ * @retval ModuleError The sampler is already started or adc failed to start.
+ */
+ModuleRet AdcSampler_start(AdcSampler* const self);
+
+/**
+ * @brief Function to set the filter of a channel, which is fed with a block of
+ * the channel every half of dma buffer.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] channel The channel, i.e. the rank of the channel in the adc scan
+ * sequence starting from 0.
+ * @param[in,out] filter The filter, NULL if the channel is not filtered.
+ * @return ModuleRet Error code.
+ * @note Chain filters by their chained filter to filter a channel by multiple
+ * stages, and wrap the last stage by FilterPublisher to read the filtered data
+ * from other tasks or interrupts.
+ * @note This function can only be called before the adc sampler is started.
+ */
+ModuleRet AdcSampler_set_filter(AdcSampler* const self, const int channel,
+                                Filter* const filter);
+
+/**
+ * @brief Function to set the filter bank of every channel, which is fed with
+ * every conversion of every channel.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] filter_bank The filter bank with the same number of channels
+ * as the adc sampler, NULL if no filter bank.
+ * @return ModuleRet Error code.
+ * @note Conversions in dma buffer are already in the layout of the data of
+ * FilterBank_update(), hence need no de-interleaving.
+ * @note This function can only be called before the adc sampler is started.
+ */
+ModuleRet AdcSampler_set_filter_bank(AdcSampler* const self,
+                                     FilterBank* const filter_bank);
+
+/**
+ * @brief Function to get the number of halves of dma buffer processed.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Number of halves processed.
+ */
+uint32_t AdcSampler_get_block_count(const AdcSampler* const self);
+
+/**
+ * @brief Function to get the number of halves of dma buffer overrun, including
+ * overrun reported by adc.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Number of halves overrun.
+ */
+uint32_t AdcSampler_get_overrun_count(const AdcSampler* const self);
+
+/**
+ * @brief Function to get the number of stale halves of dma buffer dropped
+ * without processing due to overrun.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Number of halves dropped.
+ */
+uint32_t AdcSampler_get_skipped_count(const AdcSampler* const self);
+
+/**
+ * @brief Function to run in freertos task.
+ *
+ * @param[in,out] _self The instance of the class.
+ * @return None.
+ * @warning For internal use only.
+ */
+void AdcSampler_task_code(void* const _self);
+
+#endif  // HAL_ADC_MODULE_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STM32_MODULE_ADC_SAMPLER_H
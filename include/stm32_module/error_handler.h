@@ -16,6 +16,8 @@ extern "C" {
 
 // freertos include
 #include "FreeRTOS.h"
+#include "event_groups.h"
+#include "queue.h"
 
 // stm32_module include
 #include "stm32_module/module_common.h"
@@ -24,13 +26,59 @@ extern "C" {
 // parmeter
 #define ERROR_HANDLER_TASK_PRIORITY TaskPriorityRealtime
 #define ERROR_HANDLER_TASK_STACK_SIZE (8 * configMINIMAL_STACK_SIZE)
+// must be power of 2
+#define ERROR_HANDLER_EVENT_QUEUE_LENGTH 32UL
+#define ERROR_HANDLER_EVENT_BATCH_SIZE 8
+// at most 32
+#define ERROR_HANDLER_MAX_CALLBACKS 16
+#define ERROR_CALLBACK_WORKER_TASK_STACK_SIZE (8 * configMINIMAL_STACK_SIZE)
+#define ERROR_CALLBACK_WORKER_QUEUE_LENGTH 16
+// an error code without policy is in storm when it changes state at least
+// ERROR_HANDLER_STORM_THRESHOLD times within ERROR_HANDLER_STORM_WINDOW ms
+#define ERROR_HANDLER_STORM_WINDOW 100
+#define ERROR_HANDLER_STORM_THRESHOLD 50
+
+// number of words for storing error code, each word has ERROR_CODE_WORD_BITS
+// bits of error code
+#ifndef ERROR_CODE_NUM_WORDS
+#define ERROR_CODE_NUM_WORDS 2UL
+#endif
 
+// layout of error code: bits [0, ERROR_CODE_WORD_BITS) are the error code bits
+// of a word, bits [ERROR_CODE_WORD_BITS, MAX_ERROR_CODE_BITS) are the index of
+// the word and the most significant bit is reserved for ERROR_SET
 #define MAX_ERROR_CODE_BITS 31UL
+#define ERROR_CODE_WORD_BITS 27UL
 #define ERROR_CODE_INVALID_BITS (~((1UL << MAX_ERROR_CODE_BITS) - 1UL))
+#define ERROR_CODE_BITS_MASK ((1UL << ERROR_CODE_WORD_BITS) - 1UL)
+#define ERROR_CODE_WORD_MASK \
+  (((1UL << MAX_ERROR_CODE_BITS) - 1UL) & ~ERROR_CODE_BITS_MASK)
+
+#if ERROR_CODE_NUM_WORDS > \
+    (1UL << (MAX_ERROR_CODE_BITS - ERROR_CODE_WORD_BITS))
+#error "ERROR_CODE_NUM_WORDS exceeds the number of encodable words"
+#endif
+
+#if (ERROR_HANDLER_EVENT_QUEUE_LENGTH & (ERROR_HANDLER_EVENT_QUEUE_LENGTH - 1UL))
+#error "ERROR_HANDLER_EVENT_QUEUE_LENGTH must be power of 2"
+#endif
+
+#if ERROR_HANDLER_MAX_CALLBACKS > 32
+#error "ERROR_HANDLER_MAX_CALLBACKS must not exceed 32"
+#endif
+
+// error code helper
+#define ERROR_CODE(WORD, BIT) \
+  (((uint32_t)(WORD) << ERROR_CODE_WORD_BITS) | (1UL << (BIT)))
+#define ERROR_CODE_WORD(CODE) \
+  (((CODE) & ERROR_CODE_WORD_MASK) >> ERROR_CODE_WORD_BITS)
+#define ERROR_CODE_BITS(CODE) ((CODE) & ERROR_CODE_BITS_MASK)
 
 // error_code
 #define ERROR_CODE_NO_ERROR 0UL
-#define ERROR_CODE_ALL ((1UL << MAX_ERROR_CODE_BITS) - 1UL)
+#define ERROR_CODE_ALL ERROR_CODE_BITS_MASK
+#define ERROR_CODE_WORD_ALL(WORD) \
+  (((uint32_t)(WORD) << ERROR_CODE_WORD_BITS) | ERROR_CODE_BITS_MASK)
 
 #define ERROR_CODE_CAN_TX 0x00000001UL
 #define ERROR_CODE_CAN_RX_CRITICAL 0x00000002UL
@@ -57,22 +105,156 @@ extern "C" {
 #define ERROR_CODE_AMT22 0x00002000UL
 #define ERROR_CODE_D6T 0x00004000UL
 
+// set by error handler while any error code is in storm, should not be written
+// by user
+#define ERROR_CODE_STORM 0x00008000UL
+
 // error_code_option
 #define ERROR_SET (1UL << MAX_ERROR_CODE_BITS)
 #define ERROR_CLEAR 0UL
+// clear the error regardless of its policy, e.g. latched errors
+#define ERROR_RESET 1UL
+
+// error_reaction, reactions to take in each vehicle state
+#define ERROR_REACTION_NONE 0x00UL
+#define ERROR_REACTION_TORQUE_CUT 0x01UL
+#define ERROR_REACTION_LIMP_MODE 0x02UL
+#define ERROR_REACTION_SHUTDOWN 0x04UL
+
+// vehicle status, packed into a single word for atomic access
+#define VEHICLE_STATUS_STATE(STATUS) ((VehicleState)((STATUS) & 0xFFUL))
+#define VEHICLE_STATUS_REACTION(STATUS) (((STATUS) >> 8) & 0xFFUL)
+#define VEHICLE_STATUS_CHANGE_COUNT(STATUS) ((STATUS) >> 16)
 
 // assert macro
-#define IS_ERROR_CODE(CODE)                                      \
-  ((CODE) & (ERROR_CODE_CAN_TX | ERROR_CODE_CAN_RX_CRITICAL |    \
-             ERROR_CODE_CAN_RX_OPTIONAL | ERROR_CODE_APPS_MASK | \
-             ERROR_CODE_ADC | ERROR_CODE_AMT22 | ERROR_CODE_D6T | \
-             ERROR_CODE_BSE_MASK | ERROR_CODE_PEDAL_IMPLAUSIBILITY)) 
-#define IS_ERROR_OPTION(CODE_WRITE) \
-  (((CODE_WRITE) == ERROR_SET) || ((CODE_WRITE) == ERROR_CLEAR))
+#define IS_ERROR_CODE(CODE)                          \
+  ((((CODE) & ERROR_CODE_INVALID_BITS) == 0) &&      \
+   (ERROR_CODE_WORD(CODE) < ERROR_CODE_NUM_WORDS) && \
+   (ERROR_CODE_BITS(CODE) != 0))
+#define IS_ERROR_CODE_WORD(WORD) ((WORD) < ERROR_CODE_NUM_WORDS)
+#define IS_ERROR_OPTION(CODE_WRITE)                                \
+  (((CODE_WRITE) == ERROR_SET) || ((CODE_WRITE) == ERROR_CLEAR) || \
+   ((CODE_WRITE) == ERROR_RESET))
+#define IS_SINGLE_ERROR_CODE(CODE) \
+  (IS_ERROR_CODE(CODE) &&          \
+   ((ERROR_CODE_BITS(CODE) & (ERROR_CODE_BITS(CODE) - 1UL)) == 0))
+#define IS_ERROR_SEVERITY(SEVERITY) \
+  (((SEVERITY) >= ErrorSeverityInfo) && ((SEVERITY) <= ErrorSeverityFatal))
+#define IS_VEHICLE_STATE(STATE) \
+  (((STATE) >= VehicleStateNormal) && ((STATE) <= VehicleStateFatal))
+#define IS_ERROR_REACTION(REACTION) (((REACTION) & ~0xFFUL) == 0)
+#define IS_ERROR_POLICY(POLICY)                                            \
+  (((POLICY) == ErrorPolicyDirect) || ((POLICY) == ErrorPolicyLatching) || \
+   ((POLICY) == ErrorPolicyAutoClear) || ((POLICY) == ErrorPolicyDebounce))
 
 /* type ----------------------------------------------------------------------*/
 typedef void (*ErrorCallback_t)(void*, uint32_t);
 
+/// @brief Enumerator for policy of how an error trips and clears.
+typedef enum error_policy {
+  /// @brief The error follows ERROR_SET and ERROR_CLEAR directly.
+  ErrorPolicyDirect = 0,
+
+  /// @brief The error is latched once set, and can only be cleared by
+  /// ERROR_RESET.
+  ErrorPolicyLatching,
+
+  /// @brief The error is cleared automatically after period of no
+  /// re-assertion, or by ERROR_CLEAR and ERROR_RESET.
+  ErrorPolicyAutoClear,
+
+  /// @brief The error trips only after being set count times within period,
+  /// and follows ERROR_CLEAR and ERROR_RESET directly. Clearing a tripped
+  /// error restarts the count.
+  ErrorPolicyDebounce,
+} ErrorPolicy;
+
+/// @brief Enumerator for where error callbacks are executed.
+typedef enum error_callback_execution {
+  /// @brief The callback is called in the error handler task.
+  ErrorCallbackInline = 0,
+
+  /// @brief The callback is called in an ErrorCallbackWorker task.
+  ErrorCallbackDeferred,
+
+  /// @brief Bits of an event group are set while any of the error codes is
+  /// set, and cleared otherwise.
+  ErrorCallbackEventGroup,
+} ErrorCallbackExecution;
+
+/// @brief Enumerator for severity of error.
+typedef enum error_severity {
+  ErrorSeverityInfo = 0,
+  ErrorSeverityWarning,
+  ErrorSeverityDegraded,
+  ErrorSeverityFatal,
+  NumErrorSeverity,
+} ErrorSeverity;
+
+/**
+ * @brief Enumerator for state of vehicle, which is determined by the highest
+ * severity of errors currently set.
+ *
+ * @note VehicleStateFatal is latched until reset by
+ * ErrorHandler_reset_vehicle_state().
+ */
+typedef enum vehicle_state {
+  VehicleStateNormal = 0,
+  VehicleStateWarning,
+  VehicleStateDegraded,
+  VehicleStateFatal,
+  NumVehicleState,
+} VehicleState;
+
+/// @brief Struct for error event.
+struct error_event {
+  uint32_t error_code;
+
+  uint32_t option;
+
+  /// @brief Tick count when the error is written.
+  TickType_t timestamp;
+};
+
+/// @brief Struct for slot of error event queue.
+struct error_event_slot {
+  /// @brief Sequence number for synchronizing producers and consumer.
+  volatile uint32_t sequence;
+
+  struct error_event event;
+};
+
+/// @brief Struct for snapshot of error state.
+struct error_snapshot {
+  uint32_t error_code[ERROR_CODE_NUM_WORDS];
+
+  /// @brief Number of times the error state has changed.
+  uint32_t change_count;
+};
+
+/// @brief Struct for error policy control block.
+struct error_policy_cb {
+  ErrorPolicy policy;
+
+  /// @brief Period in ticks for ErrorPolicyAutoClear and ErrorPolicyDebounce.
+  TickType_t period;
+
+  /// @brief Number of assertions to trip for ErrorPolicyDebounce.
+  uint32_t count;
+
+  /// @brief Number of assertions within the current window.
+  uint32_t assert_count;
+
+  /// @brief Tick count of the start of the current window.
+  TickType_t window_start;
+
+  /// @brief Tick count of the last assertion.
+  TickType_t last_assert;
+};
+
+// forward declaration
+struct error_callback_worker;
+
 /// @brief Struct for error callback control block.
 struct error_callback_cb {
   ErrorCallback_t callback;
@@ -81,8 +263,22 @@ struct error_callback_cb {
 
   uint32_t error_code;
 
-  /// @brief List control block for tracking the list of error callback.
-  struct list_cb error_callback_list_cb;
+  ErrorCallbackExecution execution;
+
+  /// @brief Worker to call the callback for ErrorCallbackDeferred.
+  struct error_callback_worker* worker;
+
+  /// @brief Event group and its bits for ErrorCallbackEventGroup.
+  EventGroupHandle_t event_group;
+
+  EventBits_t event_bits;
+};
+
+/// @brief Struct for callback deferred to ErrorCallbackWorker.
+struct error_callback_item {
+  struct error_callback_cb* error_callback_cb;
+
+  uint32_t error_code;
 };
 
 /* class inherited from Task -------------------------------------------------*/
@@ -95,9 +291,101 @@ typedef struct error_handler {
   Task super_;
 
   // member variable
-  uint32_t error_code_;
+  /// @brief Error code being updated by the task.
+  uint32_t error_code_[ERROR_CODE_NUM_WORDS];
+
+  /// @brief Seqlock for publishing error_code_ to readers in any context.
+  SeqLock error_seq_lock_;
+
+  uint32_t error_seq_lock_buffer_[2][ERROR_CODE_NUM_WORDS];
+
+  /// @brief Lock-free multi-producer single-consumer queue of error events.
+  struct error_event_slot event_queue_[ERROR_HANDLER_EVENT_QUEUE_LENGTH];
+
+  /// @brief Position for producers to write the next event.
+  volatile uint32_t event_queue_head_;
 
-  List error_callback_list_;
+  /// @brief Position for the task to read the next event.
+  uint32_t event_queue_tail_;
+
+  /// @brief Number of events lost due to full queue.
+  volatile uint32_t event_overflow_count_;
+
+  /// @brief State of error code bits without policy last requested by
+  /// writers, for not queuing writes that don't change the error state.
+  volatile uint32_t requested_error_code_[ERROR_CODE_NUM_WORDS];
+
+  /// @brief Bitmap of error code bits without policy whose events are lost due
+  /// to full queue, for the task to synchronize to their requested state.
+  volatile uint32_t lost_mask_[ERROR_CODE_NUM_WORDS];
+
+  /// @brief Number of times each error code bit is set by writers.
+  volatile uint32_t occurrence_count_[ERROR_CODE_NUM_WORDS]
+                                     [ERROR_CODE_WORD_BITS];
+
+  /// @brief Number of times each error code bit without policy changes its
+  /// requested state.
+  volatile uint32_t transition_count_[ERROR_CODE_NUM_WORDS]
+                                     [ERROR_CODE_WORD_BITS];
+
+  /// @brief Bitmap of error code bits changing requested state since last
+  /// checked by the task.
+  volatile uint32_t transition_mask_[ERROR_CODE_NUM_WORDS];
+
+  /// @brief Bitmap of error code bits in storm, whose writes are not queued
+  /// but synchronized by the task once per storm window.
+  volatile uint32_t storm_mask_[ERROR_CODE_NUM_WORDS];
+
+  /// @brief Bitmap of error code bits changing requested state in the current
+  /// storm window.
+  uint32_t storm_touched_mask_[ERROR_CODE_NUM_WORDS];
+
+  /// @brief transition_count_ at the start of the current storm window.
+  uint32_t storm_base_count_[ERROR_CODE_NUM_WORDS][ERROR_CODE_WORD_BITS];
+
+  TickType_t storm_window_start_;
+
+  /// @brief Tick count when the error state being passed to callbacks
+  /// changed.
+  TickType_t change_timestamp_;
+
+  /// @brief Error policies of each error code bit, NULL for
+  /// ErrorPolicyDirect.
+  struct error_policy_cb* error_policies_[ERROR_CODE_NUM_WORDS]
+                                         [ERROR_CODE_WORD_BITS];
+
+  /// @brief Bitmap of error code bits having policy other than
+  /// ErrorPolicyDirect.
+  uint32_t error_policy_mask_[ERROR_CODE_NUM_WORDS];
+
+  /// @brief Bitmap of error code bits with ErrorPolicyAutoClear that are set.
+  uint32_t auto_clear_mask_[ERROR_CODE_NUM_WORDS];
+
+  /// @brief Bitmap of error code bits of each severity.
+  uint32_t severity_mask_[NumErrorSeverity][ERROR_CODE_NUM_WORDS];
+
+  /// @brief Reactions to take in each vehicle state.
+  uint8_t reaction_table_[NumVehicleState];
+
+  VehicleState vehicle_state_;
+
+  /// @brief Vehicle state, reaction and change count packed by
+  /// VEHICLE_STATUS_*() macros.
+  volatile uint32_t vehicle_status_;
+
+  volatile uint32_t vehicle_state_reset_;
+
+  /// @brief Registered error callbacks, indexed by the bits of
+  /// error_callback_map_.
+  struct error_callback_cb* volatile error_callbacks_
+      [ERROR_HANDLER_MAX_CALLBACKS];
+
+  volatile uint32_t num_error_callbacks_;
+
+  /// @brief Bitmap of the indices of callbacks subscribing to each error code
+  /// bit.
+  volatile uint32_t error_callback_map_[ERROR_CODE_NUM_WORDS]
+                                       [ERROR_CODE_WORD_BITS];
 
   StackType_t task_stack_[ERROR_HANDLER_TASK_STACK_SIZE];
 } ErrorHandler;
@@ -130,33 +418,228 @@ ModuleRet ErrorHandler_start(ErrorHandler* const self);
  * @param[in] arg The argument of the callback function.
  * @param[in] error_code The error code when matched to call the callback.
  * @return ModuleRet Error code.
+ * @retval ModuleError ERROR_HANDLER_MAX_CALLBACKS callbacks are already added.
  * @note User is resposible for managing memory for error_callback_cb.
+ * @note Error codes combined in error_code must belong to the same word.
+ * @note The callback is published lock-free, hence this function can be
+ * called while the error handler is running.
+ * @note The callback is called in the error handler task, hence it must be
+ * short and must not block. Otherwise use
+ * ErrorHandler_add_deferred_error_callback().
  */
 ModuleRet ErrorHandler_add_error_callback(
     ErrorHandler* const self, struct error_callback_cb* const error_callback_cb,
     ErrorCallback_t callback, void* const arg, const uint32_t error_code);
 
+/**
+ * @brief Function to add error callback called by a worker task instead of the
+ * error handler task.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] error_callback_cb Error callback control block for the
+ * callback.
+ * @param[in,out] worker The worker to call the callback.
+ * @param[in] callback The callback function.
+ * @param[in] arg The argument of the callback function.
+ * @param[in] error_code The error code when matched to call the callback.
+ * @return ModuleRet Error code.
+ * @retval ModuleError ERROR_HANDLER_MAX_CALLBACKS callbacks are already added.
+ * @note User is resposible for managing memory for error_callback_cb.
+ * @note Error codes combined in error_code must belong to the same word.
+ * @note Callbacks sharing the same worker are called in order at the priority
+ * of the worker.
+ */
+ModuleRet ErrorHandler_add_deferred_error_callback(
+    ErrorHandler* const self, struct error_callback_cb* const error_callback_cb,
+    struct error_callback_worker* const worker, ErrorCallback_t callback,
+    void* const arg, const uint32_t error_code);
+
+/**
+ * @brief Function to add event group bits that are set while any of the error
+ * codes is set, and cleared otherwise, for tasks to wait on.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] error_callback_cb Error callback control block for the event
+ * group.
+ * @param[in] event_group The event group.
+ * @param[in] event_bits The bits of the event group.
+ * @param[in] error_code The error code to reflect to the event group bits.
+ * @return ModuleRet Error code.
+ * @retval ModuleError ERROR_HANDLER_MAX_CALLBACKS callbacks are already added.
+ * @note User is resposible for managing memory for error_callback_cb.
+ * @note Error codes combined in error_code must belong to the same word.
+ */
+ModuleRet ErrorHandler_add_error_event_group(
+    ErrorHandler* const self, struct error_callback_cb* const error_callback_cb,
+    EventGroupHandle_t event_group, const EventBits_t event_bits,
+    const uint32_t error_code);
+
+/**
+ * @brief Function to add policy of how an error trips and clears.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] error_policy_cb Error policy control block for the policy.
+ * @param[in] error_code The error code to apply the policy, must be a single
+ * error code.
+ * @param[in] policy The policy.
+ * @param[in] period Period in ms for ErrorPolicyAutoClear and
+ * ErrorPolicyDebounce.
+ * @param[in] count Number of assertions to trip for ErrorPolicyDebounce.
+ * @return ModuleRet Error code.
+ * @note User is resposible for managing memory for error_policy_cb.
+ * @note This function can only be called before the error handler is started.
+ */
+ModuleRet ErrorHandler_add_error_policy(
+    ErrorHandler* const self, struct error_policy_cb* const error_policy_cb,
+    const uint32_t error_code, const ErrorPolicy policy, const uint32_t period,
+    const uint32_t count);
+
 /**
  * @brief Function to set or clear error.
  *
  * @param[in,out] self The instance of the class.
  * @param[in] error_code Code correspond to the error.
- * @param[in] option Set or clear the error.
+ * @param[in] option Set, clear or reset the error.
  * @return ModuleRet Error code.
+ * @retval ModuleBusy The event queue is full and the event is lost, which is
+ * counted in the overflow count, while error codes without policy still
+ * follow the requested state.
+ * @note Error codes combined in error_code must belong to the same word.
+ * @note Errors are queued as timestamped events by a lock-free queue and are
+ * applied by the task in the order written, hence this function can be called
+ * from both task and interrupt context. After applying the queued events,
+ * error codes without policy follow the state last requested by writers,
+ * which settles events of concurrent writers queued out of order.
+ * @note Callbacks are only called when the error state actually changes after
+ * applying the error policy, with the changed error code bits along with
+ * ERROR_SET or ERROR_CLEAR.
+ * @note For error codes without policy, writes that don't change the
+ * requested state are not queued and don't wake the task. Error codes in
+ * storm are not queued either, and instead follow the last requested state
+ * once per ERROR_HANDLER_STORM_WINDOW, while ERROR_CODE_STORM is set.
  */
 ModuleRet ErrorHandler_write_error(ErrorHandler* const self,
                                    const uint32_t error_code,
                                    const uint32_t option);
 
 /**
- * @brief Function to get current error code.
+ * @brief Function to get current error code of a word.
  *
  * @param[in,out] self The instance of the class.
- * @param[out] uint32_t Error code.
+ * @param[in] word The index of the word to get, i.e. ERROR_CODE_WORD() of the
+ * error code.
+ * @param[out] code Error code bits of the word, without the word index.
  * @return ModuleRet Error code.
+ * @note This function can be called from both task and interrupt context.
  */
 ModuleRet ErrorHandler_get_error(const ErrorHandler* const self,
-                                 uint32_t* code);
+                                 const uint32_t word, uint32_t* const code);
+
+/**
+ * @brief Function to get a consistent snapshot of all error code words along
+ * with the number of times the error state has changed.
+ *
+ * @param[in] self The instance of the class.
+ * @param[out] snapshot The snapshot of error state.
+ * @return ModuleRet Error code.
+ * @note This function is lock-free and can be called from both task and
+ * interrupt context.
+ */
+ModuleRet ErrorHandler_get_snapshot(const ErrorHandler* const self,
+                                    struct error_snapshot* const snapshot);
+
+/**
+ * @brief Function to get the number of times the error state has changed,
+ * which is increased monotonically.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Number of times the error state has changed.
+ * @note This function only takes a single load, hence can be used for polling
+ * whether the error state has changed since the last snapshot.
+ */
+uint32_t ErrorHandler_get_change_count(const ErrorHandler* const self);
+
+/**
+ * @brief Function to get the tick count when the error state being passed to
+ * callbacks changed, i.e. when the error was written for queued errors.
+ *
+ * @param[in] self The instance of the class.
+ * @return TickType_t Tick count when the error state changed.
+ * @note This function is only valid in callbacks with ErrorCallbackInline,
+ * since the error handler task may have moved on when deferred callbacks are
+ * called.
+ */
+TickType_t ErrorHandler_get_change_timestamp(const ErrorHandler* const self);
+
+/**
+ * @brief Function to set severity of errors, which is ErrorSeverityInfo by
+ * default.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] error_code The error code to set severity.
+ * @param[in] severity The severity.
+ * @return ModuleRet Error code.
+ * @note Error codes combined in error_code must belong to the same word.
+ * @note This function can only be called before the error handler is started.
+ */
+ModuleRet ErrorHandler_set_error_severity(ErrorHandler* const self,
+                                         const uint32_t error_code,
+                                         const ErrorSeverity severity);
+
+/**
+ * @brief Function to set reactions to take in a vehicle state, which is
+ * ERROR_REACTION_NONE by default.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] state The vehicle state.
+ * @param[in] reaction The reactions, combination of ERROR_REACTION_*.
+ * @return ModuleRet Error code.
+ * @note This function can only be called before the error handler is started.
+ */
+ModuleRet ErrorHandler_set_reaction(ErrorHandler* const self,
+                                    const VehicleState state,
+                                    const uint32_t reaction);
+
+/**
+ * @brief Function to get vehicle status, including vehicle state, reactions to
+ * take and number of times the vehicle status has changed.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Vehicle status, unpacked by VEHICLE_STATUS_*() macros.
+ * @note This function only takes a single load and can be called from both
+ * task and interrupt context.
+ */
+uint32_t ErrorHandler_get_vehicle_status(const ErrorHandler* const self);
+
+/**
+ * @brief Function to reset latched VehicleStateFatal, which only takes effect
+ * if no fatal error is currently set.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return ModuleRet Error code.
+ */
+ModuleRet ErrorHandler_reset_vehicle_state(ErrorHandler* const self);
+
+/**
+ * @brief Function to get the number of times an error is set by
+ * ErrorHandler_write_error(), including writes that don't change the error
+ * state.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] error_code The error code, must be a single error code.
+ * @return uint32_t Number of times the error is set.
+ */
+uint32_t ErrorHandler_get_occurrence_count(const ErrorHandler* const self,
+                                           const uint32_t error_code);
+
+/**
+ * @brief Function to get the number of error events lost due to full event
+ * queue.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Number of lost error events.
+ */
+uint32_t ErrorHandler_get_overflow_count(const ErrorHandler* const self);
 
 /**
  * @brief Function to run in freertos task.
@@ -167,6 +650,70 @@ ModuleRet ErrorHandler_get_error(const ErrorHandler* const self,
  */
 void ErrorHandler_task_code(void* const _self);
 
+/* class inherited from Task -------------------------------------------------*/
+/**
+ * @brief Class for calling deferred error callbacks at a chosen priority, so
+ * that slow callbacks don't delay the error handler task.
+ *
+ */
+typedef struct error_callback_worker {
+  // inherited class
+  Task super_;
+
+  // member variable
+  UBaseType_t task_priority_;
+
+  QueueHandle_t callback_queue_;
+
+  StaticQueue_t callback_queue_cb_;
+
+  struct error_callback_item
+      callback_queue_buffer_[ERROR_CALLBACK_WORKER_QUEUE_LENGTH];
+
+  /// @brief Number of callbacks lost due to full queue.
+  volatile uint32_t dropped_count_;
+
+  StackType_t task_stack_[ERROR_CALLBACK_WORKER_TASK_STACK_SIZE];
+} ErrorCallbackWorker;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for ErrorCallbackWorker.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] task_priority The priority of the worker task.
+ * @return None.
+ */
+void ErrorCallbackWorker_ctor(ErrorCallbackWorker* const self,
+                              const UBaseType_t task_priority);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function to add error callback worker to freertos task.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return ModuleRet Error code.
+ */
+ModuleRet ErrorCallbackWorker_start(ErrorCallbackWorker* const self);
+
+/**
+ * @brief Function to get the number of callbacks lost due to full queue.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Number of lost callbacks.
+ */
+uint32_t ErrorCallbackWorker_get_dropped_count(
+    const ErrorCallbackWorker* const self);
+
+/**
+ * @brief Function to run in freertos task.
+ *
+ * @param[in,out] _self The instance of the class.
+ * @return None.
+ * @warning For internal use only.
+ */
+void ErrorCallbackWorker_task_code(void* const _self);
+
 #ifdef __cplusplus
 }
 #endif
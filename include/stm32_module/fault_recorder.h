@@ -0,0 +1,221 @@
+/**
+ * @file fault_recorder.h
+ * @author QuantumSpawner jet22854111@gmail.com
+ * @brief STM32 mcu module for recording error transitions to flash.
+ */
+
+#ifndef STM32_MODULE_FAULT_RECORDER_H
+#define STM32_MODULE_FAULT_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// glibc include
+#include <stdint.h>
+
+// freertos include
+#include "FreeRTOS.h"
+
+// stm32_module include
+#include "stm32_module/error_handler.h"
+#include "stm32_module/flash.h"
+#include "stm32_module/module_common.h"
+
+/* macro ---------------------------------------------------------------------*/
+// parameter
+#define FAULT_RECORDER_TASK_PRIORITY TaskPriorityLow
+#define FAULT_RECORDER_TASK_STACK_SIZE (4 * configMINIMAL_STACK_SIZE)
+// must be power of 2
+#define FAULT_RECORDER_RING_LENGTH 32UL
+#define FAULT_RECORDER_FREEZE_FRAME_SIZE 16UL
+#define FAULT_RECORDER_MAX_ATTEMPTS 3
+
+#if (FAULT_RECORDER_RING_LENGTH & (FAULT_RECORDER_RING_LENGTH - 1UL))
+#error "FAULT_RECORDER_RING_LENGTH must be power of 2"
+#endif
+
+// assert macro
+#define IS_FREEZE_FRAME_SIZE(SIZE) ((SIZE) <= FAULT_RECORDER_FREEZE_FRAME_SIZE)
+
+/* type ----------------------------------------------------------------------*/
+/// @brief Struct for record of error transition, which is also the layout of
+/// the record in flash.
+struct fault_record {
+  /// @brief Sequence number of the record in the log, increased monotonically
+  /// across power cycles.
+  uint32_t sequence;
+
+  /// @brief Tick count when the error state changed.
+  uint32_t timestamp;
+
+  /// @brief Changed error code bits along with ERROR_SET or ERROR_CLEAR.
+  uint32_t error_code;
+
+  /// @brief Copy of the freeze frame when the error state changed.
+  uint8_t freeze_frame[FAULT_RECORDER_FREEZE_FRAME_SIZE];
+
+  /// @brief Checksum of the record for detecting erased or partially written
+  /// records.
+  uint32_t checksum;
+};
+
+/* class inherited from Task -------------------------------------------------*/
+/**
+ * @brief Class for recording error transitions of ErrorHandler along with a
+ * freeze frame, and persisting them to a log in flash.
+ *
+ * Transitions are captured into a ring buffer by an error callback in the
+ * error handler task, and flushed to flash by a low priority task. The log is
+ * appended sector by sector in a circular manner, where the oldest sector is
+ * erased when the log wraps around, hence the wear is spread evenly across all
+ * sectors.
+ */
+typedef struct fault_recorder {
+  // inherited class
+  Task super_;
+
+  // member variable
+  Flash* flash_;
+
+  /// @brief The error handler attached to, for the time of transitions.
+  ErrorHandler* error_handler_;
+
+  /// @brief User data copied into every record.
+  const void* freeze_frame_;
+
+  uint32_t freeze_frame_size_;
+
+  /// @brief Single-producer single-consumer ring of records not yet flushed.
+  struct fault_record ring_[FAULT_RECORDER_RING_LENGTH];
+
+  /// @brief Position for the error callback to write the next record.
+  volatile uint32_t ring_head_;
+
+  /// @brief Position for the task to flush the next record.
+  volatile uint32_t ring_tail_;
+
+  /// @brief Number of records lost due to full ring or failed flash.
+  volatile uint32_t dropped_count_;
+
+  /// @brief Number of failed flash writes and erases.
+  volatile uint32_t write_failure_count_;
+
+  /// @brief Sequence number of the next record to write to flash.
+  uint32_t sequence_;
+
+  /// @brief Sector and slot of the next record to write to flash.
+  int sector_;
+
+  int slot_;
+
+  int slots_per_sector_;
+
+  struct error_callback_cb error_callback_cb_[ERROR_CODE_NUM_WORDS];
+
+  StackType_t task_stack_[FAULT_RECORDER_TASK_STACK_SIZE];
+} FaultRecorder;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for FaultRecorder.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] flash The flash to persist the log, must have at least 2 sectors
+ * and sectors must be able to hold at least one record.
+ * @return None.
+ * @note The whole flash is used by the log.
+ */
+void FaultRecorder_ctor(FaultRecorder* const self, Flash* const flash);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function to add fault recorder to freertos task, which also recovers
+ * the position of the log in flash.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return ModuleRet Error code.
+ */
+ModuleRet FaultRecorder_start(FaultRecorder* const self);
+
+/**
+ * @brief Function to attach the fault recorder to an error handler to record
+ * transitions of all error codes.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] error_handler The error handler to attach to.
+ * @return ModuleRet Error code.
+ * @retval ModuleError Not enough callback slots left in the error handler.
+ * @note Records are captured by the error handler task, hence recording adds
+ * no work to ErrorHandler_write_error().
+ */
+ModuleRet FaultRecorder_attach(FaultRecorder* const self,
+                               ErrorHandler* const error_handler);
+
+/**
+ * @brief Function to register user data to be copied into every record, e.g.
+ * filtered pedal values.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The freeze frame data.
+ * @param[in] size The size of the data, at most
+ * FAULT_RECORDER_FREEZE_FRAME_SIZE.
+ * @return ModuleRet Error code.
+ * @note User is resposible for managing memory for data.
+ * @note The data is copied by the error handler task without locking, hence
+ * it should be written atomically or only by lower priority tasks.
+ * @note This function can only be called before the fault recorder is started.
+ */
+ModuleRet FaultRecorder_set_freeze_frame(FaultRecorder* const self,
+                                         const void* const data,
+                                         const uint32_t size);
+
+/**
+ * @brief Function to read a record persisted in flash.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] index The index of the record, where 0 is the most recent one.
+ * @param[out] record The record.
+ * @return ModuleRet Error code.
+ * @retval ModuleError The record does not exist or has been overwritten.
+ */
+ModuleRet FaultRecorder_read_record(FaultRecorder* const self,
+                                    const uint32_t index,
+                                    struct fault_record* const record);
+
+/**
+ * @brief Function to get the number of records lost due to full ring, or flash
+ * failing in all FAULT_RECORDER_MAX_ATTEMPTS attempts.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Number of lost records.
+ */
+uint32_t FaultRecorder_get_dropped_count(const FaultRecorder* const self);
+
+/**
+ * @brief Function to get the number of failed flash writes and erases.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t Number of failed flash writes and erases.
+ * @note A slot failed to write is skipped and the record is retried at the
+ * next slot, while a sector failed to erase is skipped as a whole. Skipped
+ * slots consume sequence numbers, hence read as ModuleError by
+ * FaultRecorder_read_record().
+ */
+uint32_t FaultRecorder_get_write_failure_count(
+    const FaultRecorder* const self);
+
+/**
+ * @brief Function to run in freertos task.
+ *
+ * @param[in,out] _self The instance of the class.
+ * @return None.
+ * @warning For internal use only.
+ */
+void FaultRecorder_task_code(void* const _self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STM32_MODULE_FAULT_RECORDER_H
@@ -7,9 +7,9 @@
 #ifndef STM32_MODULE_FILTER_H
 #define STM32_MODULE_FILTER_H
 
-// freertos include
-#include "FreeRTOS.h"
-#include "queue.h"
+// glibc include
+#include <stdbool.h>
+#include <stdint.h>
 
 // stm32_module include
 #include "stm32_module/module_common.h"
@@ -18,6 +18,31 @@
 // assert macro
 #define IS_IN_VALUE_RANGE(VAL) ((VAL) >= 0.0F && (VAL) <= 1.0F)
 
+/// @brief Maximum window size of MedianFilter, as the heap indices are stored
+/// in bytes.
+#define MEDIAN_FILTER_MAX_WINDOW_SIZE 255
+
+/// @brief Maximum number of integrator and comb stages of CicDecimator.
+#define CIC_DECIMATOR_MAX_ORDER 4
+
+/// @brief Maximum decimation ratio of CicDecimator, so that the dc gain of
+/// CIC_DECIMATOR_MAX_ORDER stages is exact in float.
+#define CIC_DECIMATOR_MAX_DECIMATION 64
+
+#define IS_CIC_DECIMATOR_ORDER(ORDER) \
+  ((ORDER) >= 1 && (ORDER) <= CIC_DECIMATOR_MAX_ORDER)
+#define IS_CIC_DECIMATOR_DECIMATION(DECIMATION) \
+  ((DECIMATION) >= 1 && (DECIMATION) <= CIC_DECIMATOR_MAX_DECIMATION)
+
+/// @brief Maximum order of polynomial of SavitzkyGolayFilter.
+#define SAVITZKY_GOLAY_FILTER_MAX_ORDER 4
+
+#define IS_SAVITZKY_GOLAY_FILTER_ORDER(ORDER) \
+  ((ORDER) >= 0 && (ORDER) <= SAVITZKY_GOLAY_FILTER_MAX_ORDER)
+
+/// @brief Maximum number of stages of FilterPipeline.
+#define FILTER_PIPELINE_MAX_NUM_STAGES 8
+
 /* abstract class ------------------------------------------------------------*/
 // forward declaration
 struct FilterVtbl;
@@ -25,6 +50,14 @@ struct FilterVtbl;
 /**
  * @brief Abstract class for managing filter.
  *
+ * Data can be added one by one by Filter_update(), or as a block by
+ * Filter_update_block(), e.g. a DMA buffer of ADC samples, which processes the
+ * whole block by each filter of the chain in turn to avoid per-sample virtual
+ * function and chained filter calls.
+ *
+ * @note Filters call no kernel function, hence can be updated from both task
+ * and interrupt context, but each filter only from one context at a time. Use
+ * FilterPublisher to read the filtered data from other contexts.
  */
 typedef struct filter {
   // virtual table
@@ -39,6 +72,8 @@ struct FilterVtbl {
   ModuleRet (*update)(Filter*, float, float*);
 
   ModuleRet (*get_filtered_data)(Filter*, float*);
+
+  ModuleRet (*update_block)(Filter*, const float*, float*, int, int*);
 };
 
 /* constructor ---------------------------------------------------------------*/
@@ -76,19 +111,78 @@ ModuleRet Filter_update(Filter* const self, const float data,
 ModuleRet Filter_get_filtered_data(Filter* const self,
                                    float* const filtered_data);
 
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data, which is less than
+ * length if the filter is not yet ready for some of the data, e.g. the window
+ * of moving average filter is not yet filled.
+ * @return ModuleRet Error code.
+ * @note The filtered data is the same as adding the data one by one by
+ * Filter_update() and keeping those returned with ModuleOK.
+ * @note This function is virtual, and defaults to adding the data one by one.
+ */
+ModuleRet Filter_update_block(Filter* const self, const float* const data,
+                              float* const filtered_data, const int length,
+                              int* const filtered_length);
+
+/**
+ * @brief Default implementation of Filter_update_block() adding the data one by
+ * one, for derived class without block kernel to put in its virtual table.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ * @warning For internal use only.
+ */
+ModuleRet __Filter_update_block(Filter* const self, const float* const data,
+                                float* const filtered_data, const int length,
+                                int* const filtered_length);
+
 /* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for moving average filter.
+ *
+ * Data is stored in a ring buffer with a running sum. To bound the drift of the
+ * running sum due to float rounding, the sum of the data added in the current
+ * round of the ring buffer is accumulated separately, which is the exact sum
+ * of the window once the ring buffer wraps around and replaces the running sum.
+ *
+ * The filter outputs nothing until the window is filled by default, which can
+ * be avoided by prefilling the window, restoring a saved window, or enabling
+ * partial mode to output the average of the data so far.
+ */
 typedef struct moving_average_filter {
   // inherited class
   Filter super_;
 
   // member variable
-  QueueHandle_t data_queue_;
-
-  StaticQueue_t queue_cb_;
+  float* buffer_;
 
   int window_size_;
 
+  /// @brief Number of data in the buffer.
+  int size_;
+
+  /// @brief Index of the buffer to write the next data.
+  int index_;
+
   float sum_;
+
+  /// @brief Sum of the data added since the ring buffer last wrapped around.
+  float round_sum_;
+
+  /// @brief Whether to output the average of the data so far before the
+  /// window is filled.
+  bool is_partial_;
 } MovingAverageFilter;
 
 /* constructor ---------------------------------------------------------------*/
@@ -96,8 +190,8 @@ typedef struct moving_average_filter {
  * @brief Constructor for MovingAverageFilter.
  *
  * @param[in,out] self The instance of the class.
- * @param[in] filter_buffer The buffer for storing data, must have length larger
- * than window_size.
+ * @param[in] filter_buffer The buffer for storing data, must have length of at
+ * least window_size.
  * @param[in] window_size The size of the filter.
  * @param[in] chained_filter The chained filter will be processed before this
  * filter, NULL if no chained filter.
@@ -118,6 +212,8 @@ void MovingAverageFilter_ctor(MovingAverageFilter* const self,
  * @param[out] filtered_data The filtered data, NULL if no need to get filtered
  * data.
  * @return ModuleRet Error code.
+ * @retval ModuleBusy The window is not yet filled and partial mode is
+ * disabled.
  */
 ModuleRet MovingAverageFilter_update(MovingAverageFilter* const self,
                                      const float data,
@@ -133,6 +229,74 @@ ModuleRet MovingAverageFilter_update(MovingAverageFilter* const self,
 ModuleRet MovingAverageFilter_get_filtered_data(MovingAverageFilter* const self,
                                                 float* const filtered_data);
 
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data, which is less than
+ * length while the window is not yet filled
+ * and partial mode is disabled.
+ * @return ModuleRet Error code.
+ */
+ModuleRet MovingAverageFilter_update_block(MovingAverageFilter* const self,
+                                           const float* const data,
+                                           float* const filtered_data,
+                                           const int length,
+                                           int* const filtered_length);
+
+/**
+ * @brief Function for enabling or disabling partial mode, where the average of
+ * the data so far is output before the window is filled.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] is_partial Whether to enable partial mode.
+ * @return None.
+ */
+void MovingAverageFilter_set_partial(MovingAverageFilter* const self,
+                                     const bool is_partial);
+
+/**
+ * @brief Function for filling the whole window with a value, e.g. the first
+ * data or the expected steady value, so that the filter outputs from the next
+ * data on.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The value to fill.
+ * @return None.
+ */
+void MovingAverageFilter_prefill(MovingAverageFilter* const self,
+                                 const float data);
+
+/**
+ * @brief Function for saving the data in the window from the oldest to the
+ * newest, e.g. to keep the filter running across a reset.
+ *
+ * @param[in] self The instance of the class.
+ * @param[out] data The buffer for the data, must have length of at least
+ * window_size.
+ * @return int The number of data saved.
+ */
+int MovingAverageFilter_save(const MovingAverageFilter* const self,
+                             float* const data);
+
+/**
+ * @brief Function for restoring the window from data saved by
+ * MovingAverageFilter_save(), discarding the current data in the window.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data from the oldest to the newest.
+ * @param[in] size The number of data.
+ * @return None.
+ * @note The window can be restored from a filter of different window size,
+ * where only the newest data that fits are kept.
+ */
+void MovingAverageFilter_restore(MovingAverageFilter* const self,
+                                 const float* const data, const int size);
+
 /* class ---------------------------------------------------------------------*/
 typedef struct normalize_filter {
   // inherited class
@@ -184,16 +348,56 @@ ModuleRet NormalizeFilter_update(NormalizeFilter* const self, const float data,
 ModuleRet NormalizeFilter_get_filtered_data(NormalizeFilter* const self,
                                             float* const filtered_data);
 
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ * @note Blocks within the current bounds are normalized by a loop that can be
+ * vectorized by the compiler.
+ */
+ModuleRet NormalizeFilter_update_block(NormalizeFilter* const self,
+                                       const float* const data,
+                                       float* const filtered_data,
+                                       const int length,
+                                       int* const filtered_length);
+
 /* class ---------------------------------------------------------------------*/
 /**
  * @brief Class for managing 1 dimensional kalman filter.
  *
+ * With constant noise covariances the gain converges within a few dozen
+ * updates. In steady state mode, the gain is fixed once it converges, so that
+ * each update needs no division and the covariance is no longer updated.
+ *
+ * @note The kalman filter can be used as the last filter of a chain, but does
+ * not have a chained filter itself.
  */
 typedef struct {
+  // inherited class
+  Filter super_;
+
+  // member variable
   float Q_;
   float R_;
   float x_;
   float P_;
+
+  /// @brief Gain of the last update, which is the steady state gain once
+  /// converged.
+  float K_;
+
+  /// @brief Relative change of gain between updates for convergence.
+  float tolerance_;
+
+  bool steady_state_enabled_;
+
+  bool is_steady_state_;
 } KalmanFilter1D;
 
 /* constructor ---------------------------------------------------------------*/
@@ -220,6 +424,54 @@ void KalmanFilter1D_ctor(KalmanFilter1D* const self, float Q, float R, float x0,
  */
 float KalmanFilter1D_update(KalmanFilter1D* const self, float z);
 
+/**
+ * @brief Function for updating the state of kalman filter by n measurements,
+ * which keeps the state in registers for the whole batch.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] z The measurements.
+ * @param[out] x The updated state after each measurement, can be the same
+ * buffer as z.
+ * @param[in] length The number of measurements.
+ * @return float The state after the last measurement.
+ * @note The result is the same as calling KalmanFilter1D_update() for each
+ * measurement.
+ */
+float KalmanFilter1D_update_n(KalmanFilter1D* const self, const float* const z,
+                              float* const x, const int length);
+
+/**
+ * @brief Function for enabling steady state mode of kalman filter, where the
+ * gain is fixed once its relative change between updates is within tolerance.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] tolerance The relative change of gain for convergence, e.g.
+ * 1e-6.
+ * @return None.
+ * @note Without process noise the gain decays to zero instead of converging,
+ * hence the mode is only meaningful for positive Q.
+ */
+void KalmanFilter1D_enable_steady_state(KalmanFilter1D* const self,
+                                        const float tolerance);
+
+/**
+ * @brief Function for disabling steady state mode of kalman filter, where the
+ * gain and covariance are updated every time again.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return None.
+ */
+void KalmanFilter1D_disable_steady_state(KalmanFilter1D* const self);
+
+/**
+ * @brief Function for checking if the gain of kalman filter is fixed to the
+ * steady state gain.
+ *
+ * @param[in] self The instance of the class.
+ * @return bool True if the gain is converged in steady state mode.
+ */
+bool KalmanFilter1D_is_steady_state(KalmanFilter1D* const self);
+
 /**
  * @brief Function for getting the current state of kalman filter.
  *
@@ -236,4 +488,818 @@ float KalmanFilter1D_get_state(KalmanFilter1D* const self);
  */
 float KalmanFilter1D_get_covariance(KalmanFilter1D* const self);
 
+/**
+ * @brief Function for updating the state of kalman filter by a block of
+ * measurements.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] z The measurements.
+ * @param[out] x The updated state after each measurement, can be the same
+ * buffer as z.
+ * @param[in] length The length of measurements.
+ * @param[out] filtered_length The number of updated states, which is always
+ * length.
+ * @return ModuleRet Error code.
+ */
+ModuleRet KalmanFilter1D_update_block(KalmanFilter1D* const self,
+                                      const float* const z, float* const x,
+                                      const int length,
+                                      int* const filtered_length);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for finite impulse response filter.
+ *
+ * The delay line is doubled, where every data is written to both halves, so
+ * that the latest num_taps data are always contiguous and the dot product with
+ * the coefficients needs no modulo per tap.
+ */
+typedef struct fir_filter {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  const float* coefficients_;
+
+  float* delay_line_;
+
+  int num_taps_;
+
+  /// @brief Index of the delay line where the latest data is.
+  int index_;
+
+  float filtered_data_;
+} FirFilter;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for FirFilter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] coefficients The coefficients of the filter, where
+ * coefficients[k] is applied to the data k samples ago.
+ * @param[in] delay_line The buffer for storing data, must have length of at
+ * least 2 * num_taps.
+ * @param[in] num_taps The number of coefficients.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note User is resposible for managing memory for coefficients and
+ * delay_line.
+ */
+void FirFilter_ctor(FirFilter* const self, const float* const coefficients,
+                    float* const delay_line, const int num_taps,
+                    Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the filter and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet FirFilter_update(FirFilter* const self, const float data,
+                           float* const filtered_data);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet FirFilter_get_filtered_data(FirFilter* const self,
+                                      float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet FirFilter_update_block(FirFilter* const self,
+                                 const float* const data,
+                                 float* const filtered_data, const int length,
+                                 int* const filtered_length);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for infinite impulse response filter of cascaded second order
+ * sections, each in direct form II transposed.
+ *
+ * Each section has coefficients {b0, b1, b2, a1, a2} of transfer function
+ * (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2), and is computed by
+ *   y = b0 x + s1,  s1 = b1 x - a1 y + s2,  s2 = b2 x - a2 y
+ * with two state variables.
+ */
+typedef struct biquad_filter {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  const float* coefficients_;
+
+  float* state_;
+
+  int num_stages_;
+
+  float filtered_data_;
+} BiquadFilter;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for BiquadFilter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] coefficients The coefficients of the sections, must have length
+ * of 5 * num_stages.
+ * @param[in] state The buffer for storing state, must have length of at least
+ * 2 * num_stages.
+ * @param[in] num_stages The number of second order sections.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note User is resposible for managing memory for coefficients and state.
+ */
+void BiquadFilter_ctor(BiquadFilter* const self,
+                       const float* const coefficients, float* const state,
+                       const int num_stages, Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the filter and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet BiquadFilter_update(BiquadFilter* const self, const float data,
+                              float* const filtered_data);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet BiquadFilter_get_filtered_data(BiquadFilter* const self,
+                                         float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ * @note The block is processed two sections at a time so that their
+ * coefficients and state stay in registers and their recurrences overlap.
+ */
+ModuleRet BiquadFilter_update_block(BiquadFilter* const self,
+                                    const float* const data,
+                                    float* const filtered_data,
+                                    const int length,
+                                    int* const filtered_length);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for sliding window median filter, for rejecting spikes that a
+ * moving average filter would smear into the output.
+ *
+ * Data is stored in a ring buffer, and the indices of the data are kept in a
+ * max heap of the lower half and a min heap of the upper half of the window
+ * sharing the median at the root, so that replacing the oldest data and
+ * finding the median takes O(log n).
+ */
+typedef struct median_filter {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  float* buffer_;
+
+  /// @brief Position in the heap of each data in the buffer.
+  int8_t* position_;
+
+  /// @brief Indices of data in the buffer, where index 0 is the median,
+  /// negative indices are the max heap and positive indices are the min heap.
+  uint8_t* heap_;
+
+  int window_size_;
+
+  /// @brief Number of data in the buffer.
+  int size_;
+
+  /// @brief Index of the buffer to write the next data.
+  int index_;
+} MedianFilter;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for MedianFilter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] filter_buffer The buffer for storing data, must have length of at
+ * least window_size.
+ * @param[in] heap_buffer The buffer for storing heap indices, must have length
+ * of at least 2 * window_size.
+ * @param[in] window_size The size of the filter, must not be greater than
+ * MEDIAN_FILTER_MAX_WINDOW_SIZE.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note User is resposible for managing memory for filter_buffer and
+ * heap_buffer.
+ */
+void MedianFilter_ctor(MedianFilter* const self, float* const filter_buffer,
+                       uint8_t* const heap_buffer, const int window_size,
+                       Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the filter and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If the window is not yet filled.
+ * @note For even window size, the filtered data is the mean of the two middle
+ * data.
+ */
+ModuleRet MedianFilter_update(MedianFilter* const self, const float data,
+                              float* const filtered_data);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If the window is not yet filled.
+ */
+ModuleRet MedianFilter_get_filtered_data(MedianFilter* const self,
+                                         float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet MedianFilter_update_block(MedianFilter* const self,
+                                    const float* const data,
+                                    float* const filtered_data,
+                                    const int length,
+                                    int* const filtered_length);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for cascaded integrator-comb decimator, for averaging high rate
+ * adc data down to the control rate with a few integer additions per data.
+ *
+ * Data is rounded to integer, e.g. raw adc counts, and accumulated by order
+ * integrators at the input rate. Every decimation data, the integrators are
+ * differenced by order combs at the output rate and scaled by the dc gain.
+ * The integrators wrap around in modular arithmetic, which cancels out in the
+ * combs as long as the output fits in 32 bits, i.e. the data must fit in
+ * 32 - order * log2(decimation) bits, e.g. 14 bits for order 3 and 64 times
+ * decimation.
+ *
+ * The passband droop of the sinc^order response can be compensated by a 3 tap
+ * fir filter {-a, 1 + 2a, -a} at the output rate with a = order / 24, which
+ * flattens the response to the second order of frequency at the cost of 1
+ * output of delay.
+ */
+typedef struct cic_decimator {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  uint32_t integrator_[CIC_DECIMATOR_MAX_ORDER];
+
+  /// @brief Last input of each comb.
+  uint32_t comb_[CIC_DECIMATOR_MAX_ORDER];
+
+  /// @brief Last 2 decimated data for compensation.
+  float compensation_[2];
+
+  /// @brief Coefficient a of compensation, 0 if not compensated.
+  float alpha_;
+
+  /// @brief Inverse of the dc gain decimation^order.
+  float gain_;
+
+  int order_;
+
+  int decimation_;
+
+  /// @brief Number of data added since the last decimated data.
+  int index_;
+
+  /// @brief Number of decimated data, up to settle_size_.
+  int size_;
+
+  /// @brief Number of decimated data until the filtered data is settled.
+  int settle_size_;
+
+  float filtered_data_;
+} CicDecimator;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for CicDecimator.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] order The number of integrator and comb stages, must not be
+ * greater than CIC_DECIMATOR_MAX_ORDER.
+ * @param[in] decimation The decimation ratio, must not be greater than
+ * CIC_DECIMATOR_MAX_DECIMATION.
+ * @param[in] compensated Whether to compensate the passband droop.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ */
+void CicDecimator_ctor(CicDecimator* const self, const int order,
+                       const int decimation, const bool compensated,
+                       Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the decimator and returns the
+ * decimated data every decimation data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added, which is rounded to integer.
+ * @param[out] filtered_data The decimated data, NULL if no need to get
+ * filtered data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If the data is not decimated into an output, or the
+ * output is not yet settled.
+ */
+ModuleRet CicDecimator_update(CicDecimator* const self, const float data,
+                              float* const filtered_data);
+
+/**
+ * @brief Function for getting the last decimated data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The decimated data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If the output is not yet settled.
+ */
+ModuleRet CicDecimator_get_filtered_data(CicDecimator* const self,
+                                         float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the decimator and returns
+ * the decimated data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The decimated data, can be the same buffer as
+ * data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of decimated data.
+ * @return ModuleRet Error code.
+ * @note The integrators are kept in registers for the whole block by a kernel
+ * specialized for each order.
+ */
+ModuleRet CicDecimator_update_block(CicDecimator* const self,
+                                    const float* const data,
+                                    float* const filtered_data,
+                                    const int length,
+                                    int* const filtered_length);
+
+/* class inherited from FirFilter --------------------------------------------*/
+/**
+ * @brief Class for Savitzky-Golay filter, which fits a polynomial to the
+ * latest window_size data by least squares and outputs its value or
+ * derivative, e.g. for pedal rate or wheel acceleration without the noise of
+ * finite differences.
+ *
+ * The fit is linear in the data, hence it is precomputed in constructor as
+ * fir coefficients and each data costs only a dot product of window_size.
+ * The polynomial can be evaluated at any point of the window, where the latest
+ * data has no delay but more noise, and the center of the window has the least
+ * noise but a delay of (window_size - 1) / 2 data.
+ */
+typedef struct savitzky_golay_filter {
+  // inherited class
+  FirFilter super_;
+
+  // member variable
+  /// @brief Number of data in the delay line, up to the window size.
+  int size_;
+} SavitzkyGolayFilter;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for SavitzkyGolayFilter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] coefficient_buffer The buffer for storing the precomputed
+ * coefficients, must have length of at least window_size.
+ * @param[in] delay_line The buffer for storing data, must have length of at
+ * least 2 * window_size.
+ * @param[in] window_size The number of data to fit, greater than order.
+ * @param[in] order The order of polynomial, must not be greater than
+ * SAVITZKY_GOLAY_FILTER_MAX_ORDER.
+ * @param[in] derivative The order of derivative to output, 0 for smoothing,
+ * must not be greater than order.
+ * @param[in] delay The point to evaluate in number of data before the latest
+ * one, from 0 to window_size - 1.
+ * @param[in] sample_period The sample period, which scales the derivative to
+ * per unit time.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note User is resposible for managing memory for coefficient_buffer and
+ * delay_line.
+ */
+void SavitzkyGolayFilter_ctor(SavitzkyGolayFilter* const self,
+                              float* const coefficient_buffer,
+                              float* const delay_line, const int window_size,
+                              const int order, const int derivative,
+                              const int delay, const float sample_period,
+                              Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the filter and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy The window is not yet filled.
+ */
+ModuleRet SavitzkyGolayFilter_update(SavitzkyGolayFilter* const self,
+                                     const float data,
+                                     float* const filtered_data);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy The window is not yet filled.
+ */
+ModuleRet SavitzkyGolayFilter_get_filtered_data(SavitzkyGolayFilter* const self,
+                                                float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data, which is less than
+ * length while the window is not yet filled.
+ * @return ModuleRet Error code.
+ */
+ModuleRet SavitzkyGolayFilter_update_block(SavitzkyGolayFilter* const self,
+                                           const float* const data,
+                                           float* const filtered_data,
+                                           const int length,
+                                           int* const filtered_length);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for slew rate limiter, which limits the change between
+ * consecutive outputs to max_step in both directions, e.g. for ramping
+ * commands to servo or motor.
+ */
+typedef struct slew_rate_limiter {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  /// @brief Maximum change of output per data.
+  float max_step_;
+
+  float filtered_data_;
+} SlewRateLimiter;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for SlewRateLimiter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] max_step The maximum change of output per data, i.e. the maximum
+ * rate times the sample period.
+ * @param[in] initial_data The output to start ramping from.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ */
+void SlewRateLimiter_ctor(SlewRateLimiter* const self, const float max_step,
+                          const float initial_data,
+                          Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the limiter and returns the limited
+ * data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The limited data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet SlewRateLimiter_update(SlewRateLimiter* const self, const float data,
+                                 float* const filtered_data);
+
+/**
+ * @brief Function for getting the last limited data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The limited data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet SlewRateLimiter_get_filtered_data(SlewRateLimiter* const self,
+                                            float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the limiter and returns
+ * the limited data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The limited data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of limited data, which is always
+ * length.
+ * @return ModuleRet Error code.
+ */
+ModuleRet SlewRateLimiter_update_block(SlewRateLimiter* const self,
+                                       const float* const data,
+                                       float* const filtered_data,
+                                       const int length,
+                                       int* const filtered_length);
+
+/**
+ * @brief Function for setting the maximum change of output per data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] max_step The maximum change of output per data.
+ * @return None.
+ */
+void SlewRateLimiter_set_max_step(SlewRateLimiter* const self,
+                                  const float max_step);
+
+/**
+ * @brief Function for resetting the output without ramping, e.g. to the
+ * measured position after an emergency stop.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The output to start ramping from.
+ * @return None.
+ */
+void SlewRateLimiter_reset(SlewRateLimiter* const self, const float data);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for running filters as the stages of a pipeline.
+ *
+ * Unlike filters chained by chained_filter, where each filter recursively
+ * updates its chained filter through the virtual table, the stages are kept in
+ * an array and updated one after another.
+ *
+ * Data passes through the stages in order. If a stage is not ready for the
+ * data, e.g. the window of a moving average filter is not yet filled, the data
+ * stops at that stage, the later stages are not updated and ModuleBusy is
+ * returned, so each stage only ever sees ready output of the previous stage.
+ * The pipeline is ready once data passes through all stages, and stays ready.
+ *
+ * Stages of the classes in this file without chained filter are updated by
+ * their kernels directly instead of through the virtual table. If fused, a
+ * moving average filter followed by a normalize filter is also processed in a
+ * single pass.
+ */
+typedef struct filter_pipeline {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  Filter* stages_[FILTER_PIPELINE_MAX_NUM_STAGES];
+
+  /// @brief Type of each stage for updating it directly.
+  uint8_t stage_types_[FILTER_PIPELINE_MAX_NUM_STAGES];
+
+  int num_stages_;
+
+  bool is_ready_;
+
+  float filtered_data_;
+} FilterPipeline;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for FilterPipeline.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] stages The filters of the pipeline in the order of processing.
+ * @param[in] num_stages The number of stages, must not be greater than
+ * FILTER_PIPELINE_MAX_NUM_STAGES.
+ * @param[in] fused Whether to fuse common combinations of stages into a single
+ * pass.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note The stages are copied, but the filters must outlive the pipeline and
+ * should not be updated other than by the pipeline.
+ */
+void FilterPipeline_ctor(FilterPipeline* const self,
+                         Filter* const* const stages, const int num_stages,
+                         const bool fused, Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the pipeline and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If a stage is not ready for the data.
+ */
+ModuleRet FilterPipeline_update(FilterPipeline* const self, const float data,
+                                float* const filtered_data);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If no data has passed through all stages yet.
+ */
+ModuleRet FilterPipeline_get_filtered_data(FilterPipeline* const self,
+                                           float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the pipeline and returns
+ * the filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ * @note The whole block is processed by each stage in turn.
+ */
+ModuleRet FilterPipeline_update_block(FilterPipeline* const self,
+                                      const float* const data,
+                                      float* const filtered_data,
+                                      const int length,
+                                      int* const filtered_length);
+
+/* class ---------------------------------------------------------------------*/
+/// @brief Struct for snapshot of filtered data published by FilterPublisher.
+struct filter_snapshot {
+  float filtered_data;
+
+  /// @brief Tick count when the filtered data is published.
+  TickType_t timestamp;
+
+  /// @brief Number of times the filtered data has been published.
+  uint32_t publish_count;
+};
+
+/**
+ * @brief Class for publishing the filtered data of a filter, which is updated
+ * in an ISR or sampling task, to readers in any task without critical section.
+ *
+ * Every filtered data of the published filter is written with its timestamp
+ * by SeqLock, hence readers always get a consistent snapshot without
+ * disabling interrupts, and a reader interrupting the writer never retries.
+ *
+ * @note Only one context may update the publisher, and the published filter
+ * must not be updated or read other than through the publisher.
+ */
+typedef struct filter_publisher {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  SeqLock seq_lock_;
+
+  /// @brief The two copies of published data for seq_lock_.
+  struct filter_publication {
+    float filtered_data;
+
+    TickType_t timestamp;
+  } seq_lock_buffer_[2];
+} FilterPublisher;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for FilterPublisher.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] filter The filter to publish, which is processed as the chained
+ * filter of the publisher.
+ * @return None.
+ */
+void FilterPublisher_ctor(FilterPublisher* const self, Filter* const filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the published filter and publishing
+ * the filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If the published filter is not ready, and nothing is
+ * published.
+ */
+ModuleRet FilterPublisher_update(FilterPublisher* const self, const float data,
+                                 float* const filtered_data);
+
+/**
+ * @brief Function for getting the last published filtered data, which can be
+ * called in any context.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If nothing is published yet.
+ */
+ModuleRet FilterPublisher_get_filtered_data(FilterPublisher* const self,
+                                            float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the published filter and
+ * publishing the last filtered data of the block.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet FilterPublisher_update_block(FilterPublisher* const self,
+                                       const float* const data,
+                                       float* const filtered_data,
+                                       const int length,
+                                       int* const filtered_length);
+
+/**
+ * @brief Function for getting a consistent snapshot of the last published
+ * filtered data and its timestamp, which can be called in any context.
+ *
+ * @param[in] self The instance of the class.
+ * @param[out] snapshot The snapshot.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If nothing is published yet.
+ */
+ModuleRet FilterPublisher_get_snapshot(const FilterPublisher* const self,
+                                       struct filter_snapshot* const snapshot);
+
+/**
+ * @brief Function for getting the number of times the filtered data has been
+ * published, e.g. for readers to detect new data without reading it.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t The number of times published.
+ */
+uint32_t FilterPublisher_get_publish_count(const FilterPublisher* const self);
+
 #endif  // STM32_MODULE_FILTER_H
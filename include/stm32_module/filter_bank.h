@@ -0,0 +1,344 @@
+/**
+ * @file filter_bank.h
+ * @author QuantumSpawner jet22854111@gmail.com
+ * @brief STM32 mcu module for filtering multiple channels of sensor signal with
+ * the same kind of filter at once.
+ */
+
+#ifndef STM32_MODULE_FILTER_BANK_H
+#define STM32_MODULE_FILTER_BANK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// glibc include
+#include <stdbool.h>
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/module_common.h"
+
+/* macro ---------------------------------------------------------------------*/
+// buffer size
+/// @brief Number of float in the buffer of MovingAverageFilterBank.
+#define MOVING_AVERAGE_FILTER_BANK_BUFFER_SIZE(NUM_CHANNELS, WINDOW_SIZE) \
+  (((WINDOW_SIZE) + 3) * (NUM_CHANNELS))
+
+/// @brief Number of float in the buffer of BiquadFilterBank.
+#define BIQUAD_FILTER_BANK_BUFFER_SIZE(NUM_CHANNELS) (8 * (NUM_CHANNELS))
+
+/// @brief Number of float in the buffer of KalmanFilter1DBank.
+#define KALMAN_FILTER_1D_BANK_BUFFER_SIZE(NUM_CHANNELS) (5 * (NUM_CHANNELS))
+
+/* abstract class ------------------------------------------------------------*/
+// forward declaration
+struct FilterBankVtbl;
+
+/**
+ * @brief Abstract class for managing a bank of filters of multiple channels.
+ *
+ * The state of all channels is stored in structure of arrays layout, i.e. each
+ * state variable of all channels is contiguous, and all channels are updated
+ * by a single loop per state variable, which can be vectorized, instead of one
+ * filter object and one virtual function call per channel.
+ */
+typedef struct filter_bank {
+  // virtual table
+  struct FilterBankVtbl* vptr_;
+
+  // member variable
+  int num_channels_;
+
+  /// @brief Filtered data of each channel.
+  float* filtered_data_;
+} FilterBank;
+
+/// @brief Virtual table for FilterBank.
+struct FilterBankVtbl {
+  ModuleRet (*update)(FilterBank*, const float*, float*);
+};
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for FilterBank.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] num_channels The number of channels.
+ * @param[in] filtered_data The buffer for storing filtered data, must have
+ * length of at least num_channels.
+ * @return None.
+ */
+void FilterBank_ctor(FilterBank* const self, const int num_channels,
+                     float* const filtered_data);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data of every channel to the filter bank and
+ * returns the current filtered data of every channel.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data of each channel, must have length of at least
+ * num_channels.
+ * @param[out] filtered_data The filtered data of each channel, NULL if no need
+ * to get filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet FilterBank_update(FilterBank* const self, const float* const data,
+                            float* const filtered_data);
+
+/**
+ * @brief Function for getting the current filtered data of a channel.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] channel The channel.
+ * @return float The filtered data, 0 before the first filtered data.
+ */
+float FilterBank_get_filtered_data(FilterBank* const self, const int channel);
+
+/* class inherited from FilterBank -------------------------------------------*/
+/**
+ * @brief Class for moving average filter bank, same as MovingAverageFilter for
+ * each channel.
+ *
+ * The buffer is laid out as window_size rows of data of all channels, followed
+ * by the running sums, the sums of the current round and the filtered data of
+ * all channels.
+ */
+typedef struct moving_average_filter_bank {
+  // inherited class
+  FilterBank super_;
+
+  // member variable
+  float* buffer_;
+
+  float* sum_;
+
+  /// @brief Sums of the data added since the ring buffer last wrapped around.
+  float* round_sum_;
+
+  int window_size_;
+
+  /// @brief Number of rows of data in the buffer.
+  int size_;
+
+  /// @brief Row of the buffer to write the next data.
+  int index_;
+} MovingAverageFilterBank;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for MovingAverageFilterBank.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] buffer The buffer for storing state, must have length of at least
+ * MOVING_AVERAGE_FILTER_BANK_BUFFER_SIZE(num_channels, window_size).
+ * @param[in] num_channels The number of channels.
+ * @param[in] window_size The size of the filter.
+ * @return None.
+ * @note User is resposible for managing memory for buffer.
+ */
+void MovingAverageFilterBank_ctor(MovingAverageFilterBank* const self,
+                                  float* const buffer, const int num_channels,
+                                  const int window_size);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data of every channel to the filter bank and
+ * returns the current filtered data of every channel.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data of each channel.
+ * @param[out] filtered_data The filtered data of each channel, NULL if no need
+ * to get filtered data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If the window is not yet filled.
+ */
+ModuleRet MovingAverageFilterBank_update(MovingAverageFilterBank* const self,
+                                         const float* const data,
+                                         float* const filtered_data);
+
+/* class inherited from FilterBank -------------------------------------------*/
+/**
+ * @brief Class for biquad filter bank, same as BiquadFilter of a single section
+ * for each channel, and banks can be chained for higher order.
+ *
+ * The buffer is laid out as the coefficients b0, b1, b2, a1, a2, the state s1,
+ * s2 and the filtered data, each of all channels.
+ */
+typedef struct biquad_filter_bank {
+  // inherited class
+  FilterBank super_;
+
+  // member variable
+  /// @brief Coefficients b0, b1, b2, a1, a2 of all channels in turn.
+  float* coefficients_;
+
+  /// @brief State s1, s2 of all channels in turn.
+  float* state_;
+} BiquadFilterBank;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for BiquadFilterBank.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] buffer The buffer for storing state, must have length of at least
+ * BIQUAD_FILTER_BANK_BUFFER_SIZE(num_channels).
+ * @param[in] num_channels The number of channels.
+ * @param[in] coefficients The coefficients {b0, b1, b2, a1, a2} of all
+ * channels, normalized so that a0 is 1.
+ * @return None.
+ * @note User is resposible for managing memory for buffer.
+ */
+void BiquadFilterBank_ctor(BiquadFilterBank* const self, float* const buffer,
+                           const int num_channels,
+                           const float* const coefficients);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for setting the coefficients of a channel.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] channel The channel.
+ * @param[in] coefficients The coefficients {b0, b1, b2, a1, a2}.
+ * @return None.
+ */
+void BiquadFilterBank_set_coefficients(BiquadFilterBank* const self,
+                                       const int channel,
+                                       const float* const coefficients);
+
+/**
+ * @brief Function for adding new data of every channel to the filter bank and
+ * returns the current filtered data of every channel.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data of each channel.
+ * @param[out] filtered_data The filtered data of each channel, NULL if no need
+ * to get filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet BiquadFilterBank_update(BiquadFilterBank* const self,
+                                  const float* const data,
+                                  float* const filtered_data);
+
+/* class inherited from FilterBank -------------------------------------------*/
+/**
+ * @brief Class for 1D kalman filter bank, same as KalmanFilter1D for each
+ * channel.
+ *
+ * The buffer is laid out as the state, which is also the filtered data, the
+ * covariance, the process noise, the measurement noise and the gain, each of
+ * all channels. In steady state mode, the gains are fixed once all channels
+ * converge, after which the update of all channels needs no division.
+ */
+typedef struct kalman_filter_1d_bank {
+  // inherited class
+  FilterBank super_;
+
+  // member variable
+  /// @brief Estimate covariance of each channel.
+  float* P_;
+
+  /// @brief Process noise covariance of each channel.
+  float* Q_;
+
+  /// @brief Measurement noise covariance of each channel.
+  float* R_;
+
+  /// @brief Gain of the last update of each channel.
+  float* K_;
+
+  /// @brief Relative change of gain between updates for convergence.
+  float tolerance_;
+
+  bool steady_state_enabled_;
+
+  bool is_steady_state_;
+} KalmanFilter1DBank;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for KalmanFilter1DBank.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] buffer The buffer for storing state, must have length of at least
+ * KALMAN_FILTER_1D_BANK_BUFFER_SIZE(num_channels).
+ * @param[in] num_channels The number of channels.
+ * @param[in] Q Process noise covariance of all channels.
+ * @param[in] R Measurement noise covariance of all channels.
+ * @param[in] x0 Initial state of all channels.
+ * @param[in] P0 Initial covariance of all channels.
+ * @return None.
+ * @note User is resposible for managing memory for buffer.
+ */
+void KalmanFilter1DBank_ctor(KalmanFilter1DBank* const self,
+                             float* const buffer, const int num_channels,
+                             const float Q, const float R, const float x0,
+                             const float P0);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for setting the noise covariances of a channel.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] channel The channel.
+ * @param[in] Q Process noise covariance.
+ * @param[in] R Measurement noise covariance.
+ * @return None.
+ * @note The gains leave steady state until all channels converge again.
+ */
+void KalmanFilter1DBank_set_noise(KalmanFilter1DBank* const self,
+                                  const int channel, const float Q,
+                                  const float R);
+
+/**
+ * @brief Function for enabling steady state mode of kalman filter bank, where
+ * the gains are fixed once the relative change of gain of every channel is
+ * within tolerance in the same update.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] tolerance The relative change of gain for convergence.
+ * @return None.
+ * @note Same as KalmanFilter1D_enable_steady_state(), every channel needs
+ * positive Q to converge.
+ */
+void KalmanFilter1DBank_enable_steady_state(KalmanFilter1DBank* const self,
+                                            const float tolerance);
+
+/**
+ * @brief Function for disabling steady state mode of kalman filter bank.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return None.
+ */
+void KalmanFilter1DBank_disable_steady_state(KalmanFilter1DBank* const self);
+
+/**
+ * @brief Function for checking if the gains of kalman filter bank are fixed to
+ * the steady state gains.
+ *
+ * @param[in] self The instance of the class.
+ * @return bool True if the gains are converged in steady state mode.
+ */
+bool KalmanFilter1DBank_is_steady_state(KalmanFilter1DBank* const self);
+
+/**
+ * @brief Function for adding new measurement of every channel to the filter
+ * bank and returns the current state of every channel.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The measurement of each channel.
+ * @param[out] filtered_data The state of each channel, NULL if no need to get
+ * filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet KalmanFilter1DBank_update(KalmanFilter1DBank* const self,
+                                    const float* const data,
+                                    float* const filtered_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STM32_MODULE_FILTER_BANK_H
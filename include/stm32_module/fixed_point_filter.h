@@ -0,0 +1,622 @@
+/**
+ * @file fixed_point_filter.h
+ * @author QuantumSpawner jet22854111@gmail.com
+ * @brief STM32 mcu module for filtering sensor signal in Q15 and Q31 fixed
+ * point format.
+ */
+
+#ifndef STM32_MODULE_FIXED_POINT_FILTER_H
+#define STM32_MODULE_FIXED_POINT_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// glibc include
+#include <stdbool.h>
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/filter.h"
+#include "stm32_module/module_common.h"
+
+/* type ----------------------------------------------------------------------*/
+/// @brief Fixed point value in [-1, 1) with 15 fractional bits, same as CMSIS.
+typedef int16_t q15_t;
+
+/// @brief Fixed point value in [-1, 1) with 31 fractional bits, same as CMSIS.
+typedef int32_t q31_t;
+
+/* macro ---------------------------------------------------------------------*/
+#define Q15_MAX ((q15_t)0x7FFF)
+#define Q15_MIN ((q15_t)0x8000)
+#define Q31_MAX ((q31_t)0x7FFFFFFFL)
+#define Q31_MIN ((q31_t)0x80000000L)
+
+// parameter
+// number of samples converted to float at a time for processing chained filter
+#define FIXED_POINT_FILTER_CHUNK_SIZE 32
+
+/* conversion function -------------------------------------------------------*/
+/**
+ * @brief Function for converting float to Q15 with rounding and saturation.
+ *
+ * @param[in] value The float value.
+ * @return q15_t The Q15 value.
+ */
+q15_t Q15_from_float(const float value);
+
+/**
+ * @brief Function for converting Q15 to float.
+ *
+ * @param[in] value The Q15 value.
+ * @return float The float value.
+ */
+float Q15_to_float(const q15_t value);
+
+/**
+ * @brief Function for converting float to Q31 with rounding and saturation.
+ *
+ * @param[in] value The float value.
+ * @return q31_t The Q31 value.
+ */
+q31_t Q31_from_float(const float value);
+
+/**
+ * @brief Function for converting Q31 to float.
+ *
+ * @param[in] value The Q31 value.
+ * @return float The float value.
+ */
+float Q31_to_float(const q31_t value);
+
+/**
+ * @brief Function for converting a block of float to Q15.
+ *
+ * @param[in] src The float values.
+ * @param[out] dst The Q15 values.
+ * @param[in] length The length of values.
+ * @return None.
+ */
+void Q15_from_float_block(const float* const src, q15_t* const dst,
+                          const int length);
+
+/**
+ * @brief Function for converting a block of Q15 to float.
+ *
+ * @param[in] src The Q15 values.
+ * @param[out] dst The float values.
+ * @param[in] length The length of values.
+ * @return None.
+ */
+void Q15_to_float_block(const q15_t* const src, float* const dst,
+                        const int length);
+
+/**
+ * @brief Function for converting a block of float to Q31.
+ *
+ * @param[in] src The float values.
+ * @param[out] dst The Q31 values.
+ * @param[in] length The length of values.
+ * @return None.
+ */
+void Q31_from_float_block(const float* const src, q31_t* const dst,
+                          const int length);
+
+/**
+ * @brief Function for converting a block of Q31 to float.
+ *
+ * @param[in] src The Q31 values.
+ * @param[out] dst The float values.
+ * @param[in] length The length of values.
+ * @return None.
+ */
+void Q31_to_float_block(const q31_t* const src, float* const dst,
+                        const int length);
+
+/* class inherited from Filter -----------------------------------------------*/
+/**
+ * @brief Class for moving average filter in Q15.
+ *
+ * The running sum is kept in 32 bit integer, hence it is exact and does not
+ * drift. The filter can be used in a chain of float filters by the Filter
+ * interface, which converts the data at its input and output.
+ *
+ * @note The chained filter, if any, is processed in float.
+ */
+typedef struct moving_average_filter_q15 {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  q15_t* buffer_;
+
+  int window_size_;
+
+  /// @brief Number of data in the buffer.
+  int size_;
+
+  /// @brief Index of the buffer to write the next data.
+  int index_;
+
+  int32_t sum_;
+
+  /// @brief Reciprocal of window size in Q31 for dividing by multiplication.
+  uint32_t reciprocal_;
+} MovingAverageFilterQ15;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for MovingAverageFilterQ15.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] filter_buffer The buffer for storing data, must have length of at
+ * least window_size.
+ * @param[in] window_size The size of the filter.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note User is resposible for managing memory for filter_buffer.
+ */
+void MovingAverageFilterQ15_ctor(MovingAverageFilterQ15* const self,
+                                 q15_t* const filter_buffer,
+                                 const int window_size,
+                                 Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the filter and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy The window is not yet filled.
+ */
+ModuleRet MovingAverageFilterQ15_update(MovingAverageFilterQ15* const self,
+                                        const q15_t data,
+                                        q15_t* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data, which is less than
+ * length while the window is not yet filled.
+ * @return ModuleRet Error code.
+ */
+ModuleRet MovingAverageFilterQ15_update_block(
+    MovingAverageFilterQ15* const self, const q15_t* const data,
+    q15_t* const filtered_data, const int length, int* const filtered_length);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet MovingAverageFilterQ15_get_filtered_data(
+    MovingAverageFilterQ15* const self, q15_t* const filtered_data);
+
+/* class inherited from Filter -----------------------------------------------*/
+/**
+ * @brief Class for moving average filter in Q31.
+ *
+ * The running sum is kept in 64 bit integer, hence it is exact and does not
+ * drift. The filter can be used in a chain of float filters by the Filter
+ * interface, which converts the data at its input and output.
+ *
+ * @note The chained filter, if any, is processed in float.
+ */
+typedef struct moving_average_filter_q31 {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  q31_t* buffer_;
+
+  int window_size_;
+
+  /// @brief Number of data in the buffer.
+  int size_;
+
+  /// @brief Index of the buffer to write the next data.
+  int index_;
+
+  int64_t sum_;
+} MovingAverageFilterQ31;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for MovingAverageFilterQ31.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] filter_buffer The buffer for storing data, must have length of at
+ * least window_size.
+ * @param[in] window_size The size of the filter.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note User is resposible for managing memory for filter_buffer.
+ */
+void MovingAverageFilterQ31_ctor(MovingAverageFilterQ31* const self,
+                                 q31_t* const filter_buffer,
+                                 const int window_size,
+                                 Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the filter and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy The window is not yet filled.
+ */
+ModuleRet MovingAverageFilterQ31_update(MovingAverageFilterQ31* const self,
+                                        const q31_t data,
+                                        q31_t* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data, which is less than
+ * length while the window is not yet filled.
+ * @return ModuleRet Error code.
+ */
+ModuleRet MovingAverageFilterQ31_update_block(
+    MovingAverageFilterQ31* const self, const q31_t* const data,
+    q31_t* const filtered_data, const int length, int* const filtered_length);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet MovingAverageFilterQ31_get_filtered_data(
+    MovingAverageFilterQ31* const self, q31_t* const filtered_data);
+
+/* class inherited from Filter -----------------------------------------------*/
+/**
+ * @brief Class for normalize filter in Q15, whose filtered data is in [0, 1)
+ * saturated at Q15_MAX.
+ *
+ * @note The chained filter, if any, is processed in float.
+ */
+typedef struct normalize_filter_q15 {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  q15_t filtered_data_;
+
+  q15_t lower_bound_;
+
+  q15_t upper_bound_;
+} NormalizeFilterQ15;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for NormalizeFilterQ15.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] lower_bound The initial lower bound of the filter.
+ * @param[in] upper_bound The initial upper bound of the filter.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ */
+void NormalizeFilterQ15_ctor(NormalizeFilterQ15* const self,
+                             const q15_t lower_bound, const q15_t upper_bound,
+                             Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the filter and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet NormalizeFilterQ15_update(NormalizeFilterQ15* const self,
+                                    const q15_t data,
+                                    q15_t* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet NormalizeFilterQ15_update_block(NormalizeFilterQ15* const self,
+                                          const q15_t* const data,
+                                          q15_t* const filtered_data,
+                                          const int length,
+                                          int* const filtered_length);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet NormalizeFilterQ15_get_filtered_data(NormalizeFilterQ15* const self,
+                                               q15_t* const filtered_data);
+
+/* class inherited from Filter -----------------------------------------------*/
+/**
+ * @brief Class for normalize filter in Q31, whose filtered data is in [0, 1)
+ * saturated at Q31_MAX.
+ *
+ * @note The chained filter, if any, is processed in float.
+ */
+typedef struct normalize_filter_q31 {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  q31_t filtered_data_;
+
+  q31_t lower_bound_;
+
+  q31_t upper_bound_;
+} NormalizeFilterQ31;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for NormalizeFilterQ31.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] lower_bound The initial lower bound of the filter.
+ * @param[in] upper_bound The initial upper bound of the filter.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ */
+void NormalizeFilterQ31_ctor(NormalizeFilterQ31* const self,
+                             const q31_t lower_bound, const q31_t upper_bound,
+                             Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the filter and returns the current
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet NormalizeFilterQ31_update(NormalizeFilterQ31* const self,
+                                    const q31_t data,
+                                    q31_t* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the filter and returns the
+ * filtered data of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet NormalizeFilterQ31_update_block(NormalizeFilterQ31* const self,
+                                          const q31_t* const data,
+                                          q31_t* const filtered_data,
+                                          const int length,
+                                          int* const filtered_length);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet NormalizeFilterQ31_get_filtered_data(NormalizeFilterQ31* const self,
+                                               q31_t* const filtered_data);
+
+/* class inherited from Filter -----------------------------------------------*/
+/**
+ * @brief Class for managing 1 dimensional kalman filter with Q15 state.
+ *
+ * The covariances and the kalman gain are kept in Q31 for precision, in unit
+ * of full scale squared. The state is also kept in Q31 and only rounded to Q15
+ * when returned, so that corrections smaller than 1 LSB of Q15 still
+ * accumulate instead of leaving a dead band around the measurement.
+ *
+ * Once the covariance stops changing, the kalman gain is fixed and the update
+ * needs no division.
+ *
+ * @note The kalman filter can be used as the last filter of a chain, but does
+ * not have a chained filter itself.
+ */
+typedef struct {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  q31_t Q_;
+  q31_t R_;
+  q31_t x_;
+  q31_t P_;
+  q31_t K_;
+  bool is_converged_;
+} KalmanFilter1DQ15;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for KalmanFilter1DQ15.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] Q The process noise covariance.
+ * @param[in] R The measurement noise covariance.
+ * @param[in] x0 The initial state.
+ * @param[in] P0 The initial covariance.
+ * @return None.
+ */
+void KalmanFilter1DQ15_ctor(KalmanFilter1DQ15* const self, const q31_t Q,
+                            const q31_t R, const q15_t x0, const q31_t P0);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for updating the state of kalman filter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] z The measurement.
+ * @return q15_t The updated state.
+ */
+q15_t KalmanFilter1DQ15_update(KalmanFilter1DQ15* const self, const q15_t z);
+
+/**
+ * @brief Function for updating the state of kalman filter by a block of
+ * measurements.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] z The measurements.
+ * @param[out] x The updated state after each measurement, can be the same
+ * buffer as z.
+ * @param[in] length The length of measurements.
+ * @param[out] filtered_length The number of updated states, which is always
+ * length.
+ * @return ModuleRet Error code.
+ */
+ModuleRet KalmanFilter1DQ15_update_block(KalmanFilter1DQ15* const self,
+                                         const q15_t* const z, q15_t* const x,
+                                         const int length,
+                                         int* const filtered_length);
+
+/**
+ * @brief Function for getting the current state of kalman filter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return q15_t The current state.
+ */
+q15_t KalmanFilter1DQ15_get_state(KalmanFilter1DQ15* const self);
+
+/**
+ * @brief Function for getting the current covariance of kalman filter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return q31_t The current covariance.
+ */
+q31_t KalmanFilter1DQ15_get_covariance(KalmanFilter1DQ15* const self);
+
+/* class inherited from Filter -----------------------------------------------*/
+/**
+ * @brief Class for managing 1 dimensional kalman filter with Q31 state.
+ *
+ * The covariances and the kalman gain are kept in Q31, in unit of full scale
+ * squared.
+ *
+ * Once the covariance stops changing, the kalman gain is fixed and the update
+ * needs no division.
+ *
+ * @note The kalman filter can be used as the last filter of a chain, but does
+ * not have a chained filter itself.
+ */
+typedef struct {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  q31_t Q_;
+  q31_t R_;
+  q31_t x_;
+  q31_t P_;
+  q31_t K_;
+  bool is_converged_;
+} KalmanFilter1DQ31;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for KalmanFilter1DQ31.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] Q The process noise covariance.
+ * @param[in] R The measurement noise covariance.
+ * @param[in] x0 The initial state.
+ * @param[in] P0 The initial covariance.
+ * @return None.
+ */
+void KalmanFilter1DQ31_ctor(KalmanFilter1DQ31* const self, const q31_t Q,
+                            const q31_t R, const q31_t x0, const q31_t P0);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for updating the state of kalman filter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] z The measurement.
+ * @return q31_t The updated state.
+ */
+q31_t KalmanFilter1DQ31_update(KalmanFilter1DQ31* const self, const q31_t z);
+
+/**
+ * @brief Function for updating the state of kalman filter by a block of
+ * measurements.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] z The measurements.
+ * @param[out] x The updated state after each measurement, can be the same
+ * buffer as z.
+ * @param[in] length The length of measurements.
+ * @param[out] filtered_length The number of updated states, which is always
+ * length.
+ * @return ModuleRet Error code.
+ */
+ModuleRet KalmanFilter1DQ31_update_block(KalmanFilter1DQ31* const self,
+                                         const q31_t* const z, q31_t* const x,
+                                         const int length,
+                                         int* const filtered_length);
+
+/**
+ * @brief Function for getting the current state of kalman filter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return q31_t The current state.
+ */
+q31_t KalmanFilter1DQ31_get_state(KalmanFilter1DQ31* const self);
+
+/**
+ * @brief Function for getting the current covariance of kalman filter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return q31_t The current covariance.
+ */
+q31_t KalmanFilter1DQ31_get_covariance(KalmanFilter1DQ31* const self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STM32_MODULE_FIXED_POINT_FILTER_H
@@ -0,0 +1,131 @@
+/**
+ * @file flash.h
+ * @author QuantumSpawner jet22854111@gmail.com
+ * @brief STM32 mcu module for accessing sector-erasable flash memory.
+ */
+
+#ifndef STM32_MODULE_FLASH_H
+#define STM32_MODULE_FLASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// glibc include
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/module_common.h"
+
+/* macro ---------------------------------------------------------------------*/
+// value of erased flash byte
+#define FLASH_ERASED_BYTE 0xFFU
+
+// assert macro
+#define IS_FLASH_RANGE(FLASH, ADDRESS, SIZE) \
+  ((ADDRESS) + (SIZE) <=                     \
+   (FLASH)->sector_size_ * (uint32_t)(FLASH)->num_sectors_)
+#define IS_FLASH_SECTOR(FLASH, SECTOR) \
+  ((SECTOR) >= 0 && (SECTOR) < (FLASH)->num_sectors_)
+
+/* abstract class ------------------------------------------------------------*/
+// forward declaration
+struct FlashVtbl;
+
+/**
+ * @brief Abstract class for accessing flash memory consisting of equally sized
+ * sectors.
+ *
+ * Addresses are offsets from the start of the flash region. Like NOR flash,
+ * erasing sets a whole sector to FLASH_ERASED_BYTE, and writing can only clear
+ * bits, hence a location must be erased before being written again.
+ */
+typedef struct flash {
+  // virtual table
+  struct FlashVtbl* vptr_;
+
+  // member variable
+  uint32_t sector_size_;
+
+  int num_sectors_;
+} Flash;
+
+/// @brief Virtual table for Flash.
+struct FlashVtbl {
+  ModuleRet (*read)(Flash*, uint32_t, void*, uint32_t);
+
+  ModuleRet (*write)(Flash*, uint32_t, const void*, uint32_t);
+
+  ModuleRet (*erase)(Flash*, int);
+};
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for Flash.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] sector_size The size of a sector in bytes.
+ * @param[in] num_sectors The number of sectors.
+ * @return None.
+ */
+void Flash_ctor(Flash* const self, const uint32_t sector_size,
+                const int num_sectors);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for reading data from flash.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] address The address to read from.
+ * @param[out] data The buffer to read to.
+ * @param[in] size The size of data in bytes.
+ * @return ModuleRet Error code.
+ * @note This function is virtual.
+ */
+ModuleRet Flash_read(Flash* const self, const uint32_t address,
+                     void* const data, const uint32_t size);
+
+/**
+ * @brief Function for writing data to erased flash.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] address The address to write to.
+ * @param[in] data The data to write.
+ * @param[in] size The size of data in bytes.
+ * @return ModuleRet Error code.
+ * @note This function is virtual.
+ */
+ModuleRet Flash_write(Flash* const self, const uint32_t address,
+                      const void* const data, const uint32_t size);
+
+/**
+ * @brief Function for erasing a sector of flash.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] sector The index of the sector.
+ * @return ModuleRet Error code.
+ * @note This function is virtual.
+ */
+ModuleRet Flash_erase(Flash* const self, const int sector);
+
+/**
+ * @brief Function for getting the size of a sector.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t The size of a sector in bytes.
+ */
+uint32_t Flash_get_sector_size(const Flash* const self);
+
+/**
+ * @brief Function for getting the number of sectors.
+ *
+ * @param[in] self The instance of the class.
+ * @return int The number of sectors.
+ */
+int Flash_get_num_sectors(const Flash* const self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STM32_MODULE_FLASH_H
@@ -0,0 +1,152 @@
+/**
+ * @file kalman_filter.h
+ * @author QuantumSpawner jet22854111@gmail.com
+ * @brief STM32 mcu module for fusing sensor signal with multi-state kalman
+ * filter.
+ */
+
+#ifndef STM32_MODULE_KALMAN_FILTER_H
+#define STM32_MODULE_KALMAN_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// glibc include
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/module_common.h"
+
+/* macro ---------------------------------------------------------------------*/
+// parameter
+#define KALMAN_FILTER_MIN_NUM_STATES 2
+#define KALMAN_FILTER_MAX_NUM_STATES 6
+
+// assert macro
+#define IS_KALMAN_FILTER_NUM_STATES(NUM)    \
+  ((NUM) >= KALMAN_FILTER_MIN_NUM_STATES && \
+   (NUM) <= KALMAN_FILTER_MAX_NUM_STATES)
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for kalman filter of 2 to 6 states with scalar measurements.
+ *
+ * Matrices are stored in fixed size arrays without heap, and the kernels are
+ * specialized for each number of states so that the compiler can fully unroll
+ * them. Measurements are processed one at a time, which needs only a scalar
+ * division instead of a matrix inversion, and is equivalent to a vector
+ * measurement with uncorrelated noise. The covariance is updated in Joseph
+ * form, which keeps it symmetric and positive semi-definite under float
+ * rounding.
+ *
+ * @note No kernel function is called, hence the filter may run in an
+ * interrupt, but the prediction and all measurement updates share the state
+ * and must run in the same context.
+ */
+typedef struct kalman_filter {
+  // member variable
+  int num_states_;
+
+  /// @brief State transition matrix of num_states x num_states in row major.
+  const float* F_;
+
+  /// @brief Process noise covariance of num_states x num_states in row major.
+  const float* Q_;
+
+  float x_[KALMAN_FILTER_MAX_NUM_STATES];
+
+  float P_[KALMAN_FILTER_MAX_NUM_STATES][KALMAN_FILTER_MAX_NUM_STATES];
+} KalmanFilter;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for KalmanFilter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] num_states The number of states, from
+ * KALMAN_FILTER_MIN_NUM_STATES to KALMAN_FILTER_MAX_NUM_STATES.
+ * @param[in] F State transition matrix of num_states x num_states in row
+ * major.
+ * @param[in] Q Process noise covariance of num_states x num_states in row
+ * major.
+ * @param[in] x0 Initial state of num_states.
+ * @param[in] P0 Initial covariance of num_states x num_states in row major.
+ * @return None.
+ * @note User is resposible for managing memory for F and Q, which can be
+ * changed between updates, e.g. for variable time step.
+ */
+void KalmanFilter_ctor(KalmanFilter* const self, const int num_states,
+                       const float* const F, const float* const Q,
+                       const float* const x0, const float* const P0);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for predicting the state and covariance to the next step.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return None.
+ */
+void KalmanFilter_predict(KalmanFilter* const self);
+
+/**
+ * @brief Function for correcting the state and covariance with a scalar
+ * measurement.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] H Measurement matrix of 1 x num_states.
+ * @param[in] R Measurement noise variance.
+ * @param[in] z The measurement.
+ * @return ModuleRet Error code.
+ * @retval ModuleError If the innovation variance is not positive, and the
+ * filter is not changed.
+ */
+ModuleRet KalmanFilter_update(KalmanFilter* const self, const float* const H,
+                              const float R, const float z);
+
+/**
+ * @brief Function for correcting the state and covariance with measurements
+ * of uncorrelated noise one at a time.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] H Measurement matrix of num_measurements x num_states in row
+ * major.
+ * @param[in] R Measurement noise variance of each measurement, i.e. the
+ * diagonal of the measurement noise covariance.
+ * @param[in] z The measurements.
+ * @param[in] num_measurements The number of measurements.
+ * @return ModuleRet Error code.
+ * @retval ModuleError If the innovation variance of any measurement is not
+ * positive, and the measurement is skipped.
+ */
+ModuleRet KalmanFilter_update_sequential(KalmanFilter* const self,
+                                         const float* const H,
+                                         const float* const R,
+                                         const float* const z,
+                                         const int num_measurements);
+
+/**
+ * @brief Function for getting a state of kalman filter.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] index The index of the state.
+ * @return float The state.
+ */
+float KalmanFilter_get_state(KalmanFilter* const self, const int index);
+
+/**
+ * @brief Function for getting an element of the covariance of kalman filter.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] row The row of the element.
+ * @param[in] col The column of the element.
+ * @return float The element of the covariance.
+ */
+float KalmanFilter_get_covariance(KalmanFilter* const self, const int row,
+                                  const int col);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STM32_MODULE_KALMAN_FILTER_H
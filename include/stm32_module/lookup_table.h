@@ -0,0 +1,284 @@
+/**
+ * @file lookup_table.h
+ * @author QuantumSpawner jet22854111@gmail.com
+ * @brief STM32 mcu module for linearizing sensor signal and looking up maps by
+ * piecewise linear interpolation of tables.
+ */
+
+#ifndef STM32_MODULE_LOOKUP_TABLE_H
+#define STM32_MODULE_LOOKUP_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// glibc include
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/filter.h"
+#include "stm32_module/fixed_point_filter.h"
+#include "stm32_module/module_common.h"
+
+/* macro ---------------------------------------------------------------------*/
+// assert macro
+#define IS_LOOKUP_TABLE_NUM_POINTS(NUM) ((NUM) >= 2)
+#define IS_LOOKUP_TABLE_Q15_SHIFT(SHIFT) ((SHIFT) >= 0 && (SHIFT) <= 15)
+
+/* class inherited from Filter -----------------------------------------------*/
+/**
+ * @brief Class for 1D lookup table, which maps data by piecewise linear
+ * interpolation between breakpoints, e.g. for linearizing pedal potentiometer
+ * or thermistor.
+ *
+ * The slope of each segment is computed in constructor, hence lookup needs no
+ * division. If the breakpoints are uniformly spaced, the segment is found in
+ * O(1) by multiplying with the inverse of the spacing, otherwise by binary
+ * search. Data out of the breakpoints is saturated to the first or last value.
+ *
+ * @note LookupTable1D_lookup() only reads the table, hence can be called from
+ * any task or interrupt at the same time. Updating the table as a filter
+ * stores the filtered data, hence follows the context rule of Filter.
+ */
+typedef struct lookup_table_1d {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  /// @brief Breakpoints in strictly increasing order.
+  const float* x_;
+
+  /// @brief Value at each breakpoint.
+  const float* y_;
+
+  /// @brief Slope of each segment between breakpoints.
+  float* slope_;
+
+  int num_points_;
+
+  /// @brief Inverse of the spacing if breakpoints are uniform, otherwise 0.
+  float inverse_step_;
+
+  float filtered_data_;
+} LookupTable1D;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for LookupTable1D.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] x Breakpoints in strictly increasing order.
+ * @param[in] y Value at each breakpoint.
+ * @param[in] slope_buffer The buffer for storing slope of each segment, must
+ * have length of at least num_points - 1.
+ * @param[in] num_points The number of breakpoints, at least 2.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note User is resposible for managing memory for x, y and slope_buffer. x
+ * and y must not be changed after construction.
+ */
+void LookupTable1D_ctor(LookupTable1D* const self, const float* const x,
+                        const float* const y, float* const slope_buffer,
+                        const int num_points, Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for looking up the table.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] x The data.
+ * @return float The interpolated value.
+ */
+float LookupTable1D_lookup(const LookupTable1D* const self, const float x);
+
+/**
+ * @brief Function for adding new data to the table as a filter and returns the
+ * interpolated value.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The interpolated value, NULL if no need to get
+ * filtered data.
+ * @return ModuleRet Error code.
+ */
+ModuleRet LookupTable1D_update(LookupTable1D* const self, const float data,
+                               float* const filtered_data);
+
+/**
+ * @brief Function for getting the last interpolated value.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] filtered_data The interpolated value.
+ * @return ModuleRet Error code.
+ */
+ModuleRet LookupTable1D_get_filtered_data(LookupTable1D* const self,
+                                          float* const filtered_data);
+
+/**
+ * @brief Function for adding a block of new data to the table as a filter and
+ * returns the interpolated value of each of them.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The interpolated values, can be the same buffer as
+ * data.
+ * @param[in] length The length of data.
+ * @param[out] filtered_length The number of interpolated values.
+ * @return ModuleRet Error code.
+ */
+ModuleRet LookupTable1D_update_block(LookupTable1D* const self,
+                                     const float* const data,
+                                     float* const filtered_data,
+                                     const int length,
+                                     int* const filtered_length);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for 2D lookup table, which maps 2 data by bilinear
+ * interpolation on a grid of breakpoints, e.g. for torque map of pedal and
+ * motor speed.
+ *
+ * Same as LookupTable1D, the inverse spacing of each segment of both axes is
+ * computed in constructor, and the segment is found in O(1) for uniform axis
+ * or by binary search otherwise. Data out of the grid is saturated to the
+ * edge.
+ */
+typedef struct lookup_table_2d {
+  // member variable
+  /// @brief Breakpoints of the first axis in strictly increasing order.
+  const float* x_;
+
+  /// @brief Breakpoints of the second axis in strictly increasing order.
+  const float* y_;
+
+  /// @brief Value at each grid point of num_x x num_y in row major.
+  const float* z_;
+
+  /// @brief Inverse spacing of each segment of the first axis.
+  float* x_inverse_spacing_;
+
+  /// @brief Inverse spacing of each segment of the second axis.
+  float* y_inverse_spacing_;
+
+  int num_x_;
+
+  int num_y_;
+
+  /// @brief Inverse of the spacing if the first axis is uniform, otherwise 0.
+  float x_inverse_step_;
+
+  /// @brief Inverse of the spacing if the second axis is uniform, otherwise 0.
+  float y_inverse_step_;
+} LookupTable2D;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for LookupTable2D.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] x Breakpoints of the first axis in strictly increasing order.
+ * @param[in] y Breakpoints of the second axis in strictly increasing order.
+ * @param[in] z Value at each grid point of num_x x num_y in row major, i.e.
+ * z[i * num_y + j] is the value at x[i] and y[j].
+ * @param[in] inverse_spacing_buffer The buffer for storing inverse spacing of
+ * each segment, must have length of at least num_x + num_y - 2.
+ * @param[in] num_x The number of breakpoints of the first axis, at least 2.
+ * @param[in] num_y The number of breakpoints of the second axis, at least 2.
+ * @return None.
+ * @note User is resposible for managing memory for x, y, z and
+ * inverse_spacing_buffer. x and y must not be changed after construction, but
+ * z can be tuned at any time.
+ */
+void LookupTable2D_ctor(LookupTable2D* const self, const float* const x,
+                        const float* const y, const float* const z,
+                        float* const inverse_spacing_buffer, const int num_x,
+                        const int num_y);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for looking up the table.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] x The data of the first axis.
+ * @param[in] y The data of the second axis.
+ * @return float The interpolated value.
+ */
+float LookupTable2D_lookup(const LookupTable2D* const self, const float x,
+                           const float y);
+
+/* class inherited from Filter -----------------------------------------------*/
+/**
+ * @brief Class for 1D lookup table in Q15, whose breakpoints are uniformly
+ * spaced by a power of 2 from x0, so that the segment and the fraction in it
+ * are found by shift and mask without multiplication or division.
+ *
+ * Breakpoint i is at x0 + (i << shift). Data out of the breakpoints is
+ * saturated to the first or last value.
+ *
+ * @note The chained filter, if any, is processed in float.
+ */
+typedef struct lookup_table_1d_q15 {
+  // inherited class
+  Filter super_;
+
+  // member variable
+  /// @brief Value at each breakpoint.
+  const q15_t* y_;
+
+  int num_points_;
+
+  q15_t x0_;
+
+  int shift_;
+
+  q15_t filtered_data_;
+} LookupTable1DQ15;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for LookupTable1DQ15.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] y Value at each breakpoint.
+ * @param[in] num_points The number of breakpoints, at least 2.
+ * @param[in] x0 The first breakpoint.
+ * @param[in] shift The spacing of breakpoints in log2, from 0 to 15.
+ * @param[in] chained_filter The chained filter will be processed before this
+ * filter, NULL if no chained filter.
+ * @return None.
+ * @note User is resposible for managing memory for y.
+ */
+void LookupTable1DQ15_ctor(LookupTable1DQ15* const self, const q15_t* const y,
+                           const int num_points, const q15_t x0,
+                           const int shift, Filter* const chained_filter);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for looking up the table.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] x The data.
+ * @return q15_t The interpolated value.
+ */
+q15_t LookupTable1DQ15_lookup(const LookupTable1DQ15* const self,
+                              const q15_t x);
+
+/**
+ * @brief Function for looking up the table by a block of data.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] x The data.
+ * @param[out] y The interpolated values, can be the same buffer as x.
+ * @param[in] length The length of data.
+ * @return None.
+ */
+void LookupTable1DQ15_lookup_block(const LookupTable1DQ15* const self,
+                                   const q15_t* const x, q15_t* const y,
+                                   const int length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STM32_MODULE_LOOKUP_TABLE_H
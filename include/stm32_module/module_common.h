@@ -13,6 +13,7 @@ extern "C" {
 
 // glibc include
 #include <stddef.h>
+#include <stdint.h>
 
 // freertos include
 #include "FreeRTOS.h"
@@ -300,6 +301,69 @@ void* SharedResource_access(SharedResource* const self);
  */
 void SharedResource_end_access(SharedResource* const self);
 
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for publishing data from a single writer to readers in any
+ * context without locking.
+ *
+ * Data is kept in two copies and the writer updates them one at a time, while
+ * readers read the copy selected by the sequence number and retry if the
+ * sequence number changed during reading. Hence readers never see partially
+ * written data, and a reader interrupting the writer (e.g. in an ISR) always
+ * succeeds without retrying.
+ *
+ * @note Every write increments the sequence number by 2.
+ */
+typedef struct seq_lock {
+  volatile uint32_t sequence_;
+
+  uint8_t* buffer_;
+
+  size_t size_;
+} SeqLock;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for SeqLock.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] buffer The buffer for storing the two copies of data, must
+ * have size of at least 2 * size.
+ * @param[in] size The size of the data.
+ * @return None.
+ * @note User is resposible for managing memory for buffer.
+ * @note The data is initialized to zero.
+ */
+void SeqLock_ctor(SeqLock* const self, void* const buffer, const size_t size);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for publishing new data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to publish.
+ * @return None.
+ * @warning This function must only be called by a single writer.
+ */
+void SeqLock_write(SeqLock* const self, const void* const data);
+
+/**
+ * @brief Function for reading a consistent copy of the data.
+ *
+ * @param[in] self The instance of the class.
+ * @param[out] data The buffer to copy the data to.
+ * @return uint32_t The sequence number of the data read.
+ */
+uint32_t SeqLock_read(const SeqLock* const self, void* const data);
+
+/**
+ * @brief Function for getting the current sequence number.
+ *
+ * @param[in] self The instance of the class.
+ * @return uint32_t The sequence number.
+ */
+uint32_t SeqLock_get_sequence(const SeqLock* const self);
+
 /* abstract class ------------------------------------------------------------*/
 // forward declaration
 struct TaskVtbl;
@@ -5,13 +5,21 @@
 extern "C" {
 #endif
 
+#include "stm32_module/adc_sampler.h"
 #include "stm32_module/button_monitor.h"
 #include "stm32_module/can_transceiver.h"
 #include "stm32_module/error_handler.h"
+#include "stm32_module/fault_recorder.h"
 #include "stm32_module/filter.h"
+#include "stm32_module/filter_bank.h"
+#include "stm32_module/fixed_point_filter.h"
+#include "stm32_module/flash.h"
+#include "stm32_module/kalman_filter.h"
 #include "stm32_module/led_controller.h"
+#include "stm32_module/lookup_table.h"
 #include "stm32_module/module_common.h"
 #include "stm32_module/servo_controller.h"
+#include "stm32_module/timed_filter.h"
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,222 @@
+/**
+ * @file timed_filter.h
+ * @author QuantumSpawner jet22854111@gmail.com
+ * @brief STM32 mcu module for filtering irregularly sampled signal, e.g. data
+ * received from can bus with jitter and dropouts.
+ *
+ * Timestamps are given in any monotonic tick of uint32_t, e.g. TickType_t or a
+ * microsecond timer, and wrap around safely as long as the interval between
+ * two samples is less than 2^31 ticks. Time constants and noise rates are given
+ * in the same tick.
+ *
+ * No kernel function is called, hence each instance can be updated from both
+ * task and interrupt context, e.g. the can receive callback, but only from one
+ * context at a time.
+ */
+
+#ifndef STM32_MODULE_TIMED_FILTER_H
+#define STM32_MODULE_TIMED_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// glibc include
+#include <stdbool.h>
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/module_common.h"
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for exponential moving average of irregularly sampled data,
+ * whose smoothing factor is scaled by the interval between samples.
+ *
+ * The smoothing factor is 1 - exp(-dt / time_constant), hence the response to
+ * a step is 1 - exp(-t / time_constant) however the data is sampled, and the
+ * filter follows the new data after a long dropout.
+ */
+typedef struct timed_exponential_filter {
+  // member variable
+  float inverse_time_constant_;
+
+  /// @brief Timestamp of the last data.
+  uint32_t timestamp_;
+
+  float filtered_data_;
+
+  bool is_ready_;
+} TimedExponentialFilter;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for TimedExponentialFilter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] time_constant The time constant in ticks.
+ * @return None.
+ */
+void TimedExponentialFilter_ctor(TimedExponentialFilter* const self,
+                                 const float time_constant);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data sampled at timestamp to the filter and
+ * returns the filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[in] timestamp The timestamp of the data in ticks.
+ * @return float The filtered data.
+ * @note The first data initializes the filter.
+ */
+float TimedExponentialFilter_update(TimedExponentialFilter* const self,
+                                    const float data,
+                                    const uint32_t timestamp);
+
+/**
+ * @brief Function for getting the current filtered data.
+ *
+ * @param[in] self The instance of the class.
+ * @param[out] filtered_data The filtered data.
+ * @return ModuleRet Error code.
+ * @retval ModuleBusy If no data is added yet.
+ */
+ModuleRet TimedExponentialFilter_get_filtered_data(
+    const TimedExponentialFilter* const self, float* const filtered_data);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for kalman filter of a random walk sampled irregularly, whose
+ * process noise is scaled by the interval between samples.
+ *
+ * The covariance grows by Q * dt before each measurement, hence the gain is
+ * low for densely sampled data and high after a dropout, instead of being
+ * tuned for a fixed sample period.
+ */
+typedef struct timed_kalman_filter_1d {
+  // member variable
+  /// @brief Process noise variance per tick.
+  float Q_;
+
+  float R_;
+
+  float x_;
+
+  float P_;
+
+  /// @brief Timestamp of the last measurement.
+  uint32_t timestamp_;
+
+  bool is_ready_;
+} TimedKalmanFilter1D;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for TimedKalmanFilter1D.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] Q Process noise variance per tick.
+ * @param[in] R Measurement noise variance.
+ * @param[in] x0 Initial state.
+ * @param[in] P0 Initial covariance.
+ * @return None.
+ */
+void TimedKalmanFilter1D_ctor(TimedKalmanFilter1D* const self, const float Q,
+                              const float R, const float x0, const float P0);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for updating the state of kalman filter by a measurement
+ * sampled at timestamp.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] z The measurement.
+ * @param[in] timestamp The timestamp of the measurement in ticks.
+ * @return float The updated state.
+ * @note The first measurement is not predicted, as the initial state has no
+ * timestamp.
+ */
+float TimedKalmanFilter1D_update(TimedKalmanFilter1D* const self,
+                                 const float z, const uint32_t timestamp);
+
+/**
+ * @brief Function for getting the current state of kalman filter.
+ *
+ * @param[in] self The instance of the class.
+ * @return float The current state.
+ */
+float TimedKalmanFilter1D_get_state(const TimedKalmanFilter1D* const self);
+
+/**
+ * @brief Function for getting the covariance of kalman filter predicted to
+ * timestamp, e.g. for checking if the state is still trustworthy during a
+ * dropout.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] timestamp The timestamp in ticks, not earlier than the last
+ * measurement.
+ * @return float The predicted covariance.
+ */
+float TimedKalmanFilter1D_get_covariance(const TimedKalmanFilter1D* const self,
+                                         const uint32_t timestamp);
+
+/* class ---------------------------------------------------------------------*/
+/**
+ * @brief Class for resampling irregularly sampled data to a fixed rate by
+ * linear interpolation, so that the result can be processed by filters
+ * assuming a fixed sample period, e.g. by Filter_update_block().
+ *
+ * The output grid starts at the timestamp of the first data, and each new data
+ * outputs the grid points between the previous data and itself.
+ */
+typedef struct linear_resampler {
+  // member variable
+  uint32_t period_;
+
+  /// @brief Timestamp of the next grid point to output.
+  uint32_t next_timestamp_;
+
+  /// @brief Timestamp of the last data.
+  uint32_t timestamp_;
+
+  /// @brief The last data.
+  float data_;
+
+  bool is_ready_;
+} LinearResampler;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for LinearResampler.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] period The period of the output in ticks.
+ * @return None.
+ */
+void LinearResampler_ctor(LinearResampler* const self, const uint32_t period);
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data sampled at timestamp to the resampler
+ * and returns the data at the grid points up to timestamp.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[in] timestamp The timestamp of the data in ticks.
+ * @param[out] resampled_data The data at the grid points.
+ * @param[in] max_length The length of resampled_data.
+ * @return int The number of resampled data.
+ * @note Data not later than the last data is ignored. Grid points beyond
+ * max_length are skipped, so that a long dropout does not flood the output.
+ */
+int LinearResampler_update(LinearResampler* const self, const float data,
+                           const uint32_t timestamp,
+                           float* const resampled_data, const int max_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // STM32_MODULE_TIMED_FILTER_H
@@ -0,0 +1,85 @@
+#ifndef STM32_MODULE_FILE_FLASH_HPP
+#define STM32_MODULE_FILE_FLASH_HPP
+
+// stl include
+#include <cstdint>
+#include <cstdio>
+
+extern "C" {
+// stm32_module include
+#include "stm32_module/flash.h"
+}
+
+/* macro ---------------------------------------------------------------------*/
+#define FILE_FLASH_MAX_SECTORS 16
+
+/* class inherited from Flash for host simulation ----------------------------*/
+/**
+ * @brief Class for emulating flash by a file on host, which persists across
+ * test runs like flash across power cycles.
+ *
+ * Writing only clears bits like NOR flash, and erase count of each sector is
+ * kept for checking wear levelling.
+ */
+typedef struct file_flash {
+  Flash super_;
+
+  FILE* file_;
+
+  int erase_count_[FILE_FLASH_MAX_SECTORS];
+
+  /// @brief Number of the following writes to fail.
+  int write_failure_count_;
+
+  /// @brief Number of the following erases to fail.
+  int erase_failure_count_;
+} FileFlash;
+
+/* constructor ---------------------------------------------------------------*/
+/**
+ * @brief Constructor for FileFlash, which opens the file or creates an erased
+ * one if it does not exist.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] path The path of the file.
+ * @param[in] sector_size The size of a sector in bytes.
+ * @param[in] num_sectors The number of sectors, at most
+ * FILE_FLASH_MAX_SECTORS.
+ * @return None.
+ */
+void FileFlash_ctor(FileFlash* self, const char* path, uint32_t sector_size,
+                    int num_sectors);
+
+/**
+ * @brief Destructor for FileFlash, which closes the file.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return None.
+ */
+void FileFlash_dtor(FileFlash* self);
+
+/* member function -----------------------------------------------------------*/
+int FileFlash_get_erase_count(const FileFlash* self, int sector);
+
+/**
+ * @brief Function for simulating failure of the following writes and erases,
+ * which return ModuleError without touching the file.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] write_failure_count Number of the following writes to fail.
+ * @param[in] erase_failure_count Number of the following erases to fail.
+ * @return None.
+ */
+void FileFlash_inject_failure(FileFlash* self, int write_failure_count,
+                              int erase_failure_count);
+
+/* virtual function declaration ----------------------------------------------*/
+ModuleRet __FileFlash_read(Flash* self, uint32_t address, void* data,
+                           uint32_t size);
+
+ModuleRet __FileFlash_write(Flash* self, uint32_t address, const void* data,
+                            uint32_t size);
+
+ModuleRet __FileFlash_erase(Flash* self, int sector);
+
+#endif  // STM32_MODULE_FILE_FLASH_HPP
@@ -0,0 +1,28 @@
+#ifndef STM32_MODULE_HAL_ADC_MOCK_HPP
+#define STM32_MODULE_HAL_ADC_MOCK_HPP
+
+// stl include
+#include <cstdint>
+
+extern "C" {
+// stm32 include
+#include "stm32_module/stm32_hal.h"
+}
+
+// gtest include
+#include "cmock/cmock.h"
+
+/// @brief Class for mocking stm32 HAL_ADC function using google test framework.
+class HAL_ADCMock : public CMockMocker<HAL_ADCMock> {
+ public:
+  HAL_ADCMock();
+
+  ~HAL_ADCMock();
+
+#if defined(HAL_ADC_MODULE_ENABLED)
+  CMOCK_MOCK_METHOD(HAL_StatusTypeDef, HAL_ADC_Start_DMA,
+                    (ADC_HandleTypeDef *, uint32_t *, uint32_t));
+#endif  // HAL_ADC_MODULE_ENABLED
+};
+
+#endif  // STM32_MODULE_HAL_ADC_MOCK_HPP
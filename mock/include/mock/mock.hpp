@@ -3,7 +3,9 @@
 
 #include "mock/can_transceiver_mock.hpp"
 #include "mock/cmsis_os2_mock.hpp"
+#include "mock/file_flash.hpp"
 #include "mock/freertos_mock.hpp"
+#include "mock/hal_adc_mock.hpp"
 #include "mock/hal_can_mock.hpp"
 #include "mock/hal_gpio_mock.hpp"
 #include "mock/hal_timer_mock.hpp"
@@ -0,0 +1,118 @@
+#include "mock/file_flash.hpp"
+
+// stl include
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+extern "C" {
+// stm32_module include
+#include "stm32_module/flash.h"
+#include "stm32_module/module_common.h"
+}
+
+/* constructor ---------------------------------------------------------------*/
+void FileFlash_ctor(FileFlash* self, const char* path, uint32_t sector_size,
+                    int num_sectors) {
+  // construct inherited class and redirect virtual function
+  Flash_ctor(&self->super_, sector_size, num_sectors);
+  static struct FlashVtbl vtbl = {
+      .read = __FileFlash_read,
+      .write = __FileFlash_write,
+      .erase = __FileFlash_erase,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  for (int i = 0; i < FILE_FLASH_MAX_SECTORS; i++) {
+    self->erase_count_[i] = 0;
+  }
+  self->write_failure_count_ = 0;
+  self->erase_failure_count_ = 0;
+
+  self->file_ = std::fopen(path, "r+b");
+  if (self->file_ == NULL) {
+    // create an erased flash
+    self->file_ = std::fopen(path, "w+b");
+    std::vector<uint8_t> erased(sector_size * num_sectors, FLASH_ERASED_BYTE);
+    std::fwrite(erased.data(), 1, erased.size(), self->file_);
+    std::fflush(self->file_);
+  }
+}
+
+void FileFlash_dtor(FileFlash* self) { std::fclose(self->file_); }
+
+/* member function -----------------------------------------------------------*/
+int FileFlash_get_erase_count(const FileFlash* self, int sector) {
+  return self->erase_count_[sector];
+}
+
+void FileFlash_inject_failure(FileFlash* self, int write_failure_count,
+                              int erase_failure_count) {
+  self->write_failure_count_ = write_failure_count;
+  self->erase_failure_count_ = erase_failure_count;
+}
+
+/* virtual function definition -----------------------------------------------*/
+ModuleRet __FileFlash_read(Flash* _self, uint32_t address, void* data,
+                           uint32_t size) {
+  module_assert(IS_FLASH_RANGE(_self, address, size));
+
+  FileFlash* self = (FileFlash*)_self;
+  if (std::fseek(self->file_, address, SEEK_SET) != 0 ||
+      std::fread(data, 1, size, self->file_) != size) {
+    return ModuleError;
+  }
+
+  return ModuleOK;
+}
+
+ModuleRet __FileFlash_write(Flash* _self, uint32_t address, const void* data,
+                            uint32_t size) {
+  module_assert(IS_FLASH_RANGE(_self, address, size));
+
+  FileFlash* self = (FileFlash*)_self;
+  if (self->write_failure_count_ > 0) {
+    self->write_failure_count_--;
+    return ModuleError;
+  }
+
+  // writing can only clear bits
+  std::vector<uint8_t> buffer(size);
+  if (__FileFlash_read(_self, address, buffer.data(), size) != ModuleOK) {
+    return ModuleError;
+  }
+  for (uint32_t i = 0; i < size; i++) {
+    buffer[i] &= ((const uint8_t*)data)[i];
+  }
+
+  if (std::fseek(self->file_, address, SEEK_SET) != 0 ||
+      std::fwrite(buffer.data(), 1, size, self->file_) != size) {
+    return ModuleError;
+  }
+  std::fflush(self->file_);
+
+  return ModuleOK;
+}
+
+ModuleRet __FileFlash_erase(Flash* _self, int sector) {
+  module_assert(IS_FLASH_SECTOR(_self, sector));
+
+  FileFlash* self = (FileFlash*)_self;
+  if (self->erase_failure_count_ > 0) {
+    self->erase_failure_count_--;
+    return ModuleError;
+  }
+
+  std::vector<uint8_t> erased(self->super_.sector_size_, FLASH_ERASED_BYTE);
+  if (std::fseek(self->file_, sector * self->super_.sector_size_, SEEK_SET) !=
+          0 ||
+      std::fwrite(erased.data(), 1, erased.size(), self->file_) !=
+          erased.size()) {
+    return ModuleError;
+  }
+  std::fflush(self->file_);
+  self->erase_count_[sector]++;
+
+  return ModuleOK;
+}
@@ -0,0 +1,21 @@
+#include "mock/hal_adc_mock.hpp"
+
+// stl include
+#include <cstdint>
+
+extern "C" {
+// stm32 include
+#include "stm32_module/stm32_hal.h"
+}
+
+// gtest include
+#include "cmock/cmock.h"
+
+HAL_ADCMock::HAL_ADCMock() {}
+
+HAL_ADCMock::~HAL_ADCMock() {}
+
+#if defined(HAL_ADC_MODULE_ENABLED)
+CMOCK_MOCK_FUNCTION(HAL_ADCMock, HAL_StatusTypeDef, HAL_ADC_Start_DMA,
+                    (ADC_HandleTypeDef *, uint32_t *, uint32_t));
+#endif
@@ -0,0 +1,346 @@
+#include "stm32_module/adc_sampler.h"
+
+// glibc include
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// stm32 include
+#include "stm32_module/stm32_hal.h"
+
+// freertos include
+#include "FreeRTOS.h"
+#include "task.h"
+
+// stm32_module include
+#include "stm32_module/error_handler.h"
+#include "stm32_module/filter.h"
+#include "stm32_module/filter_bank.h"
+#include "stm32_module/module_common.h"
+
+#if defined(HAL_ADC_MODULE_ENABLED)
+
+/* static variable -----------------------------------------------------------*/
+/// @brief List for tracking the list of adc samplers for using in dma
+/// callback.
+static List adc_sampler_list;
+
+/**
+ * @brief Flag for checking if this is the first adc sampler for initializing
+ * adc_sampler_list.
+ *
+ * This variable is not set to static since it has to be reset to true for
+ * testing purposes.
+ */
+/*static*/ bool is_first_adc_sampler = true;
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet AdcSampler_start(AdcSampler* const self) {
+  return self->super_.vptr_->start((Task*)self);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Task base class
+ModuleRet __AdcSampler_start(Task* const _self) {
+  module_assert(IS_NOT_NULL(_self));
+
+  AdcSampler* const self = (AdcSampler*)_self;
+  if (self->super_.state_ != TaskReset) {
+    return ModuleError;
+  }
+
+  // the task has to exist before dma hands over the first half
+  ModuleRet ret = Task_create_freertos_task(
+      (Task*)self, "adc_sampler", ADC_SAMPLER_TASK_PRIORITY, self->task_stack_,
+      ADC_SAMPLER_TASK_STACK_SIZE);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  if (HAL_ADC_Start_DMA(self->adc_handle_, (uint32_t*)self->dma_buffer_,
+                        ADC_SAMPLER_DMA_BUFFER_SIZE(self->num_channels_,
+                                                    self->num_samples_)) !=
+      HAL_OK) {
+    return ModuleError;
+  }
+
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void AdcSampler_ctor(AdcSampler* const self,
+                     ADC_HandleTypeDef* const adc_handle,
+                     uint16_t* const dma_buffer, const int num_channels,
+                     const int num_samples, float* const channel_buffer,
+                     ErrorHandler* const error_handler) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(adc_handle));
+  module_assert(IS_NOT_NULL(dma_buffer));
+  module_assert(IS_POSTIVE(num_channels));
+  module_assert(IS_LESS_OR_EQUAL(num_channels, ADC_SAMPLER_MAX_CHANNELS));
+  module_assert(IS_POSTIVE(num_samples));
+  module_assert(IS_NOT_NULL(channel_buffer));
+
+  // construct inherited class and redirect virtual function
+  Task_ctor(&self->super_, AdcSampler_task_code);
+  static struct TaskVtbl vtbl = {
+      .start = __AdcSampler_start,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->adc_handle_ = adc_handle;
+  self->error_handler_ = error_handler;
+  self->dma_buffer_ = dma_buffer;
+  self->num_channels_ = num_channels;
+  self->num_samples_ = num_samples;
+  self->channel_buffer_ = channel_buffer;
+  for (int i = 0; i < ADC_SAMPLER_MAX_CHANNELS; i++) {
+    self->filter_[i] = NULL;
+  }
+  self->filter_bank_ = NULL;
+  self->pending_ = 0;
+  self->next_half_ = 0;
+  self->block_count_ = 0;
+  self->overrun_count_ = 0;
+  self->skipped_count_ = 0;
+  self->reported_overrun_count_ = 0;
+  self->is_overrun_ = false;
+  if (is_first_adc_sampler) {
+    List_ctor(&adc_sampler_list);
+    is_first_adc_sampler = false;
+  }
+  List_push_back(&adc_sampler_list, &self->adc_sampler_list_cb, (void*)self);
+}
+
+/* member function -----------------------------------------------------------*/
+ModuleRet AdcSampler_set_filter(AdcSampler* const self, const int channel,
+                                Filter* const filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_ADC_SAMPLER_CHANNEL(channel));
+
+  if (self->super_.state_ != TaskReset || channel >= self->num_channels_) {
+    return ModuleError;
+  }
+
+  self->filter_[channel] = filter;
+
+  return ModuleOK;
+}
+
+ModuleRet AdcSampler_set_filter_bank(AdcSampler* const self,
+                                     FilterBank* const filter_bank) {
+  module_assert(IS_NOT_NULL(self));
+
+  if (self->super_.state_ != TaskReset ||
+      (filter_bank != NULL &&
+       filter_bank->num_channels_ != self->num_channels_)) {
+    return ModuleError;
+  }
+
+  self->filter_bank_ = filter_bank;
+
+  return ModuleOK;
+}
+
+uint32_t AdcSampler_get_block_count(const AdcSampler* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->block_count_, __ATOMIC_RELAXED);
+}
+
+uint32_t AdcSampler_get_overrun_count(const AdcSampler* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->overrun_count_, __ATOMIC_RELAXED);
+}
+
+uint32_t AdcSampler_get_skipped_count(const AdcSampler* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->skipped_count_, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Function for feeding a half of dma buffer to the filter bank and the
+ * filter of each channel.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The half of dma buffer.
+ * @return None.
+ */
+static void __AdcSampler_process(AdcSampler* const self,
+                                 const uint16_t* const data) {
+  const int num_channels = self->num_channels_;
+  const int num_samples = self->num_samples_;
+
+  // every conversion is already a frame of every channel for the filter bank
+  if (self->filter_bank_ != NULL) {
+    for (int i = 0; i < num_samples; i++) {
+      const uint16_t* const conversion = &data[i * num_channels];
+      for (int j = 0; j < num_channels; j++) {
+        self->frame_[j] = (float)conversion[j];
+      }
+      FilterBank_update(self->filter_bank_, self->frame_, NULL);
+    }
+  }
+
+  // de-interleave each channel and filter it in place as a block
+  float* const block = self->channel_buffer_;
+  for (int j = 0; j < num_channels; j++) {
+    Filter* const filter = self->filter_[j];
+    if (filter == NULL) {
+      continue;
+    }
+
+    for (int i = 0; i < num_samples; i++) {
+      block[i] = (float)data[i * num_channels + j];
+    }
+    int filtered_length;
+    Filter_update_block(filter, block, block, num_samples, &filtered_length);
+  }
+}
+
+/**
+ * @brief Function for reporting overrun to the error handler, which sets
+ * ERROR_CODE_ADC if any half is overrun since the last check and clears it
+ * otherwise.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return None.
+ */
+static void __AdcSampler_report_overrun(AdcSampler* const self) {
+  const uint32_t overrun_count =
+      __atomic_load_n(&self->overrun_count_, __ATOMIC_RELAXED);
+  const bool is_overrun = overrun_count != self->reported_overrun_count_;
+  self->reported_overrun_count_ = overrun_count;
+
+  // only write on change, and retry on the next half if the write is lost
+  if (self->error_handler_ == NULL || is_overrun == self->is_overrun_) {
+    return;
+  }
+  if (ErrorHandler_write_error(self->error_handler_, ERROR_CODE_ADC,
+                               is_overrun ? ERROR_SET : ERROR_CLEAR) ==
+      ModuleOK) {
+    self->is_overrun_ = is_overrun;
+  }
+}
+
+void AdcSampler_task_code(void* const _self) {
+  AdcSampler* const self = (AdcSampler*)_self;
+  const int half_size = self->num_channels_ * self->num_samples_;
+
+  while (1) {
+    xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+
+    // process halves in the order filled by dma, and only release a half after
+    // it is processed so that dma completing the other half detects overrun
+    uint32_t half = self->next_half_;
+    while (1) {
+      const uint32_t pending =
+          __atomic_load_n(&self->pending_, __ATOMIC_ACQUIRE);
+      if (!(pending & (1UL << half))) {
+        break;
+      }
+
+      // dma has completed the other half as well and is writing to this half
+      // again, hence drop this stale half and skip to the newest half
+      if (pending & (1UL << (half ^ 1UL))) {
+        __atomic_fetch_and(&self->pending_, ~(1UL << half), __ATOMIC_RELEASE);
+        __atomic_fetch_add(&self->skipped_count_, 1, __ATOMIC_RELAXED);
+        half ^= 1UL;
+        continue;
+      }
+
+      __AdcSampler_process(self, &self->dma_buffer_[half * half_size]);
+      __atomic_fetch_and(&self->pending_, ~(1UL << half), __ATOMIC_RELEASE);
+      __atomic_fetch_add(&self->block_count_, 1, __ATOMIC_RELAXED);
+      half ^= 1UL;
+    }
+    self->next_half_ = half;
+
+    __AdcSampler_report_overrun(self);
+  }
+}
+
+/* static and callback function ----------------------------------------------*/
+/**
+ * @brief Function for finding the adc sampler of an adc handler.
+ *
+ * @param[in] hadc Adc handler.
+ * @return AdcSampler* The adc sampler, NULL if not found.
+ */
+static AdcSampler* __AdcSampler_find(const ADC_HandleTypeDef* const hadc) {
+  if (is_first_adc_sampler) {
+    return NULL;
+  }
+
+  AdcSampler* sampler;
+  ListIter adc_iter;
+  ListIter_ctor(&adc_iter, &adc_sampler_list);
+  do {
+    sampler = (AdcSampler*)ListIter_next(&adc_iter);
+  } while (sampler != NULL && sampler->adc_handle_ != hadc);
+
+  return sampler;
+}
+
+/**
+ * @brief Function for handing a half of dma buffer completed by dma to the
+ * task.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] half The half completed, 0 for the first half and 1 for the
+ * second half.
+ * @return None.
+ */
+static void __AdcSampler_hand_over(AdcSampler* const self,
+                                   const uint32_t half) {
+  // dma is now writing the other half, which must have been processed
+  const uint32_t pending =
+      __atomic_fetch_or(&self->pending_, 1UL << half, __ATOMIC_ACQ_REL);
+  if (pending != 0) {
+    __atomic_fetch_add(&self->overrun_count_, 1, __ATOMIC_RELAXED);
+  }
+
+  BaseType_t require_contex_switch = pdFALSE;
+  xTaskNotifyFromISR((TaskHandle_t)&self->super_.task_control_block_, 0,
+                     eNoAction, &require_contex_switch);
+  portYIELD_FROM_ISR(require_contex_switch);
+}
+
+// isr from dma for completing the first half of dma buffer
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* const hadc) {
+  AdcSampler* const sampler = __AdcSampler_find(hadc);
+  if (sampler == NULL || sampler->super_.state_ != TaskRunning) {
+    return;
+  }
+
+  __AdcSampler_hand_over(sampler, 0);
+}
+
+// isr from dma for completing the second half of dma buffer
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* const hadc) {
+  AdcSampler* const sampler = __AdcSampler_find(hadc);
+  if (sampler == NULL || sampler->super_.state_ != TaskRunning) {
+    return;
+  }
+
+  __AdcSampler_hand_over(sampler, 1);
+}
+
+// isr from adc for overrun of adc data register or dma error
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef* const hadc) {
+  AdcSampler* const sampler = __AdcSampler_find(hadc);
+  if (sampler == NULL || sampler->super_.state_ != TaskRunning) {
+    return;
+  }
+
+  __atomic_fetch_add(&sampler->overrun_count_, 1, __ATOMIC_RELAXED);
+  BaseType_t require_contex_switch = pdFALSE;
+  xTaskNotifyFromISR((TaskHandle_t)&sampler->super_.task_control_block_, 0,
+                     eNoAction, &require_contex_switch);
+  portYIELD_FROM_ISR(require_contex_switch);
+}
+
+#endif  // HAL_ADC_MODULE_ENABLED
@@ -8,6 +8,8 @@
 
 // freertos include
 #include "FreeRTOS.h"
+#include "event_groups.h"
+#include "queue.h"
 #include "task.h"
 
 // stm32_module include
@@ -41,10 +43,90 @@ void ErrorHandler_ctor(ErrorHandler* self) {
   self->super_.vptr_ = &vtbl;
 
   // initialize member variable
-  self->error_code_ = 0;
+  for (uint32_t i = 0; i < ERROR_CODE_NUM_WORDS; i++) {
+    self->error_code_[i] = 0;
+  }
+  SeqLock_ctor(&self->error_seq_lock_, self->error_seq_lock_buffer_,
+               sizeof(self->error_code_));
+  for (uint32_t i = 0; i < ERROR_HANDLER_EVENT_QUEUE_LENGTH; i++) {
+    self->event_queue_[i].sequence = i;
+  }
+  self->event_queue_head_ = 0;
+  self->event_queue_tail_ = 0;
+  self->event_overflow_count_ = 0;
+  self->storm_window_start_ = 0;
+  self->change_timestamp_ = 0;
+  for (int i = 0; i < ERROR_HANDLER_MAX_CALLBACKS; i++) {
+    self->error_callbacks_[i] = NULL;
+  }
+  self->num_error_callbacks_ = 0;
+  for (uint32_t i = 0; i < ERROR_CODE_NUM_WORDS; i++) {
+    for (uint32_t j = 0; j < ERROR_CODE_WORD_BITS; j++) {
+      self->error_policies_[i][j] = NULL;
+      self->error_callback_map_[i][j] = 0;
+    }
+    for (uint32_t j = 0; j < ERROR_CODE_WORD_BITS; j++) {
+      self->occurrence_count_[i][j] = 0;
+      self->transition_count_[i][j] = 0;
+      self->storm_base_count_[i][j] = 0;
+    }
+    self->error_policy_mask_[i] = 0;
+    self->auto_clear_mask_[i] = 0;
+    self->requested_error_code_[i] = 0;
+    self->lost_mask_[i] = 0;
+    self->transition_mask_[i] = 0;
+    self->storm_mask_[i] = 0;
+    self->storm_touched_mask_[i] = 0;
+    for (int j = 0; j < NumErrorSeverity; j++) {
+      self->severity_mask_[j][i] = 0;
+    }
+  }
+  for (int i = 0; i < NumVehicleState; i++) {
+    self->reaction_table_[i] = ERROR_REACTION_NONE;
+  }
+  self->vehicle_state_ = VehicleStateNormal;
+  self->vehicle_status_ = VehicleStateNormal;
+  self->vehicle_state_reset_ = 0;
 }
 
 /* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for subscribing a filled error callback control block to its
+ * error code bits.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] error_callback_cb The error callback control block.
+ * @return ModuleRet Error code.
+ */
+static ModuleRet __ErrorHandler_subscribe(
+    ErrorHandler* const self,
+    struct error_callback_cb* const error_callback_cb) {
+  // claim an index for the callback
+  uint32_t index =
+      __atomic_load_n(&self->num_error_callbacks_, __ATOMIC_RELAXED);
+  do {
+    if (index >= ERROR_HANDLER_MAX_CALLBACKS) {
+      return ModuleError;
+    }
+  } while (!__atomic_compare_exchange_n(&self->num_error_callbacks_, &index,
+                                        index + 1, 1, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED));
+
+  // publish the callback before subscribing it to the error code bits, so that
+  // the task always sees a complete callback once it's in the map
+  __atomic_store_n(&self->error_callbacks_[index], error_callback_cb,
+                   __ATOMIC_RELEASE);
+  const uint32_t word = ERROR_CODE_WORD(error_callback_cb->error_code);
+  uint32_t bits = ERROR_CODE_BITS(error_callback_cb->error_code);
+  while (bits) {
+    __atomic_fetch_or(&self->error_callback_map_[word][__builtin_ctz(bits)],
+                      1UL << index, __ATOMIC_RELEASE);
+    bits &= bits - 1;
+  }
+
+  return ModuleOK;
+}
+
 ModuleRet ErrorHandler_add_error_callback(
     ErrorHandler* const self, struct error_callback_cb* const error_callback_cb,
     ErrorCallback_t callback, void* const arg, const uint32_t error_code) {
@@ -56,15 +138,114 @@ ModuleRet ErrorHandler_add_error_callback(
   error_callback_cb->callback = callback;
   error_callback_cb->arg = arg;
   error_callback_cb->error_code = error_code;
+  error_callback_cb->execution = ErrorCallbackInline;
+  error_callback_cb->worker = NULL;
+  error_callback_cb->event_group = NULL;
+  error_callback_cb->event_bits = 0;
+
+  return __ErrorHandler_subscribe(self, error_callback_cb);
+}
+
+ModuleRet ErrorHandler_add_deferred_error_callback(
+    ErrorHandler* const self, struct error_callback_cb* const error_callback_cb,
+    ErrorCallbackWorker* const worker, ErrorCallback_t callback,
+    void* const arg, const uint32_t error_code) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(error_callback_cb));
+  module_assert(IS_NOT_NULL(worker));
+  module_assert(IS_NOT_NULL(callback));
+  module_assert(IS_ERROR_CODE(error_code));
+
+  error_callback_cb->callback = callback;
+  error_callback_cb->arg = arg;
+  error_callback_cb->error_code = error_code;
+  error_callback_cb->execution = ErrorCallbackDeferred;
+  error_callback_cb->worker = worker;
+  error_callback_cb->event_group = NULL;
+  error_callback_cb->event_bits = 0;
+
+  return __ErrorHandler_subscribe(self, error_callback_cb);
+}
+
+ModuleRet ErrorHandler_add_error_event_group(
+    ErrorHandler* const self, struct error_callback_cb* const error_callback_cb,
+    EventGroupHandle_t event_group, const EventBits_t event_bits,
+    const uint32_t error_code) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(error_callback_cb));
+  module_assert(IS_NOT_NULL(event_group));
+  module_assert(IS_ERROR_CODE(error_code));
+
+  error_callback_cb->callback = NULL;
+  error_callback_cb->arg = NULL;
+  error_callback_cb->error_code = error_code;
+  error_callback_cb->execution = ErrorCallbackEventGroup;
+  error_callback_cb->worker = NULL;
+  error_callback_cb->event_group = event_group;
+  error_callback_cb->event_bits = event_bits;
+
+  return __ErrorHandler_subscribe(self, error_callback_cb);
+}
+
+ModuleRet ErrorHandler_add_error_policy(
+    ErrorHandler* const self, struct error_policy_cb* const error_policy_cb,
+    const uint32_t error_code, const ErrorPolicy policy, const uint32_t period,
+    const uint32_t count) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(error_policy_cb));
+  module_assert(IS_SINGLE_ERROR_CODE(error_code));
+  module_assert(IS_ERROR_POLICY(policy));
 
-  taskENTER_CRITICAL();
-  List_push_back(&self->error_callback_list_,
-                 &error_callback_cb->error_callback_list_cb, error_callback_cb);
-  taskEXIT_CRITICAL();
+  if (self->super_.state_ != TaskReset) {
+    return ModuleError;
+  }
+
+  error_policy_cb->policy = policy;
+  error_policy_cb->period = pdMS_TO_TICKS(period);
+  error_policy_cb->count = count;
+  error_policy_cb->assert_count = 0;
+  error_policy_cb->window_start = 0;
+  error_policy_cb->last_assert = 0;
+
+  const uint32_t word = ERROR_CODE_WORD(error_code);
+  const int bit = __builtin_ctz(ERROR_CODE_BITS(error_code));
+  if (policy == ErrorPolicyDirect) {
+    self->error_policies_[word][bit] = NULL;
+    self->error_policy_mask_[word] &= ~ERROR_CODE_BITS(error_code);
+  } else {
+    self->error_policies_[word][bit] = error_policy_cb;
+    self->error_policy_mask_[word] |= ERROR_CODE_BITS(error_code);
+  }
 
   return ModuleOK;
 }
 
+/**
+ * @brief Function for counting transitions of error code bits without policy
+ * for storm detection.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] word The index of the word.
+ * @param[in] changed_bits The error code bits changing requested state.
+ * @return None.
+ */
+static void __ErrorHandler_count_transitions(ErrorHandler* const self,
+                                             const uint32_t word,
+                                             const uint32_t changed_bits) {
+  if (!changed_bits) {
+    return;
+  }
+
+  uint32_t bits = changed_bits;
+  while (bits) {
+    __atomic_fetch_add(&self->transition_count_[word][__builtin_ctz(bits)], 1,
+                       __ATOMIC_RELAXED);
+    bits &= bits - 1;
+  }
+  __atomic_fetch_or(&self->transition_mask_[word], changed_bits,
+                    __ATOMIC_RELEASE);
+}
+
 ModuleRet ErrorHandler_write_error(ErrorHandler* const self,
                                    const uint32_t error_code,
                                    const uint32_t option) {
@@ -76,57 +257,716 @@ ModuleRet ErrorHandler_write_error(ErrorHandler* const self,
     return ModuleError;
   }
 
-  if (xPortIsInsideInterrupt()) {
+  const uint32_t word = ERROR_CODE_WORD(error_code);
+  const uint32_t bits = ERROR_CODE_BITS(error_code);
+  if (option == ERROR_SET) {
+    uint32_t set_bits = bits;
+    while (set_bits) {
+      __atomic_fetch_add(
+          &self->occurrence_count_[word][__builtin_ctz(set_bits)], 1,
+          __ATOMIC_RELAXED);
+      set_bits &= set_bits - 1;
+    }
+  }
+
+  // error code bits with policy are always queued since the policy depends on
+  // every assertion, while those without policy are only queued when their
+  // requested state changes and they are not in storm
+  const uint32_t policy_bits = bits & self->error_policy_mask_[word];
+  const uint32_t direct_bits = bits & ~policy_bits;
+  const uint32_t requested =
+      option == ERROR_SET
+          ? __atomic_fetch_or(&self->requested_error_code_[word], direct_bits,
+                              __ATOMIC_RELEASE)
+          : __atomic_fetch_and(&self->requested_error_code_[word],
+                               ~direct_bits, __ATOMIC_RELEASE);
+  const uint32_t changed_bits =
+      direct_bits & (option == ERROR_SET ? ~requested : requested);
+  __ErrorHandler_count_transitions(self, word, changed_bits);
+  const uint32_t queued_bits =
+      policy_bits |
+      (changed_bits &
+       ~__atomic_load_n(&self->storm_mask_[word], __ATOMIC_RELAXED));
+  if (!queued_bits) {
+    return ModuleOK;
+  }
+
+  const BaseType_t is_inside_interrupt = xPortIsInsideInterrupt();
+
+  // claim a slot of the event queue, the slot is free for the position when
+  // its sequence number equals to the position
+  struct error_event_slot* slot;
+  uint32_t position =
+      __atomic_load_n(&self->event_queue_head_, __ATOMIC_RELAXED);
+  ModuleRet ret = ModuleOK;
+  while (1) {
+    slot = &self->event_queue_[position &
+                               (ERROR_HANDLER_EVENT_QUEUE_LENGTH - 1UL)];
+    const int32_t diff =
+        (int32_t)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) -
+                  position);
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&self->event_queue_head_, &position,
+                                      position + 1, 1, __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      ret = ModuleBusy;
+      break;
+    } else {
+      position = __atomic_load_n(&self->event_queue_head_, __ATOMIC_RELAXED);
+    }
+  }
+
+  if (ret != ModuleOK) {
+    __atomic_fetch_add(&self->event_overflow_count_, 1, __ATOMIC_RELAXED);
+    // the event is lost, but the task still has to synchronize the error code
+    // bits without policy to their requested state
+    const uint32_t lost_bits = queued_bits & ~policy_bits;
+    if (!lost_bits) {
+      return ret;
+    }
+    __atomic_fetch_or(&self->lost_mask_[word], lost_bits, __ATOMIC_RELEASE);
+  } else {
+    // fill in and publish the event
+    slot->event.error_code = (word << ERROR_CODE_WORD_BITS) | queued_bits;
+    slot->event.option = option;
+    slot->event.timestamp = is_inside_interrupt ? xTaskGetTickCountFromISR()
+                                                : xTaskGetTickCount();
+    __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+  }
+
+  if (is_inside_interrupt) {
     BaseType_t require_contex_switch = pdFALSE;
-    xTaskNotifyFromISR((TaskHandle_t)&self->super_.task_control_block_,
-                       error_code | option, eSetBits, &require_contex_switch);
+    xTaskNotifyFromISR((TaskHandle_t)&self->super_.task_control_block_, 0,
+                       eNoAction, &require_contex_switch);
     portYIELD_FROM_ISR(require_contex_switch);
   } else {
-    xTaskNotify((TaskHandle_t)&self->super_.task_control_block_,
-                error_code | option, eSetBits);
+    xTaskNotify((TaskHandle_t)&self->super_.task_control_block_, 0,
+                eNoAction);
   }
 
-  return ModuleOK;
+  return ret;
 }
 
 ModuleRet ErrorHandler_get_error(const ErrorHandler* const self,
-                                 uint32_t* code) {
+                                 const uint32_t word, uint32_t* const code) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_ERROR_CODE_WORD(word));
+  module_assert(IS_NOT_NULL(code));
+
+  if (self->super_.state_ != TaskRunning) {
+    return ModuleError;
+  }
+
+  uint32_t error_code[ERROR_CODE_NUM_WORDS];
+  SeqLock_read(&self->error_seq_lock_, error_code);
+  *code = error_code[word];
+  return ModuleOK;
+}
+
+ModuleRet ErrorHandler_get_snapshot(const ErrorHandler* const self,
+                                    struct error_snapshot* const snapshot) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(snapshot));
+
   if (self->super_.state_ != TaskRunning) {
     return ModuleError;
   }
 
-  *code = self->error_code_;
+  snapshot->change_count =
+      SeqLock_read(&self->error_seq_lock_, snapshot->error_code) >> 1;
+  return ModuleOK;
+}
+
+uint32_t ErrorHandler_get_change_count(const ErrorHandler* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return SeqLock_get_sequence(&self->error_seq_lock_) >> 1;
+}
+
+TickType_t ErrorHandler_get_change_timestamp(const ErrorHandler* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return self->change_timestamp_;
+}
+
+uint32_t ErrorHandler_get_occurrence_count(const ErrorHandler* const self,
+                                           const uint32_t error_code) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_SINGLE_ERROR_CODE(error_code));
+
+  return __atomic_load_n(
+      &self->occurrence_count_[ERROR_CODE_WORD(error_code)]
+                              [__builtin_ctz(ERROR_CODE_BITS(error_code))],
+      __ATOMIC_RELAXED);
+}
+
+uint32_t ErrorHandler_get_overflow_count(const ErrorHandler* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->event_overflow_count_, __ATOMIC_RELAXED);
+}
+
+ModuleRet ErrorHandler_set_error_severity(ErrorHandler* const self,
+                                         const uint32_t error_code,
+                                         const ErrorSeverity severity) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_ERROR_CODE(error_code));
+  module_assert(IS_ERROR_SEVERITY(severity));
+
+  if (self->super_.state_ != TaskReset) {
+    return ModuleError;
+  }
+
+  const uint32_t word = ERROR_CODE_WORD(error_code);
+  for (int i = 0; i < NumErrorSeverity; i++) {
+    self->severity_mask_[i][word] &= ~ERROR_CODE_BITS(error_code);
+  }
+  self->severity_mask_[severity][word] |= ERROR_CODE_BITS(error_code);
+
+  return ModuleOK;
+}
+
+ModuleRet ErrorHandler_set_reaction(ErrorHandler* const self,
+                                    const VehicleState state,
+                                    const uint32_t reaction) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_VEHICLE_STATE(state));
+  module_assert(IS_ERROR_REACTION(reaction));
+
+  if (self->super_.state_ != TaskReset) {
+    return ModuleError;
+  }
+
+  self->reaction_table_[state] = (uint8_t)reaction;
+  if (state == VehicleStateNormal) {
+    self->vehicle_status_ = VehicleStateNormal | (reaction << 8);
+  }
+
   return ModuleOK;
 }
 
+uint32_t ErrorHandler_get_vehicle_status(const ErrorHandler* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->vehicle_status_, __ATOMIC_ACQUIRE);
+}
+
+ModuleRet ErrorHandler_reset_vehicle_state(ErrorHandler* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  if (self->super_.state_ != TaskRunning) {
+    return ModuleError;
+  }
+
+  __atomic_store_n(&self->vehicle_state_reset_, 1, __ATOMIC_RELEASE);
+  if (xPortIsInsideInterrupt()) {
+    BaseType_t require_contex_switch = pdFALSE;
+    xTaskNotifyFromISR((TaskHandle_t)&self->super_.task_control_block_, 0,
+                       eNoAction, &require_contex_switch);
+    portYIELD_FROM_ISR(require_contex_switch);
+  } else {
+    xTaskNotify((TaskHandle_t)&self->super_.task_control_block_, 0,
+                eNoAction);
+  }
+
+  return ModuleOK;
+}
+
+/**
+ * @brief Function for taking events from the event queue in order.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[out] events Buffer for the events.
+ * @param[in] max_events Maximum number of events to take.
+ * @return int Number of events taken.
+ */
+static int __ErrorHandler_take_events(ErrorHandler* const self,
+                                      struct error_event* const events,
+                                      const int max_events) {
+  int num_events = 0;
+  while (num_events < max_events) {
+    struct error_event_slot* const slot =
+        &self->event_queue_[self->event_queue_tail_ &
+                            (ERROR_HANDLER_EVENT_QUEUE_LENGTH - 1UL)];
+    // stop when the slot is not yet published, the producer will notify again
+    // after publishing it
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) !=
+        self->event_queue_tail_ + 1) {
+      break;
+    }
+
+    events[num_events++] = slot->event;
+    // release the slot for the next round of the queue
+    __atomic_store_n(&slot->sequence,
+                     self->event_queue_tail_ + ERROR_HANDLER_EVENT_QUEUE_LENGTH,
+                     __ATOMIC_RELEASE);
+    self->event_queue_tail_++;
+  }
+
+  return num_events;
+}
+
+/**
+ * @brief Function for calling the callbacks matching the error code.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] error_code The error code along with error option.
+ * @return None.
+ */
+static void __ErrorHandler_dispatch(ErrorHandler* const self,
+                                    const uint32_t error_code) {
+  // collect the callbacks subscribing to any of the error code bits, so that
+  // each callback is called at most once
+  const uint32_t word = ERROR_CODE_WORD(error_code);
+  uint32_t bits = ERROR_CODE_BITS(error_code);
+  uint32_t matched = 0;
+  while (bits) {
+    matched |= __atomic_load_n(
+        &self->error_callback_map_[word][__builtin_ctz(bits)],
+        __ATOMIC_ACQUIRE);
+    bits &= bits - 1;
+  }
+
+  while (matched) {
+    struct error_callback_cb* const error_callback_cb =
+        self->error_callbacks_[__builtin_ctz(matched)];
+    switch (error_callback_cb->execution) {
+      case ErrorCallbackDeferred: {
+        ErrorCallbackWorker* const worker = error_callback_cb->worker;
+        const struct error_callback_item item = {
+            .error_callback_cb = error_callback_cb,
+            .error_code = error_code,
+        };
+        if (xQueueSend(worker->callback_queue_, &item, 0) != pdTRUE) {
+          __atomic_fetch_add(&worker->dropped_count_, 1, __ATOMIC_RELAXED);
+        }
+        break;
+      }
+
+      case ErrorCallbackEventGroup:
+        // reflect the current state instead of the edge, since other error
+        // codes of the callback may still be set
+        if (self->error_code_[word] &
+            ERROR_CODE_BITS(error_callback_cb->error_code)) {
+          xEventGroupSetBits(error_callback_cb->event_group,
+                             error_callback_cb->event_bits);
+        } else {
+          xEventGroupClearBits(error_callback_cb->event_group,
+                               error_callback_cb->event_bits);
+        }
+        break;
+
+      default:
+        error_callback_cb->callback(error_callback_cb->arg, error_code);
+        break;
+    }
+    matched &= matched - 1;
+  }
+}
+
+/**
+ * @brief Function for applying error policy to an error event.
+ *
+ * @param[in,out] error_policy_cb The error policy control block.
+ * @param[in] event The error event.
+ * @param[in] is_set If the error is currently set.
+ * @return int If the error is set after applying the event.
+ */
+static int __ErrorHandler_apply_policy(
+    struct error_policy_cb* const error_policy_cb,
+    const struct error_event* const event, const int is_set) {
+  if (event->option == ERROR_RESET) {
+    error_policy_cb->assert_count = 0;
+    return 0;
+  }
+
+  switch (error_policy_cb->policy) {
+    case ErrorPolicyLatching:
+      return is_set || event->option == ERROR_SET;
+
+    case ErrorPolicyAutoClear:
+      if (event->option == ERROR_SET) {
+        error_policy_cb->last_assert = event->timestamp;
+        return 1;
+      }
+      return 0;
+
+    case ErrorPolicyDebounce:
+      if (event->option == ERROR_SET) {
+        if (error_policy_cb->assert_count == 0 ||
+            event->timestamp - error_policy_cb->window_start >
+                error_policy_cb->period) {
+          error_policy_cb->window_start = event->timestamp;
+          error_policy_cb->assert_count = 0;
+        }
+        error_policy_cb->assert_count++;
+        return is_set ||
+               error_policy_cb->assert_count >= error_policy_cb->count;
+      }
+      // once tripped, the error has to be set count times again to trip
+      // again, while clears before tripping don't restart the count
+      if (is_set) {
+        error_policy_cb->assert_count = 0;
+      }
+      return 0;
+
+    default:
+      return event->option == ERROR_SET;
+  }
+}
+
+/**
+ * @brief Function for updating vehicle state from the highest severity of
+ * errors currently set, and publishing it along with its reactions.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] reset Reset latched VehicleStateFatal.
+ * @return None.
+ */
+static void __ErrorHandler_update_vehicle_state(ErrorHandler* const self,
+                                                const int reset) {
+  // severity maps to vehicle state one to one, except that info errors don't
+  // affect vehicle state
+  VehicleState state = VehicleStateNormal;
+  for (int severity = ErrorSeverityFatal; severity > ErrorSeverityInfo;
+       severity--) {
+    uint32_t active = 0;
+    for (uint32_t word = 0; word < ERROR_CODE_NUM_WORDS; word++) {
+      active |= self->error_code_[word] & self->severity_mask_[severity][word];
+    }
+    if (active) {
+      state = (VehicleState)severity;
+      break;
+    }
+  }
+  if (self->vehicle_state_ == VehicleStateFatal && !reset) {
+    state = VehicleStateFatal;
+  }
+
+  if (state == self->vehicle_state_) {
+    return;
+  }
+  self->vehicle_state_ = state;
+  __atomic_store_n(
+      &self->vehicle_status_,
+      (VEHICLE_STATUS_CHANGE_COUNT(self->vehicle_status_) + 1) << 16 |
+          (uint32_t)self->reaction_table_[state] << 8 | state,
+      __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Function for updating error code of a word, and publishing it and
+ * calling callbacks for the changed bits.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] word The index of the word.
+ * @param[in] error_code The new error code bits of the word.
+ * @param[in] timestamp Tick count when the error state changed.
+ * @return None.
+ */
+static void __ErrorHandler_update_word(ErrorHandler* const self,
+                                       const uint32_t word,
+                                       const uint32_t error_code,
+                                       const TickType_t timestamp) {
+  const uint32_t changed = self->error_code_[word] ^ error_code;
+  if (!changed) {
+    return;
+  }
+
+  self->error_code_[word] = error_code;
+  self->change_timestamp_ = timestamp;
+  // publish the error state before calling callbacks so that they see the
+  // updated state
+  SeqLock_write(&self->error_seq_lock_, self->error_code_);
+  __ErrorHandler_update_vehicle_state(self, 0);
+
+  const uint32_t word_bits = word << ERROR_CODE_WORD_BITS;
+  if (changed & ~error_code) {
+    __ErrorHandler_dispatch(self, word_bits | (changed & ~error_code) |
+                                      ERROR_CLEAR);
+  }
+  if (changed & error_code) {
+    __ErrorHandler_dispatch(self,
+                            word_bits | (changed & error_code) | ERROR_SET);
+  }
+}
+
+/**
+ * @brief Function for applying an error event.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] event The error event.
+ * @return None.
+ */
+static void __ErrorHandler_handle_event(ErrorHandler* const self,
+                                        const struct error_event* const event) {
+  const uint32_t word = ERROR_CODE_WORD(event->error_code);
+  const uint32_t bits = ERROR_CODE_BITS(event->error_code);
+  uint32_t error_code = self->error_code_[word];
+
+  // error code bits without policy follow the event directly
+  const uint32_t direct_bits = bits & ~self->error_policy_mask_[word];
+  if (event->option == ERROR_SET) {
+    error_code |= direct_bits;
+  } else {
+    error_code &= ~direct_bits;
+  }
+
+  uint32_t policy_bits = bits & self->error_policy_mask_[word];
+  while (policy_bits) {
+    const int bit = __builtin_ctz(policy_bits);
+    struct error_policy_cb* const error_policy_cb =
+        self->error_policies_[word][bit];
+    if (__ErrorHandler_apply_policy(error_policy_cb, event,
+                                    (error_code >> bit) & 1UL)) {
+      error_code |= 1UL << bit;
+      if (error_policy_cb->policy == ErrorPolicyAutoClear) {
+        self->auto_clear_mask_[word] |= 1UL << bit;
+      }
+    } else {
+      error_code &= ~(1UL << bit);
+      self->auto_clear_mask_[word] &= ~(1UL << bit);
+    }
+    policy_bits &= policy_bits - 1;
+  }
+
+  __ErrorHandler_update_word(self, word, error_code, event->timestamp);
+}
+
+/**
+ * @brief Function for clearing errors with ErrorPolicyAutoClear that are not
+ * re-asserted within their period.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] current_tick The current tick count.
+ * @return TickType_t Ticks until the next error may be cleared,
+ * portMAX_DELAY if none.
+ */
+static TickType_t __ErrorHandler_auto_clear(ErrorHandler* const self,
+                                            const TickType_t current_tick) {
+  TickType_t timeout = portMAX_DELAY;
+  for (uint32_t word = 0; word < ERROR_CODE_NUM_WORDS; word++) {
+    uint32_t error_code = self->error_code_[word];
+    uint32_t auto_clear_bits = self->auto_clear_mask_[word];
+    while (auto_clear_bits) {
+      const int bit = __builtin_ctz(auto_clear_bits);
+      const struct error_policy_cb* const error_policy_cb =
+          self->error_policies_[word][bit];
+      const TickType_t elapsed = current_tick - error_policy_cb->last_assert;
+      if (elapsed >= error_policy_cb->period) {
+        error_code &= ~(1UL << bit);
+        self->auto_clear_mask_[word] &= ~(1UL << bit);
+      } else if (error_policy_cb->period - elapsed < timeout) {
+        timeout = error_policy_cb->period - elapsed;
+      }
+      auto_clear_bits &= auto_clear_bits - 1;
+    }
+
+    __ErrorHandler_update_word(self, word, error_code, current_tick);
+  }
+
+  return timeout;
+}
+
+/**
+ * @brief Function for synchronizing error code bits without policy to the
+ * state last requested by writers.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] word The index of the word.
+ * @param[in] direct_bits The error code bits without policy to synchronize.
+ * @param[in] current_tick The current tick count.
+ * @return None.
+ */
+static void __ErrorHandler_sync_requested(ErrorHandler* const self,
+                                          const uint32_t word,
+                                          const uint32_t direct_bits,
+                                          const TickType_t current_tick) {
+  const uint32_t requested =
+      __atomic_load_n(&self->requested_error_code_[word], __ATOMIC_ACQUIRE);
+  __ErrorHandler_update_word(
+      self, word,
+      (self->error_code_[word] & ~direct_bits) | (requested & direct_bits),
+      current_tick);
+}
+
+/**
+ * @brief Function for detecting error code bits in storm, and setting
+ * ERROR_CODE_STORM while any of them is in storm.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] current_tick The current tick count.
+ * @return TickType_t Ticks until the end of the current storm window,
+ * portMAX_DELAY if no error code is in storm.
+ */
+static TickType_t __ErrorHandler_detect_storm(ErrorHandler* const self,
+                                              const TickType_t current_tick) {
+  const TickType_t window = pdMS_TO_TICKS(ERROR_HANDLER_STORM_WINDOW);
+  const int is_window_end = current_tick - self->storm_window_start_ >= window;
+
+  uint32_t is_in_storm = 0;
+  for (uint32_t word = 0; word < ERROR_CODE_NUM_WORDS; word++) {
+    const uint32_t touched_mask =
+        self->storm_touched_mask_[word] |
+        __atomic_exchange_n(&self->transition_mask_[word], 0,
+                            __ATOMIC_ACQUIRE);
+    uint32_t storm_mask = self->storm_mask_[word];
+
+    // a bit enters storm as soon as it reaches the threshold, but only leaves
+    // storm at the end of a window
+    uint32_t bits = touched_mask | storm_mask;
+    while (bits) {
+      const int bit = __builtin_ctz(bits);
+      const uint32_t transition_count = __atomic_load_n(
+          &self->transition_count_[word][bit], __ATOMIC_RELAXED);
+      if (transition_count - self->storm_base_count_[word][bit] >=
+          ERROR_HANDLER_STORM_THRESHOLD) {
+        storm_mask |= 1UL << bit;
+      } else if (is_window_end) {
+        storm_mask &= ~(1UL << bit);
+      }
+
+      if (is_window_end) {
+        self->storm_base_count_[word][bit] = transition_count;
+      }
+      bits &= bits - 1;
+    }
+
+    self->storm_touched_mask_[word] = is_window_end ? 0 : touched_mask;
+    const uint32_t last_storm_mask = self->storm_mask_[word];
+    __atomic_store_n(&self->storm_mask_[word], storm_mask, __ATOMIC_RELAXED);
+    is_in_storm |= storm_mask;
+
+    // bits in storm during the window follow their last requested state at
+    // the end of the window, after the new storm mask is published so that
+    // writes of bits leaving storm are either queued or synchronized here
+    if (is_window_end && (last_storm_mask | storm_mask)) {
+      __ErrorHandler_sync_requested(self, word, last_storm_mask | storm_mask,
+                                    current_tick);
+    }
+  }
+  if (is_window_end) {
+    self->storm_window_start_ = current_tick;
+  }
+
+  // escalate to a single summary error instead of every transition
+  const uint32_t word = ERROR_CODE_WORD(ERROR_CODE_STORM);
+  const uint32_t storm_bit = ERROR_CODE_BITS(ERROR_CODE_STORM);
+  __ErrorHandler_update_word(self, word,
+                             is_in_storm
+                                 ? self->error_code_[word] | storm_bit
+                                 : self->error_code_[word] & ~storm_bit,
+                             current_tick);
+
+  if (!is_in_storm) {
+    return portMAX_DELAY;
+  }
+  return window - (current_tick - self->storm_window_start_);
+}
+
 void ErrorHandler_task_code(void* const _self) {
   ErrorHandler* const self = (ErrorHandler*)_self;
 
+  TickType_t timeout = portMAX_DELAY;
   while (1) {
-    uint32_t error_code;
-    xTaskNotifyWait(0, ERROR_CODE_ALL | ERROR_SET, &error_code, portMAX_DELAY);
-    if (error_code & ERROR_SET) {
-      self->error_code_ |= error_code & ERROR_CODE_ALL;
-    } else {
-      self->error_code_ &= ~(error_code & ERROR_CODE_ALL);
-    }
+    xTaskNotifyWait(0, 0, NULL, timeout);
 
-    ListIter error_callback_iter;
-    ListIter_ctor(&error_callback_iter, &self->error_callback_list_);
+    // drain the event queue in batches and apply the events in order
+    struct error_event events[ERROR_HANDLER_EVENT_BATCH_SIZE];
+    uint32_t direct_mask[ERROR_CODE_NUM_WORDS] = {0};
+    int num_events;
+    while ((num_events = __ErrorHandler_take_events(
+                self, events, ERROR_HANDLER_EVENT_BATCH_SIZE)) > 0) {
+      for (int i = 0; i < num_events; i++) {
+        const uint32_t word = ERROR_CODE_WORD(events[i].error_code);
+        direct_mask[word] |= ERROR_CODE_BITS(events[i].error_code) &
+                             ~self->error_policy_mask_[word];
+        __ErrorHandler_handle_event(self, &events[i]);
+      }
+    }
 
-    taskENTER_CRITICAL();
-    struct error_callback_cb* error_callback_cb =
-        (struct error_callback_cb*)ListIter_next(&error_callback_iter);
-    while (error_callback_cb != NULL) {
-      if (error_callback_cb->error_code & error_code) {
-        taskEXIT_CRITICAL();
-        error_callback_cb->callback(error_callback_cb->arg, error_code);
-        taskENTER_CRITICAL();
+    // writers change the requested state before claiming slots, so events of
+    // concurrent writers may be queued in a different order than their
+    // changes, hence error code bits without policy finally follow the
+    // requested state, along with those whose events are lost
+    const TickType_t current_tick = xTaskGetTickCount();
+    for (uint32_t word = 0; word < ERROR_CODE_NUM_WORDS; word++) {
+      direct_mask[word] |=
+          __atomic_exchange_n(&self->lost_mask_[word], 0, __ATOMIC_ACQUIRE);
+      if (direct_mask[word]) {
+        __ErrorHandler_sync_requested(self, word, direct_mask[word],
+                                      current_tick);
       }
+    }
 
-      error_callback_cb =
-          (struct error_callback_cb*)ListIter_next(&error_callback_iter);
+    timeout = __ErrorHandler_auto_clear(self, current_tick);
+    const TickType_t storm_timeout =
+        __ErrorHandler_detect_storm(self, current_tick);
+    if (storm_timeout < timeout) {
+      timeout = storm_timeout;
+    }
+
+    if (__atomic_exchange_n(&self->vehicle_state_reset_, 0, __ATOMIC_ACQUIRE)) {
+      __ErrorHandler_update_vehicle_state(self, 1);
+    }
+  }
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet ErrorCallbackWorker_start(ErrorCallbackWorker* const self) {
+  return self->super_.vptr_->start((Task*)self);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Task base class
+ModuleRet __ErrorCallbackWorker_start(Task* const _self) {
+  module_assert(IS_NOT_NULL(_self));
+
+  ErrorCallbackWorker* const self = (ErrorCallbackWorker*)_self;
+  return Task_create_freertos_task(
+      (Task*)self, "error_callback_worker", self->task_priority_,
+      self->task_stack_, ERROR_CALLBACK_WORKER_TASK_STACK_SIZE);
+}
+
+/* constructor ---------------------------------------------------------------*/
+void ErrorCallbackWorker_ctor(ErrorCallbackWorker* const self,
+                              const UBaseType_t task_priority) {
+  module_assert(IS_NOT_NULL(self));
+
+  // construct inherited class and redirect virtual function
+  Task_ctor((Task*)self, ErrorCallbackWorker_task_code);
+  static struct TaskVtbl vtbl = {
+      .start = __ErrorCallbackWorker_start,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->task_priority_ = task_priority;
+  self->callback_queue_ = xQueueCreateStatic(
+      ERROR_CALLBACK_WORKER_QUEUE_LENGTH, sizeof(struct error_callback_item),
+      (uint8_t*)self->callback_queue_buffer_, &self->callback_queue_cb_);
+  self->dropped_count_ = 0;
+}
+
+/* member function -----------------------------------------------------------*/
+uint32_t ErrorCallbackWorker_get_dropped_count(
+    const ErrorCallbackWorker* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->dropped_count_, __ATOMIC_RELAXED);
+}
+
+void ErrorCallbackWorker_task_code(void* const _self) {
+  ErrorCallbackWorker* const self = (ErrorCallbackWorker*)_self;
+
+  struct error_callback_item item;
+  while (1) {
+    if (xQueueReceive(self->callback_queue_, &item, portMAX_DELAY) == pdTRUE) {
+      item.error_callback_cb->callback(item.error_callback_cb->arg,
+                                       item.error_code);
     }
-    taskEXIT_CRITICAL();
   }
 }
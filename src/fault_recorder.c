@@ -0,0 +1,393 @@
+#include "stm32_module/fault_recorder.h"
+
+// glibc include
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// freertos include
+#include "FreeRTOS.h"
+#include "task.h"
+
+// stm32_module include
+#include "stm32_module/error_handler.h"
+#include "stm32_module/flash.h"
+#include "stm32_module/module_common.h"
+
+/* static function prototype -------------------------------------------------*/
+static void __FaultRecorder_recover(FaultRecorder* const self);
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet FaultRecorder_start(FaultRecorder* const self) {
+  return self->super_.vptr_->start((Task*)self);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Task base class
+ModuleRet __FaultRecorder_start(Task* const _self) {
+  module_assert(IS_NOT_NULL(_self));
+
+  FaultRecorder* const self = (FaultRecorder*)_self;
+  if (self->super_.state_ != TaskReset) {
+    return ModuleError;
+  }
+
+  __FaultRecorder_recover(self);
+
+  return Task_create_freertos_task(
+      (Task*)self, "fault_recorder", FAULT_RECORDER_TASK_PRIORITY,
+      self->task_stack_, FAULT_RECORDER_TASK_STACK_SIZE);
+}
+
+/* constructor ---------------------------------------------------------------*/
+void FaultRecorder_ctor(FaultRecorder* const self, Flash* const flash) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(flash));
+  module_assert(IS_GREATER_OR_EQUAL(Flash_get_num_sectors(flash), 2));
+  module_assert(IS_GREATER_OR_EQUAL(Flash_get_sector_size(flash),
+                                    sizeof(struct fault_record)));
+
+  // construct inherited class and redirect virtual function
+  Task_ctor((Task*)self, FaultRecorder_task_code);
+  static struct TaskVtbl vtbl = {
+      .start = __FaultRecorder_start,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->flash_ = flash;
+  self->error_handler_ = NULL;
+  self->freeze_frame_ = NULL;
+  self->freeze_frame_size_ = 0;
+  self->ring_head_ = 0;
+  self->ring_tail_ = 0;
+  self->dropped_count_ = 0;
+  self->write_failure_count_ = 0;
+  self->sequence_ = 0;
+  self->sector_ = 0;
+  self->slot_ = 0;
+  self->slots_per_sector_ =
+      Flash_get_sector_size(flash) / sizeof(struct fault_record);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for calculating checksum of a record by FNV-1a hash.
+ *
+ * @param[in] record The record.
+ * @return uint32_t The checksum.
+ */
+static uint32_t __FaultRecorder_checksum(
+    const struct fault_record* const record) {
+  const uint8_t* const data = (const uint8_t*)record;
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < offsetof(struct fault_record, checksum); i++) {
+    hash ^= data[i];
+    hash *= 16777619UL;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief Function for getting the address of a slot in flash.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] sector The sector of the slot.
+ * @param[in] slot The slot in the sector.
+ * @return uint32_t The address.
+ */
+static uint32_t __FaultRecorder_address(const FaultRecorder* const self,
+                                        const int sector, const int slot) {
+  return (uint32_t)sector * Flash_get_sector_size(self->flash_) +
+         (uint32_t)slot * sizeof(struct fault_record);
+}
+
+/**
+ * @brief Function for checking if a slot in flash is erased.
+ *
+ * @param[in] record The record read from the slot.
+ * @return int 1 if the slot is erased, 0 otherwise.
+ */
+static int __FaultRecorder_is_erased(const struct fault_record* const record) {
+  const uint8_t* const data = (const uint8_t*)record;
+  for (size_t i = 0; i < sizeof(struct fault_record); i++) {
+    if (data[i] != FLASH_ERASED_BYTE) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Function for advancing the position of the next record to write.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return None.
+ */
+static void __FaultRecorder_advance(FaultRecorder* const self) {
+  if (++self->slot_ == self->slots_per_sector_) {
+    self->slot_ = 0;
+    if (++self->sector_ == Flash_get_num_sectors(self->flash_)) {
+      self->sector_ = 0;
+    }
+  }
+}
+
+/**
+ * @brief Function for recovering the position of the log by finding the record
+ * with the largest sequence number in flash.
+ *
+ * @param[in,out] self The instance of the class.
+ * @return None.
+ */
+static void __FaultRecorder_recover(FaultRecorder* const self) {
+  int found = 0;
+  uint32_t last_sequence = 0;
+  int last_sector = 0;
+  int last_slot = 0;
+
+  struct fault_record record;
+  for (int i = 0; i < Flash_get_num_sectors(self->flash_); i++) {
+    for (int j = 0; j < self->slots_per_sector_; j++) {
+      if (Flash_read(self->flash_, __FaultRecorder_address(self, i, j),
+                     &record, sizeof(record)) != ModuleOK ||
+          record.checksum != __FaultRecorder_checksum(&record)) {
+        continue;
+      }
+
+      // compare by difference to handle wrap around of sequence number
+      if (!found || (int32_t)(record.sequence - last_sequence) > 0) {
+        found = 1;
+        last_sequence = record.sequence;
+        last_sector = i;
+        last_slot = j;
+      }
+    }
+  }
+
+  if (!found) {
+    // start a new log at the beginning, which is erased before written
+    self->sequence_ = 0;
+    self->sector_ = 0;
+    self->slot_ = 0;
+    return;
+  }
+
+  self->sequence_ = last_sequence + 1;
+  self->sector_ = last_sector;
+  self->slot_ = last_slot;
+  __FaultRecorder_advance(self);
+
+  // skip slots that are not erased, e.g. partially written before power loss,
+  // until a new sector that will be erased before written
+  while (self->slot_ != 0) {
+    if (Flash_read(self->flash_,
+                   __FaultRecorder_address(self, self->sector_, self->slot_),
+                   &record, sizeof(record)) == ModuleOK &&
+        __FaultRecorder_is_erased(&record)) {
+      break;
+    }
+    __FaultRecorder_advance(self);
+  }
+}
+
+/**
+ * @brief Function for skipping slots of the log, which consumes their sequence
+ * numbers so that records stay readable by index.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] num_slots The number of slots to skip.
+ * @return None.
+ */
+static void __FaultRecorder_skip(FaultRecorder* const self,
+                                 const int num_slots) {
+  taskENTER_CRITICAL();
+  for (int i = 0; i < num_slots; i++) {
+    self->sequence_++;
+    __FaultRecorder_advance(self);
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Function for appending a record to the log in flash.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] record The record, whose sequence and checksum are filled.
+ * @return ModuleRet Error code.
+ * @retval ModuleError Flash failed in every attempt and the record is lost.
+ */
+static ModuleRet __FaultRecorder_append(FaultRecorder* const self,
+                                        struct fault_record* const record) {
+  for (int i = 0; i < FAULT_RECORDER_MAX_ATTEMPTS; i++) {
+    // erase the oldest sector before the log wraps into it, or skip the whole
+    // sector if it fails to erase
+    if (self->slot_ == 0 &&
+        Flash_erase(self->flash_, self->sector_) != ModuleOK) {
+      __atomic_fetch_add(&self->write_failure_count_, 1, __ATOMIC_RELAXED);
+      __FaultRecorder_skip(self, self->slots_per_sector_);
+      continue;
+    }
+
+    record->sequence = self->sequence_;
+    record->checksum = __FaultRecorder_checksum(record);
+    const ModuleRet ret = Flash_write(
+        self->flash_, __FaultRecorder_address(self, self->sector_, self->slot_),
+        record, sizeof(*record));
+
+    // a slot failed to write may be partially programmed, hence is skipped
+    // and the record is retried at the next slot
+    __FaultRecorder_skip(self, 1);
+    if (ret == ModuleOK) {
+      return ModuleOK;
+    }
+    __atomic_fetch_add(&self->write_failure_count_, 1, __ATOMIC_RELAXED);
+  }
+
+  return ModuleError;
+}
+
+/**
+ * @brief Callback for capturing error transitions from error handler.
+ *
+ * @param[in,out] arg The instance of the class.
+ * @param[in] error_code The changed error code bits along with ERROR_SET or
+ * ERROR_CLEAR.
+ * @return None.
+ */
+static void __FaultRecorder_error_callback(void* const arg,
+                                           const uint32_t error_code) {
+  FaultRecorder* const self = (FaultRecorder*)arg;
+
+  // only the error handler task writes to the ring
+  const uint32_t head = self->ring_head_;
+  if (head - __atomic_load_n(&self->ring_tail_, __ATOMIC_ACQUIRE) >=
+      FAULT_RECORDER_RING_LENGTH) {
+    __atomic_fetch_add(&self->dropped_count_, 1, __ATOMIC_RELAXED);
+    return;
+  }
+
+  struct fault_record* const record =
+      &self->ring_[head & (FAULT_RECORDER_RING_LENGTH - 1UL)];
+  record->timestamp =
+      (uint32_t)ErrorHandler_get_change_timestamp(self->error_handler_);
+  record->error_code = error_code;
+  memset(record->freeze_frame, 0, sizeof(record->freeze_frame));
+  if (self->freeze_frame_ != NULL) {
+    memcpy(record->freeze_frame, self->freeze_frame_,
+           self->freeze_frame_size_);
+  }
+  __atomic_store_n(&self->ring_head_, head + 1, __ATOMIC_RELEASE);
+
+  if (self->super_.state_ == TaskRunning) {
+    xTaskNotify((TaskHandle_t)&self->super_.task_control_block_, 0,
+                eNoAction);
+  }
+}
+
+ModuleRet FaultRecorder_attach(FaultRecorder* const self,
+                               ErrorHandler* const error_handler) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(error_handler));
+
+  self->error_handler_ = error_handler;
+  for (uint32_t i = 0; i < ERROR_CODE_NUM_WORDS; i++) {
+    ModuleRet ret = ErrorHandler_add_error_callback(
+        error_handler, &self->error_callback_cb_[i],
+        __FaultRecorder_error_callback, self, ERROR_CODE_WORD_ALL(i));
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  return ModuleOK;
+}
+
+ModuleRet FaultRecorder_set_freeze_frame(FaultRecorder* const self,
+                                         const void* const data,
+                                         const uint32_t size) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_FREEZE_FRAME_SIZE(size));
+
+  if (self->super_.state_ != TaskReset) {
+    return ModuleError;
+  }
+
+  self->freeze_frame_ = data;
+  self->freeze_frame_size_ = size;
+
+  return ModuleOK;
+}
+
+ModuleRet FaultRecorder_read_record(FaultRecorder* const self,
+                                    const uint32_t index,
+                                    struct fault_record* const record) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(record));
+
+  const int num_sectors = Flash_get_num_sectors(self->flash_);
+  const uint32_t capacity = (uint32_t)self->slots_per_sector_ * num_sectors;
+  if (index >= capacity) {
+    return ModuleError;
+  }
+
+  taskENTER_CRITICAL();
+  const uint32_t sequence = self->sequence_;
+  const int sector = self->sector_;
+  const int slot = self->slot_;
+  taskEXIT_CRITICAL();
+
+  // step back from the position of the next record to write
+  const uint32_t position =
+      ((uint32_t)sector * self->slots_per_sector_ + slot + capacity - index -
+       1) %
+      capacity;
+  if (Flash_read(self->flash_,
+                 __FaultRecorder_address(
+                     self, position / self->slots_per_sector_,
+                     position % self->slots_per_sector_),
+                 record, sizeof(*record)) != ModuleOK) {
+    return ModuleError;
+  }
+
+  if (record->checksum != __FaultRecorder_checksum(record) ||
+      record->sequence != sequence - index - 1) {
+    return ModuleError;
+  }
+
+  return ModuleOK;
+}
+
+uint32_t FaultRecorder_get_dropped_count(const FaultRecorder* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->dropped_count_, __ATOMIC_RELAXED);
+}
+
+uint32_t FaultRecorder_get_write_failure_count(
+    const FaultRecorder* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->write_failure_count_, __ATOMIC_RELAXED);
+}
+
+void FaultRecorder_task_code(void* const _self) {
+  FaultRecorder* const self = (FaultRecorder*)_self;
+
+  while (1) {
+    xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+
+    uint32_t tail = self->ring_tail_;
+    while (tail != __atomic_load_n(&self->ring_head_, __ATOMIC_ACQUIRE)) {
+      struct fault_record record =
+          self->ring_[tail & (FAULT_RECORDER_RING_LENGTH - 1UL)];
+      __atomic_store_n(&self->ring_tail_, ++tail, __ATOMIC_RELEASE);
+
+      if (__FaultRecorder_append(self, &record) != ModuleOK) {
+        __atomic_fetch_add(&self->dropped_count_, 1, __ATOMIC_RELAXED);
+      }
+    }
+  }
+}
@@ -1,12 +1,9 @@
 #include "stm32_module/filter.h"
 
 // glibc include
+#include <stdbool.h>
 #include <stdint.h>
 
-// freertos include
-#include "FreeRTOS.h"
-#include "queue.h"
-
 /* virtual function redirection ----------------------------------------------*/
 inline ModuleRet Filter_update(Filter *const self, const float data,
                                float *const filtered_data) {
@@ -18,6 +15,15 @@ inline ModuleRet Filter_get_filtered_data(Filter *const self,
   return self->vptr_->get_filtered_data(self, filtered_data);
 }
 
+inline ModuleRet Filter_update_block(Filter *const self,
+                                     const float *const data,
+                                     float *const filtered_data,
+                                     const int length,
+                                     int *const filtered_length) {
+  return self->vptr_->update_block(self, data, filtered_data, length,
+                                   filtered_length);
+}
+
 /* virtual function definition -----------------------------------------------*/
 // pure virtual function for Filter base class
 ModuleRet __Filter_update(Filter *const self, const float data,
@@ -40,6 +46,32 @@ ModuleRet __Filter_get_filtered_data(Filter *const self,
   return ModuleError;
 }
 
+// default virtual function for Filter base class
+ModuleRet __Filter_update_block(Filter *const self, const float *const data,
+                                float *const filtered_data, const int length,
+                                int *const filtered_length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  // add data one by one and keep only the ready filtered data
+  int count = 0;
+  for (int i = 0; i < length; i++) {
+    ModuleRet ret = Filter_update(self, data[i], &filtered_data[count]);
+    if (ret == ModuleOK) {
+      count++;
+    } else if (ret != ModuleBusy) {
+      *filtered_length = count;
+      return ret;
+    }
+  }
+
+  *filtered_length = count;
+  return ModuleOK;
+}
+
 /* constructor ---------------------------------------------------------------*/
 void Filter_ctor(Filter *const self, Filter *const chained_filter) {
   module_assert(IS_NOT_NULL(self));
@@ -48,6 +80,7 @@ void Filter_ctor(Filter *const self, Filter *const chained_filter) {
   static struct FilterVtbl vtbl_base = {
       .update = __Filter_update,
       .get_filtered_data = __Filter_get_filtered_data,
+      .update_block = __Filter_update_block,
   };
   self->vptr_ = &vtbl_base;
 
@@ -55,6 +88,33 @@ void Filter_ctor(Filter *const self, Filter *const chained_filter) {
   self->chained_filter_ = chained_filter;
 }
 
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for processing a block of data by the chained filter, if
+ * any, before the filter itself.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] data The data to be added, which is replaced by filtered_data
+ * if there is a chained filter.
+ * @param[out] filtered_data The filtered data of the chained filter.
+ * @param[in,out] length The length of data, which is replaced by the number of
+ * filtered data of the chained filter.
+ * @return ModuleRet Error code.
+ */
+static ModuleRet __Filter_update_chained_block(Filter *const self,
+                                               const float **const data,
+                                               float *const filtered_data,
+                                               int *const length) {
+  if (self->chained_filter_ == NULL) {
+    return ModuleOK;
+  }
+
+  ModuleRet ret = Filter_update_block(self->chained_filter_, *data,
+                                      filtered_data, *length, length);
+  *data = filtered_data;
+  return ret;
+}
+
 /* virtual function redirection ----------------------------------------------*/
 inline ModuleRet MovingAverageFilter_update(MovingAverageFilter *const self,
                                             const float data,
@@ -67,6 +127,60 @@ inline ModuleRet MovingAverageFilter_get_filtered_data(
   return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
 }
 
+inline ModuleRet MovingAverageFilter_update_block(
+    MovingAverageFilter *const self, const float *const data,
+    float *const filtered_data, const int length, int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for replacing the oldest data in the ring buffer with new
+ * data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @return bool True if the window is filled or partial mode is enabled.
+ */
+static bool __MovingAverageFilter_process(MovingAverageFilter *const self,
+                                          const float data) {
+  // update the sums in local variables and store them once, as storing one and
+  // then loading both stalls store forwarding if the compiler pairs them
+  float sum = self->sum_;
+  float round_sum = self->round_sum_;
+  if (self->size_ == self->window_size_) {
+    sum -= self->buffer_[self->index_];
+  } else {
+    self->size_++;
+  }
+  self->buffer_[self->index_] = data;
+  sum += data;
+  round_sum += data;
+
+  // the sum of a whole round is exact up to rounding of the round itself
+  if (++self->index_ == self->window_size_) {
+    self->index_ = 0;
+    sum = round_sum;
+    round_sum = 0.0F;
+  }
+
+  self->sum_ = sum;
+  self->round_sum_ = round_sum;
+  return self->size_ == self->window_size_ || self->is_partial_;
+}
+
+/**
+ * @brief Function for getting the average of the data in the window.
+ *
+ * @param[in] self The instance of the class.
+ * @return float The average.
+ */
+static inline float __MovingAverageFilter_average(
+    const MovingAverageFilter *const self) {
+  return self->sum_ / self->size_;
+}
+
 /* virtual function definition -----------------------------------------------*/
 // from Filter base class
 ModuleRet __MovingAverageFilter_update(Filter *const _self, float data,
@@ -83,34 +197,9 @@ ModuleRet __MovingAverageFilter_update(Filter *const _self, float data,
     }
   }
 
-  // calculate moving average
-  // if queue is full, remove the oldest data from the queue
-  UBaseType_t queue_size;
-  if (xPortIsInsideInterrupt()) {
-    queue_size = uxQueueMessagesWaitingFromISR(self->data_queue_);
-  } else {
-    queue_size = uxQueueMessagesWaiting(self->data_queue_);
-  }
-  if (queue_size == (UBaseType_t)self->window_size_) {
-    float oldest_value;
-    if (xPortIsInsideInterrupt()) {
-      xQueueReceiveFromISR(self->data_queue_, &oldest_value, NULL);
-    } else {
-      xQueueReceive(self->data_queue_, &oldest_value, 0);
-    }
-    self->sum_ -= oldest_value;
-  }
-  // add new data to the queue
-  self->sum_ += data;
-  if (xPortIsInsideInterrupt()) {
-    xQueueSendToBackFromISR(self->data_queue_, &data, NULL);
-  } else {
-    xQueueSendToBack(self->data_queue_, &data, 0);
-  }
-  // if queue is full, calculate moving average
-  if (queue_size == (UBaseType_t)self->window_size_) {
+  if (__MovingAverageFilter_process(self, data)) {
     if (filtered_data != NULL) {
-      *filtered_data = self->sum_ / self->window_size_;
+      *filtered_data = __MovingAverageFilter_average(self);
     }
     return ModuleOK;
   }
@@ -124,38 +213,156 @@ ModuleRet __MovingAverageFilter_get_filtered_data(Filter *const _self,
   module_assert(IS_NOT_NULL(filtered_data));
 
   MovingAverageFilter *const self = (MovingAverageFilter *)_self;
-  if ((xPortIsInsideInterrupt() &&
-       uxQueueMessagesWaitingFromISR(self->data_queue_) ==
-           (UBaseType_t)self->window_size_) ||
-      uxQueueMessagesWaiting(self->data_queue_) ==
-          (UBaseType_t)self->window_size_) {
-    *filtered_data = self->sum_ / self->window_size_;
+  if (self->size_ == self->window_size_ ||
+      (self->is_partial_ && self->size_ > 0)) {
+    *filtered_data = __MovingAverageFilter_average(self);
     return ModuleOK;
   }
   return ModuleBusy;
 }
 
+// from Filter base class
+ModuleRet __MovingAverageFilter_update_block(Filter *const _self,
+                                             const float *data,
+                                             float *const filtered_data,
+                                             int length,
+                                             int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  MovingAverageFilter *const self = (MovingAverageFilter *)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  // keep the state in local variables for the whole block
+  float *const buffer = self->buffer_;
+  const int window_size = self->window_size_;
+  int size = self->size_;
+  int index = self->index_;
+  float sum = self->sum_;
+  float round_sum = self->round_sum_;
+  const bool is_partial = self->is_partial_;
+
+  int count = 0;
+  for (int i = 0; i < length; i++) {
+    const float value = data[i];
+    if (size == window_size) {
+      sum -= buffer[index];
+    } else {
+      size++;
+    }
+    buffer[index] = value;
+    sum += value;
+    round_sum += value;
+
+    if (++index == window_size) {
+      index = 0;
+      sum = round_sum;
+      round_sum = 0.0F;
+    }
+
+    // filtered data never overtakes data, hence the buffers can be the same
+    if (size == window_size || is_partial) {
+      filtered_data[count++] = sum / size;
+    }
+  }
+
+  self->size_ = size;
+  self->index_ = index;
+  self->sum_ = sum;
+  self->round_sum_ = round_sum;
+  *filtered_length = count;
+  return ModuleOK;
+}
+
 /* constructor ---------------------------------------------------------------*/
 void MovingAverageFilter_ctor(MovingAverageFilter *const self,
                               float *const filter_buffer, const int window_size,
                               Filter *const chained_filter) {
   module_assert(IS_NOT_NULL(self));
   module_assert(IS_NOT_NULL(filter_buffer));
-  module_assert(IS_NOT_NEGATIVE(window_size));
+  module_assert(IS_POSTIVE(window_size));
 
   // construct inherited class and redirect virtual function
   Filter_ctor((Filter *)self, chained_filter);
   static struct FilterVtbl vtbl = {
       .update = __MovingAverageFilter_update,
       .get_filtered_data = __MovingAverageFilter_get_filtered_data,
+      .update_block = __MovingAverageFilter_update_block,
   };
   self->super_.vptr_ = &vtbl;
 
   // initialize member variable
-  self->data_queue_ = xQueueCreateStatic(
-      window_size, sizeof(float), (uint8_t *)filter_buffer, &self->queue_cb_);
+  self->buffer_ = filter_buffer;
   self->window_size_ = window_size;
-  self->sum_ = 0;
+  self->size_ = 0;
+  self->index_ = 0;
+  self->sum_ = 0.0F;
+  self->round_sum_ = 0.0F;
+  self->is_partial_ = false;
+}
+
+/* member function -----------------------------------------------------------*/
+void MovingAverageFilter_set_partial(MovingAverageFilter *const self,
+                                     const bool is_partial) {
+  module_assert(IS_NOT_NULL(self));
+
+  self->is_partial_ = is_partial;
+}
+
+void MovingAverageFilter_prefill(MovingAverageFilter *const self,
+                                 const float data) {
+  module_assert(IS_NOT_NULL(self));
+
+  for (int i = 0; i < self->window_size_; i++) {
+    self->buffer_[i] = data;
+  }
+  self->size_ = self->window_size_;
+  self->index_ = 0;
+  self->sum_ = data * self->window_size_;
+  self->round_sum_ = 0.0F;
+}
+
+int MovingAverageFilter_save(const MovingAverageFilter *const self,
+                             float *const data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+
+  // the oldest data is at index once the window is filled, otherwise at 0
+  int index = self->size_ == self->window_size_ ? self->index_ : 0;
+  for (int i = 0; i < self->size_; i++) {
+    data[i] = self->buffer_[index];
+    if (++index == self->window_size_) {
+      index = 0;
+    }
+  }
+  return self->size_;
+}
+
+void MovingAverageFilter_restore(MovingAverageFilter *const self,
+                                 const float *const data, const int size) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NEGATIVE(size));
+
+  self->size_ = 0;
+  self->index_ = 0;
+  self->sum_ = 0.0F;
+  self->round_sum_ = 0.0F;
+
+  // the sums are rebuilt exactly as if the data were added again
+  const int start = size > self->window_size_ ? size - self->window_size_ : 0;
+  for (int i = start; i < size; i++) {
+    __MovingAverageFilter_process(self, data[i]);
+  }
 }
 
 /* virtual function redirection ----------------------------------------------*/
@@ -170,6 +377,39 @@ inline ModuleRet NormalizeFilter_get_filtered_data(NormalizeFilter *const self,
   return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
 }
 
+inline ModuleRet NormalizeFilter_update_block(NormalizeFilter *const self,
+                                              const float *const data,
+                                              float *const filtered_data,
+                                              const int length,
+                                              int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for updating the bounds with new data and normalizing it.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @return float The normalized data.
+ */
+static float __NormalizeFilter_process(NormalizeFilter *const self,
+                                       const float data) {
+  // update bounds
+  if (self->upper_bound_ < data) {
+    self->upper_bound_ = data;
+  }
+  if (self->lower_bound_ > data) {
+    self->lower_bound_ = data;
+  }
+
+  // normalize data
+  self->filtered_data_ =
+      (data - self->lower_bound_) / (self->upper_bound_ - self->lower_bound_);
+  return self->filtered_data_;
+}
+
 /* virtual function definition -----------------------------------------------*/
 // from Filter base class
 ModuleRet __NormalizeFilter_update(Filter *const _self, float data,
@@ -186,18 +426,7 @@ ModuleRet __NormalizeFilter_update(Filter *const _self, float data,
     }
   }
 
-  // update bounds
-  if (self->upper_bound_ < data) {
-    self->upper_bound_ = data;
-  }
-  if (self->lower_bound_ > data) {
-    self->lower_bound_ = data;
-  }
-
-  // normalize data
-  self->filtered_data_ =
-      (data - self->lower_bound_) / (self->upper_bound_ - self->lower_bound_);
-  *filtered_data = self->filtered_data_;
+  *filtered_data = __NormalizeFilter_process(self, data);
   return ModuleOK;
 }
 
@@ -212,6 +441,65 @@ ModuleRet __NormalizeFilter_get_filtered_data(Filter *const _self,
   return ModuleOK;
 }
 
+// from Filter base class
+ModuleRet __NormalizeFilter_update_block(Filter *const _self,
+                                         const float *data,
+                                         float *const filtered_data,
+                                         int length,
+                                         int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  NormalizeFilter *const self = (NormalizeFilter *)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+  if (length == 0) {
+    return ModuleOK;
+  }
+
+  float lower_bound = self->lower_bound_;
+  float upper_bound = self->upper_bound_;
+
+  // branchless check and normalization so that both loops can be vectorized
+  int out_of_bounds = 0;
+  for (int i = 0; i < length; i++) {
+    out_of_bounds |= (data[i] < lower_bound) | (data[i] > upper_bound);
+  }
+
+  if (!out_of_bounds) {
+    const float range = upper_bound - lower_bound;
+    for (int i = 0; i < length; i++) {
+      filtered_data[i] = (data[i] - lower_bound) / range;
+    }
+  } else {
+    // bounds change within the block, update them sample by sample
+    for (int i = 0; i < length; i++) {
+      const float value = data[i];
+      if (upper_bound < value) {
+        upper_bound = value;
+      }
+      if (lower_bound > value) {
+        lower_bound = value;
+      }
+      filtered_data[i] = (value - lower_bound) / (upper_bound - lower_bound);
+    }
+    self->lower_bound_ = lower_bound;
+    self->upper_bound_ = upper_bound;
+  }
+
+  self->filtered_data_ = filtered_data[length - 1];
+  *filtered_length = length;
+  return ModuleOK;
+}
+
 /* constructor ---------------------------------------------------------------*/
 void NormalizeFilter_ctor(NormalizeFilter *const self, const float lower_bound,
                           const float upper_bound,
@@ -225,6 +513,7 @@ void NormalizeFilter_ctor(NormalizeFilter *const self, const float lower_bound,
   static struct FilterVtbl vtbl = {
       .update = __NormalizeFilter_update,
       .get_filtered_data = __NormalizeFilter_get_filtered_data,
+      .update_block = __NormalizeFilter_update_block,
   };
   self->super_.vptr_ = &vtbl;
 
@@ -233,17 +522,105 @@ void NormalizeFilter_ctor(NormalizeFilter *const self, const float lower_bound,
   self->upper_bound_ = upper_bound;
 }
 
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet KalmanFilter1D_update_block(KalmanFilter1D *const self,
+                                             const float *const z,
+                                             float *const x, const int length,
+                                             int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, z, x, length,
+                                          filtered_length);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __KalmanFilter1D_update(Filter *const _self, float data,
+                                  float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  KalmanFilter1D *const self = (KalmanFilter1D *)_self;
+  const float x = KalmanFilter1D_update(self, data);
+  if (filtered_data != NULL) {
+    *filtered_data = x;
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __KalmanFilter1D_get_filtered_data(Filter *const _self,
+                                             float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  KalmanFilter1D *const self = (KalmanFilter1D *)_self;
+  *filtered_data = self->x_;
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __KalmanFilter1D_update_block(Filter *const _self,
+                                        const float *const z, float *const x,
+                                        const int length,
+                                        int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(z));
+  module_assert(IS_NOT_NULL(x));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  KalmanFilter1D *const self = (KalmanFilter1D *)_self;
+  KalmanFilter1D_update_n(self, z, x, length);
+  *filtered_length = length;
+  return ModuleOK;
+}
+
 /* constructor ---------------------------------------------------------------*/
 void KalmanFilter1D_ctor(KalmanFilter1D *const self, float Q, float R, float x0,
                          float P0) {
+  module_assert(IS_NOT_NULL(self));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter *)self, NULL);
+  static struct FilterVtbl vtbl = {
+      .update = __KalmanFilter1D_update,
+      .get_filtered_data = __KalmanFilter1D_get_filtered_data,
+      .update_block = __KalmanFilter1D_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
   self->Q_ = Q;
   self->R_ = R;
   self->x_ = x0;
   self->P_ = P0;
+  self->K_ = 0.0F;
+  self->tolerance_ = 0.0F;
+  self->steady_state_enabled_ = false;
+  self->is_steady_state_ = false;
 }
 
 /* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for checking if the gain of kalman filter is converged.
+ *
+ * @param[in] K The gain of this update.
+ * @param[in] K_prev The gain of the last update.
+ * @param[in] tolerance The relative change of gain for convergence.
+ * @return bool True if converged.
+ */
+static inline bool __KalmanFilter1D_is_converged(const float K,
+                                                 const float K_prev,
+                                                 const float tolerance) {
+  const float change = K - K_prev;
+  return change <= tolerance * K && -change <= tolerance * K;
+}
+
 float KalmanFilter1D_update(KalmanFilter1D *const self, float z) {
+  // fixed gain without division in steady state
+  if (self->is_steady_state_) {
+    self->x_ = self->x_ + self->K_ * (z - self->x_);
+    return self->x_;
+  }
+
   // predict step
   float x_pred = self->x_;
   float P_pred = self->P_ + self->Q_;
@@ -253,11 +630,1806 @@ float KalmanFilter1D_update(KalmanFilter1D *const self, float z) {
   self->x_ = x_pred + K * (z - x_pred);
   self->P_ = (1 - K) * P_pred;
 
+  if (self->steady_state_enabled_ &&
+      __KalmanFilter1D_is_converged(K, self->K_, self->tolerance_)) {
+    self->is_steady_state_ = true;
+  }
+  self->K_ = K;
+
   return self->x_;
 }
 
+float KalmanFilter1D_update_n(KalmanFilter1D *const self, const float *const z,
+                              float *const x, const int length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(z));
+  module_assert(IS_NOT_NULL(x));
+  module_assert(IS_NOT_NEGATIVE(length));
+
+  // keep the state in local variables for the whole batch
+  float x_est = self->x_;
+  int i = 0;
+
+  // full update until the gain converges
+  if (!self->is_steady_state_) {
+    const float Q = self->Q_;
+    const float R = self->R_;
+    const bool steady_state_enabled = self->steady_state_enabled_;
+    const float tolerance = self->tolerance_;
+    float P = self->P_;
+    float K_prev = self->K_;
+
+    while (i < length) {
+      // predict step
+      const float P_pred = P + Q;
+
+      // update step
+      const float K = P_pred / (P_pred + R);
+      x_est = x_est + K * (z[i] - x_est);
+      P = (1 - K) * P_pred;
+      x[i++] = x_est;
+
+      const bool is_converged =
+          steady_state_enabled &&
+          __KalmanFilter1D_is_converged(K, K_prev, tolerance);
+      K_prev = K;
+      if (is_converged) {
+        self->is_steady_state_ = true;
+        break;
+      }
+    }
+
+    self->P_ = P;
+    self->K_ = K_prev;
+  }
+
+  // fixed gain without division for the rest of the batch
+  if (self->is_steady_state_) {
+    const float K = self->K_;
+    for (; i < length; i++) {
+      x_est = x_est + K * (z[i] - x_est);
+      x[i] = x_est;
+    }
+  }
+
+  self->x_ = x_est;
+  return x_est;
+}
+
+void KalmanFilter1D_enable_steady_state(KalmanFilter1D *const self,
+                                        const float tolerance) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(tolerance));
+
+  self->tolerance_ = tolerance;
+  self->steady_state_enabled_ = true;
+}
+
+void KalmanFilter1D_disable_steady_state(KalmanFilter1D *const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  self->steady_state_enabled_ = false;
+  self->is_steady_state_ = false;
+}
+
+bool KalmanFilter1D_is_steady_state(KalmanFilter1D *const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return self->is_steady_state_;
+}
+
 float KalmanFilter1D_get_state(KalmanFilter1D *const self) { return self->x_; }
 
 float KalmanFilter1D_get_covariance(KalmanFilter1D *const self) {
   return self->P_;
 }
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet FirFilter_update(FirFilter *const self, const float data,
+                                  float *const filtered_data) {
+  return self->super_.vptr_->update((Filter *)self, data, filtered_data);
+}
+
+inline ModuleRet FirFilter_get_filtered_data(FirFilter *const self,
+                                             float *const filtered_data) {
+  return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
+}
+
+inline ModuleRet FirFilter_update_block(FirFilter *const self,
+                                        const float *const data,
+                                        float *const filtered_data,
+                                        const int length,
+                                        int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for adding new data to the delay line and computing the
+ * filtered data.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @return float The filtered data.
+ */
+static float __FirFilter_process(FirFilter *const self, const float data) {
+  const int num_taps = self->num_taps_;
+
+  // move backward so that the latest data comes first, and write to both
+  // halves so that the latest num_taps data are contiguous from index
+  const int index = self->index_ == 0 ? num_taps - 1 : self->index_ - 1;
+  self->index_ = index;
+  self->delay_line_[index] = data;
+  self->delay_line_[index + num_taps] = data;
+
+  const float *const coefficients = self->coefficients_;
+  const float *const delay_line = &self->delay_line_[index];
+  float sum = 0.0F;
+  for (int i = 0; i < num_taps; i++) {
+    sum += coefficients[i] * delay_line[i];
+  }
+
+  return sum;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __FirFilter_update(Filter *const _self, float data,
+                             float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  FirFilter *const self = (FirFilter *)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  self->filtered_data_ = __FirFilter_process(self, data);
+  if (filtered_data != NULL) {
+    *filtered_data = self->filtered_data_;
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __FirFilter_get_filtered_data(Filter *const _self,
+                                        float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  FirFilter *const self = (FirFilter *)_self;
+  *filtered_data = self->filtered_data_;
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __FirFilter_update_block(Filter *const _self, const float *data,
+                                   float *const filtered_data, int length,
+                                   int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  FirFilter *const self = (FirFilter *)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+  if (length == 0) {
+    return ModuleOK;
+  }
+
+  for (int i = 0; i < length; i++) {
+    filtered_data[i] = __FirFilter_process(self, data[i]);
+  }
+
+  self->filtered_data_ = filtered_data[length - 1];
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void FirFilter_ctor(FirFilter *const self, const float *const coefficients,
+                    float *const delay_line, const int num_taps,
+                    Filter *const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(coefficients));
+  module_assert(IS_NOT_NULL(delay_line));
+  module_assert(IS_POSTIVE(num_taps));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter *)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __FirFilter_update,
+      .get_filtered_data = __FirFilter_get_filtered_data,
+      .update_block = __FirFilter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->coefficients_ = coefficients;
+  self->delay_line_ = delay_line;
+  self->num_taps_ = num_taps;
+  self->index_ = 0;
+  self->filtered_data_ = 0.0F;
+  for (int i = 0; i < 2 * num_taps; i++) {
+    delay_line[i] = 0.0F;
+  }
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet BiquadFilter_update(BiquadFilter *const self,
+                                     const float data,
+                                     float *const filtered_data) {
+  return self->super_.vptr_->update((Filter *)self, data, filtered_data);
+}
+
+inline ModuleRet BiquadFilter_get_filtered_data(BiquadFilter *const self,
+                                                float *const filtered_data) {
+  return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
+}
+
+inline ModuleRet BiquadFilter_update_block(BiquadFilter *const self,
+                                           const float *const data,
+                                           float *const filtered_data,
+                                           const int length,
+                                           int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for passing new data through the sections in turn.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @return float The filtered data.
+ */
+static float __BiquadFilter_process(BiquadFilter *const self, float data) {
+  const float *coefficients = self->coefficients_;
+  float *state = self->state_;
+  for (int i = 0; i < self->num_stages_; i++) {
+    const float y = coefficients[0] * data + state[0];
+    state[0] = coefficients[1] * data - coefficients[3] * y + state[1];
+    state[1] = coefficients[2] * data - coefficients[4] * y;
+    data = y;
+
+    coefficients += 5;
+    state += 2;
+  }
+
+  return data;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __BiquadFilter_update(Filter *const _self, float data,
+                                float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  BiquadFilter *const self = (BiquadFilter *)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  self->filtered_data_ = __BiquadFilter_process(self, data);
+  if (filtered_data != NULL) {
+    *filtered_data = self->filtered_data_;
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __BiquadFilter_get_filtered_data(Filter *const _self,
+                                           float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  BiquadFilter *const self = (BiquadFilter *)_self;
+  *filtered_data = self->filtered_data_;
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __BiquadFilter_update_block(Filter *const _self, const float *data,
+                                      float *const filtered_data, int length,
+                                      int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  BiquadFilter *const self = (BiquadFilter *)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+  if (length == 0) {
+    return ModuleOK;
+  }
+
+  // pass the whole block through two sections at a time, keeping
+  // coefficients and state in local variables, so that the recurrences of the
+  // two sections overlap instead of stalling on each other
+  const float *coefficients = self->coefficients_;
+  float *state = self->state_;
+  int i = 0;
+  for (; i + 1 < self->num_stages_; i += 2) {
+    const float b00 = coefficients[0];
+    const float b01 = coefficients[1];
+    const float b02 = coefficients[2];
+    const float a01 = coefficients[3];
+    const float a02 = coefficients[4];
+    const float b10 = coefficients[5];
+    const float b11 = coefficients[6];
+    const float b12 = coefficients[7];
+    const float a11 = coefficients[8];
+    const float a12 = coefficients[9];
+    float s01 = state[0];
+    float s02 = state[1];
+    float s11 = state[2];
+    float s12 = state[3];
+
+    for (int j = 0; j < length; j++) {
+      const float x = data[j];
+      const float y0 = b00 * x + s01;
+      s01 = b01 * x - a01 * y0 + s02;
+      s02 = b02 * x - a02 * y0;
+      const float y1 = b10 * y0 + s11;
+      s11 = b11 * y0 - a11 * y1 + s12;
+      s12 = b12 * y0 - a12 * y1;
+      filtered_data[j] = y1;
+    }
+
+    state[0] = s01;
+    state[1] = s02;
+    state[2] = s11;
+    state[3] = s12;
+    data = filtered_data;
+    coefficients += 10;
+    state += 4;
+  }
+
+  // remaining section
+  if (i < self->num_stages_) {
+    const float b0 = coefficients[0];
+    const float b1 = coefficients[1];
+    const float b2 = coefficients[2];
+    const float a1 = coefficients[3];
+    const float a2 = coefficients[4];
+    float s1 = state[0];
+    float s2 = state[1];
+
+    for (int j = 0; j < length; j++) {
+      const float x = data[j];
+      const float y = b0 * x + s1;
+      s1 = b1 * x - a1 * y + s2;
+      s2 = b2 * x - a2 * y;
+      filtered_data[j] = y;
+    }
+
+    state[0] = s1;
+    state[1] = s2;
+  }
+
+  self->filtered_data_ = filtered_data[length - 1];
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void BiquadFilter_ctor(BiquadFilter *const self,
+                       const float *const coefficients, float *const state,
+                       const int num_stages, Filter *const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(coefficients));
+  module_assert(IS_NOT_NULL(state));
+  module_assert(IS_POSTIVE(num_stages));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter *)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __BiquadFilter_update,
+      .get_filtered_data = __BiquadFilter_get_filtered_data,
+      .update_block = __BiquadFilter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->coefficients_ = coefficients;
+  self->state_ = state;
+  self->num_stages_ = num_stages;
+  self->filtered_data_ = 0.0F;
+  for (int i = 0; i < 2 * num_stages; i++) {
+    state[i] = 0.0F;
+  }
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet MedianFilter_update(MedianFilter *const self,
+                                     const float data,
+                                     float *const filtered_data) {
+  return self->super_.vptr_->update((Filter *)self, data, filtered_data);
+}
+
+inline ModuleRet MedianFilter_get_filtered_data(MedianFilter *const self,
+                                                float *const filtered_data) {
+  return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
+}
+
+inline ModuleRet MedianFilter_update_block(MedianFilter *const self,
+                                           const float *const data,
+                                           float *const filtered_data,
+                                           const int length,
+                                           int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for comparing the data at two positions of the heap, and
+ * swapping them if the data at i is less than the data at j.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] i Position in the heap.
+ * @param[in] j Position in the heap.
+ * @return bool True if swapped.
+ */
+static bool __MedianFilter_compare_exchange(MedianFilter *const self,
+                                            const int i, const int j) {
+  uint8_t *const heap = self->heap_;
+  if (!(self->buffer_[heap[i]] < self->buffer_[heap[j]])) {
+    return false;
+  }
+
+  const uint8_t index = heap[i];
+  heap[i] = heap[j];
+  heap[j] = index;
+  self->position_[heap[i]] = (int8_t)i;
+  self->position_[heap[j]] = (int8_t)j;
+  return true;
+}
+
+/**
+ * @brief Function for restoring the min heap below position i.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] i Position in the min heap.
+ * @return None.
+ */
+static void __MedianFilter_min_sort_down(MedianFilter *const self, int i) {
+  const int min_size = (self->size_ - 1) / 2;
+  for (i *= 2; i <= min_size; i *= 2) {
+    if (i < min_size &&
+        self->buffer_[self->heap_[i + 1]] < self->buffer_[self->heap_[i]]) {
+      i++;
+    }
+    if (!__MedianFilter_compare_exchange(self, i, i / 2)) {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Function for restoring the max heap below position i.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] i Position in the max heap, which is negative.
+ * @return None.
+ */
+static void __MedianFilter_max_sort_down(MedianFilter *const self, int i) {
+  const int max_size = self->size_ / 2;
+  for (i *= 2; i >= -max_size; i *= 2) {
+    if (i > -max_size &&
+        self->buffer_[self->heap_[i]] < self->buffer_[self->heap_[i - 1]]) {
+      i--;
+    }
+    if (!__MedianFilter_compare_exchange(self, i / 2, i)) {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Function for restoring the min heap above position i, including the
+ * median.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] i Position in the min heap.
+ * @return bool True if the data reached the median.
+ */
+static bool __MedianFilter_min_sort_up(MedianFilter *const self, int i) {
+  while (i > 0 && __MedianFilter_compare_exchange(self, i, i / 2)) {
+    i /= 2;
+  }
+  return i == 0;
+}
+
+/**
+ * @brief Function for restoring the max heap above position i, including the
+ * median.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] i Position in the max heap, which is negative.
+ * @return bool True if the data reached the median.
+ */
+static bool __MedianFilter_max_sort_up(MedianFilter *const self, int i) {
+  while (i < 0 && __MedianFilter_compare_exchange(self, i / 2, i)) {
+    i /= 2;
+  }
+  return i == 0;
+}
+
+/**
+ * @brief Function for replacing the oldest data in the window with new data
+ * and restoring the heaps.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @return None.
+ */
+static void __MedianFilter_insert(MedianFilter *const self, const float data) {
+  const bool is_new = self->size_ < self->window_size_;
+  const int position = self->position_[self->index_];
+  const float old_data = self->buffer_[self->index_];
+  self->buffer_[self->index_] = data;
+  if (++self->index_ == self->window_size_) {
+    self->index_ = 0;
+  }
+  if (is_new) {
+    self->size_++;
+  }
+
+  // the new data moves away from the median if it replaces data closer to the
+  // median, otherwise towards the median, and if it reaches the median, the
+  // median is compared with the root of the other heap
+  if (position > 0) {
+    if (!is_new && old_data < data) {
+      __MedianFilter_min_sort_down(self, position);
+    } else if (__MedianFilter_min_sort_up(self, position) &&
+               __MedianFilter_compare_exchange(self, 0, -1)) {
+      __MedianFilter_max_sort_down(self, -1);
+    }
+  } else if (position < 0) {
+    if (!is_new && data < old_data) {
+      __MedianFilter_max_sort_down(self, position);
+    } else if (__MedianFilter_max_sort_up(self, position) &&
+               (self->size_ - 1) / 2 > 0 &&
+               __MedianFilter_compare_exchange(self, 1, 0)) {
+      __MedianFilter_min_sort_down(self, 1);
+    }
+  } else {
+    if (self->size_ / 2 > 0 && __MedianFilter_compare_exchange(self, 0, -1)) {
+      __MedianFilter_max_sort_down(self, -1);
+    } else if ((self->size_ - 1) / 2 > 0 &&
+               __MedianFilter_compare_exchange(self, 1, 0)) {
+      __MedianFilter_min_sort_down(self, 1);
+    }
+  }
+}
+
+/**
+ * @brief Function for getting the median of the window.
+ *
+ * @param[in] self The instance of the class.
+ * @return float The median.
+ */
+static float __MedianFilter_median(const MedianFilter *const self) {
+  const float median = self->buffer_[self->heap_[0]];
+  if (self->size_ % 2 == 0) {
+    return (median + self->buffer_[self->heap_[-1]]) / 2.0F;
+  }
+  return median;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __MedianFilter_update(Filter *const _self, float data,
+                                float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  MedianFilter *const self = (MedianFilter *)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  __MedianFilter_insert(self, data);
+
+  if (self->size_ == self->window_size_) {
+    if (filtered_data != NULL) {
+      *filtered_data = __MedianFilter_median(self);
+    }
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+// from Filter base class
+ModuleRet __MedianFilter_get_filtered_data(Filter *const _self,
+                                           float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  MedianFilter *const self = (MedianFilter *)_self;
+  if (self->size_ == self->window_size_) {
+    *filtered_data = __MedianFilter_median(self);
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+// from Filter base class
+ModuleRet __MedianFilter_update_block(Filter *const _self, const float *data,
+                                      float *const filtered_data, int length,
+                                      int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  MedianFilter *const self = (MedianFilter *)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  int count = 0;
+  for (int i = 0; i < length; i++) {
+    __MedianFilter_insert(self, data[i]);
+
+    // filtered data never overtakes data, hence the buffers can be the same
+    if (self->size_ == self->window_size_) {
+      filtered_data[count++] = __MedianFilter_median(self);
+    }
+  }
+
+  *filtered_length = count;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void MedianFilter_ctor(MedianFilter *const self, float *const filter_buffer,
+                       uint8_t *const heap_buffer, const int window_size,
+                       Filter *const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filter_buffer));
+  module_assert(IS_NOT_NULL(heap_buffer));
+  module_assert(IS_POSTIVE(window_size));
+  module_assert(IS_LESS_OR_EQUAL(window_size, MEDIAN_FILTER_MAX_WINDOW_SIZE));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter *)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __MedianFilter_update,
+      .get_filtered_data = __MedianFilter_get_filtered_data,
+      .update_block = __MedianFilter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->buffer_ = filter_buffer;
+  self->position_ = (int8_t *)heap_buffer;
+  self->heap_ = heap_buffer + window_size + window_size / 2;
+  self->window_size_ = window_size;
+  self->size_ = 0;
+  self->index_ = 0;
+
+  // new data fills the heap alternately as median, max heap and min heap
+  for (int i = 0; i < window_size; i++) {
+    const int position = ((i + 1) / 2) * (i % 2 == 1 ? -1 : 1);
+    self->position_[i] = (int8_t)position;
+    self->heap_[position] = (uint8_t)i;
+  }
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet CicDecimator_update(CicDecimator *const self,
+                                     const float data,
+                                     float *const filtered_data) {
+  return self->super_.vptr_->update((Filter *)self, data, filtered_data);
+}
+
+inline ModuleRet CicDecimator_get_filtered_data(CicDecimator *const self,
+                                                float *const filtered_data) {
+  return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
+}
+
+inline ModuleRet CicDecimator_update_block(CicDecimator *const self,
+                                           const float *const data,
+                                           float *const filtered_data,
+                                           const int length,
+                                           int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for rounding data to integer for the integrators.
+ *
+ * @param[in] data The data.
+ * @return uint32_t The rounded data in two's complement.
+ */
+static inline uint32_t __CicDecimator_round(const float data) {
+  return (uint32_t)(int32_t)(data >= 0.0F ? data + 0.5F : data - 0.5F);
+}
+
+/**
+ * @brief Function for differencing the integrated data by the combs at the
+ * output rate, and compensating the result if needed.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The output of the last integrator.
+ * @return bool True if the decimated data is settled.
+ */
+static bool __CicDecimator_decimate(CicDecimator *const self, uint32_t data) {
+  for (int i = 0; i < self->order_; i++) {
+    const uint32_t difference = data - self->comb_[i];
+    self->comb_[i] = data;
+    data = difference;
+  }
+  float decimated_data = (float)(int32_t)data * self->gain_;
+
+  if (self->alpha_ != 0.0F) {
+    const float alpha = self->alpha_;
+    const float compensated_data =
+        (1.0F + 2.0F * alpha) * self->compensation_[0] -
+        alpha * (decimated_data + self->compensation_[1]);
+    self->compensation_[1] = self->compensation_[0];
+    self->compensation_[0] = decimated_data;
+    decimated_data = compensated_data;
+  }
+
+  self->filtered_data_ = decimated_data;
+  if (self->size_ < self->settle_size_) {
+    self->size_++;
+  }
+  return self->size_ == self->settle_size_;
+}
+
+/**
+ * @brief Kernel of CicDecimator_update_block() for the given order.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] order The order, constant in each call site so that the
+ * integrators are kept in registers.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The settled decimated data, can be the same
+ * buffer as data.
+ * @param[in] length The length of data.
+ * @return int The number of settled decimated data.
+ */
+static inline int __CicDecimator_process_block(CicDecimator *const self,
+                                               const int order,
+                                               const float *const data,
+                                               float *const filtered_data,
+                                               const int length) {
+  uint32_t integrator[CIC_DECIMATOR_MAX_ORDER];
+  for (int k = 0; k < order; k++) {
+    integrator[k] = self->integrator_[k];
+  }
+  const int decimation = self->decimation_;
+  int index = self->index_;
+
+  int count = 0;
+  for (int i = 0; i < length; i++) {
+    uint32_t x = __CicDecimator_round(data[i]);
+    for (int k = 0; k < order; k++) {
+      integrator[k] += x;
+      x = integrator[k];
+    }
+
+    // decimated data never overtakes data, hence the buffers can be the same
+    if (++index == decimation) {
+      index = 0;
+      if (__CicDecimator_decimate(self, x)) {
+        filtered_data[count++] = self->filtered_data_;
+      }
+    }
+  }
+
+  for (int k = 0; k < order; k++) {
+    self->integrator_[k] = integrator[k];
+  }
+  self->index_ = index;
+  return count;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __CicDecimator_update(Filter *const _self, float data,
+                                float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  CicDecimator *const self = (CicDecimator *)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  uint32_t x = __CicDecimator_round(data);
+  for (int i = 0; i < self->order_; i++) {
+    self->integrator_[i] += x;
+    x = self->integrator_[i];
+  }
+  if (++self->index_ < self->decimation_) {
+    return ModuleBusy;
+  }
+  self->index_ = 0;
+
+  if (!__CicDecimator_decimate(self, x)) {
+    return ModuleBusy;
+  }
+  if (filtered_data != NULL) {
+    *filtered_data = self->filtered_data_;
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __CicDecimator_get_filtered_data(Filter *const _self,
+                                           float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  CicDecimator *const self = (CicDecimator *)_self;
+  if (self->size_ == self->settle_size_) {
+    *filtered_data = self->filtered_data_;
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+// from Filter base class
+ModuleRet __CicDecimator_update_block(Filter *const _self, const float *data,
+                                      float *const filtered_data, int length,
+                                      int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  CicDecimator *const self = (CicDecimator *)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  // dispatch to the kernel specialized for the order
+  switch (self->order_) {
+    case 1:
+      length = __CicDecimator_process_block(self, 1, data, filtered_data,
+                                            length);
+      break;
+    case 2:
+      length = __CicDecimator_process_block(self, 2, data, filtered_data,
+                                            length);
+      break;
+    case 3:
+      length = __CicDecimator_process_block(self, 3, data, filtered_data,
+                                            length);
+      break;
+    case 4:
+      length = __CicDecimator_process_block(self, 4, data, filtered_data,
+                                            length);
+      break;
+    default:
+      module_assert(0);
+      return ModuleError;
+  }
+
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void CicDecimator_ctor(CicDecimator *const self, const int order,
+                       const int decimation, const bool compensated,
+                       Filter *const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_CIC_DECIMATOR_ORDER(order));
+  module_assert(IS_CIC_DECIMATOR_DECIMATION(decimation));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter *)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __CicDecimator_update,
+      .get_filtered_data = __CicDecimator_get_filtered_data,
+      .update_block = __CicDecimator_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  float dc_gain = 1.0F;
+  for (int i = 0; i < CIC_DECIMATOR_MAX_ORDER; i++) {
+    self->integrator_[i] = 0;
+    self->comb_[i] = 0;
+    if (i < order) {
+      dc_gain *= (float)decimation;
+    }
+  }
+  self->compensation_[0] = 0.0F;
+  self->compensation_[1] = 0.0F;
+  self->alpha_ = compensated ? (float)order / 24.0F : 0.0F;
+  self->gain_ = 1.0F / dc_gain;
+  self->order_ = order;
+  self->decimation_ = decimation;
+  self->index_ = 0;
+  self->size_ = 0;
+  self->settle_size_ = compensated ? order + 2 : order;
+  self->filtered_data_ = 0.0F;
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet SavitzkyGolayFilter_update(SavitzkyGolayFilter *const self,
+                                            const float data,
+                                            float *const filtered_data) {
+  return self->super_.super_.vptr_->update((Filter *)self, data,
+                                           filtered_data);
+}
+
+inline ModuleRet SavitzkyGolayFilter_get_filtered_data(
+    SavitzkyGolayFilter *const self, float *const filtered_data) {
+  return self->super_.super_.vptr_->get_filtered_data((Filter *)self,
+                                                      filtered_data);
+}
+
+inline ModuleRet SavitzkyGolayFilter_update_block(
+    SavitzkyGolayFilter *const self, const float *const data,
+    float *const filtered_data, const int length, int *const filtered_length) {
+  return self->super_.super_.vptr_->update_block(
+      (Filter *)self, data, filtered_data, length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for computing the coefficients of Savitzky-Golay filter,
+ * i.e. the row of the least squares solution giving the derivative at the
+ * evaluated point.
+ *
+ * @param[out] coefficients The coefficients, where coefficients[k] is applied
+ * to the data k samples ago.
+ * @param[in] window_size The number of data to fit.
+ * @param[in] order The order of polynomial.
+ * @param[in] derivative The order of derivative.
+ * @param[in] delay The evaluated point in number of data before the latest one.
+ * @param[in] sample_period The sample period.
+ * @return None.
+ */
+static void __SavitzkyGolayFilter_coefficients(float *const coefficients,
+                                               const int window_size,
+                                               const int order,
+                                               const int derivative,
+                                               const int delay,
+                                               const float sample_period) {
+  const int num_terms = order + 1;
+
+  // time relative to the evaluated point is scaled to about [-1, 1], which
+  // keeps the normal matrix well conditioned for large windows
+  const double scale = window_size > 1 ? (window_size - 1) / 2.0 : 1.0;
+
+  // normal matrix augmented by identity for inverting in place
+  double normal[SAVITZKY_GOLAY_FILTER_MAX_ORDER + 1]
+               [2 * (SAVITZKY_GOLAY_FILTER_MAX_ORDER + 1)] = {{0.0}};
+  for (int k = 0; k < window_size; k++) {
+    const double time = (delay - k) / scale;
+    double power = 1.0;
+    double powers[2 * SAVITZKY_GOLAY_FILTER_MAX_ORDER + 1];
+    for (int i = 0; i < 2 * num_terms - 1; i++) {
+      powers[i] = power;
+      power *= time;
+    }
+    for (int i = 0; i < num_terms; i++) {
+      for (int j = 0; j < num_terms; j++) {
+        normal[i][j] += powers[i + j];
+      }
+    }
+  }
+  for (int i = 0; i < num_terms; i++) {
+    normal[i][num_terms + i] = 1.0;
+  }
+
+  // gauss-jordan elimination needs no pivoting as the matrix is positive
+  // definite
+  for (int i = 0; i < num_terms; i++) {
+    const double pivot = normal[i][i];
+    for (int j = 0; j < 2 * num_terms; j++) {
+      normal[i][j] /= pivot;
+    }
+    for (int r = 0; r < num_terms; r++) {
+      if (r == i) {
+        continue;
+      }
+      const double factor = normal[r][i];
+      for (int j = 0; j < 2 * num_terms; j++) {
+        normal[r][j] -= factor * normal[i][j];
+      }
+    }
+  }
+
+  // derivative of the fitted polynomial at time 0, scaled back to real time
+  double factor = 1.0;
+  for (int i = 1; i <= derivative; i++) {
+    factor *= i / (scale * sample_period);
+  }
+  const double *const inverse = &normal[derivative][num_terms];
+  for (int k = 0; k < window_size; k++) {
+    const double time = (delay - k) / scale;
+    double power = 1.0;
+    double sum = 0.0;
+    for (int j = 0; j < num_terms; j++) {
+      sum += inverse[j] * power;
+      power *= time;
+    }
+    coefficients[k] = (float)(factor * sum);
+  }
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __SavitzkyGolayFilter_update(Filter *const _self, float data,
+                                       float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  SavitzkyGolayFilter *const self = (SavitzkyGolayFilter *)_self;
+  FirFilter *const fir_filter = &self->super_;
+  // process chained filter first
+  if (fir_filter->super_.chained_filter_ != NULL) {
+    ModuleRet ret =
+        Filter_update(fir_filter->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  fir_filter->filtered_data_ = __FirFilter_process(fir_filter, data);
+  if (self->size_ < fir_filter->num_taps_) {
+    self->size_++;
+  }
+
+  if (self->size_ == fir_filter->num_taps_) {
+    if (filtered_data != NULL) {
+      *filtered_data = fir_filter->filtered_data_;
+    }
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+// from Filter base class
+ModuleRet __SavitzkyGolayFilter_get_filtered_data(Filter *const _self,
+                                                  float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  SavitzkyGolayFilter *const self = (SavitzkyGolayFilter *)_self;
+  if (self->size_ == self->super_.num_taps_) {
+    *filtered_data = self->super_.filtered_data_;
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+// from Filter base class
+ModuleRet __SavitzkyGolayFilter_update_block(Filter *const _self,
+                                             const float *data,
+                                             float *const filtered_data,
+                                             int length,
+                                             int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  SavitzkyGolayFilter *const self = (SavitzkyGolayFilter *)_self;
+  FirFilter *const fir_filter = &self->super_;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  // fill the window without computing the discarded outputs
+  const int num_taps = fir_filter->num_taps_;
+  int i = 0;
+  for (; i < length && self->size_ < num_taps - 1; i++) {
+    const int index =
+        fir_filter->index_ == 0 ? num_taps - 1 : fir_filter->index_ - 1;
+    fir_filter->index_ = index;
+    fir_filter->delay_line_[index] = data[i];
+    fir_filter->delay_line_[index + num_taps] = data[i];
+    self->size_++;
+  }
+
+  // filtered data never overtakes data, hence the buffers can be the same
+  int count = 0;
+  for (; i < length; i++) {
+    filtered_data[count++] = __FirFilter_process(fir_filter, data[i]);
+  }
+
+  if (count > 0) {
+    self->size_ = num_taps;
+    fir_filter->filtered_data_ = filtered_data[count - 1];
+  }
+  *filtered_length = count;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void SavitzkyGolayFilter_ctor(SavitzkyGolayFilter *const self,
+                              float *const coefficient_buffer,
+                              float *const delay_line, const int window_size,
+                              const int order, const int derivative,
+                              const int delay, const float sample_period,
+                              Filter *const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(coefficient_buffer));
+  module_assert(IS_SAVITZKY_GOLAY_FILTER_ORDER(order));
+  module_assert(IS_GREATER(window_size, order));
+  module_assert(IS_NOT_NEGATIVE(derivative));
+  module_assert(IS_LESS_OR_EQUAL(derivative, order));
+  module_assert(IS_NOT_NEGATIVE(delay));
+  module_assert(IS_LESS(delay, window_size));
+  module_assert(IS_POSTIVE(sample_period));
+
+  __SavitzkyGolayFilter_coefficients(coefficient_buffer, window_size, order,
+                                     derivative, delay, sample_period);
+
+  // construct inherited class and redirect virtual function
+  FirFilter_ctor((FirFilter *)self, coefficient_buffer, delay_line,
+                 window_size, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __SavitzkyGolayFilter_update,
+      .get_filtered_data = __SavitzkyGolayFilter_get_filtered_data,
+      .update_block = __SavitzkyGolayFilter_update_block,
+  };
+  self->super_.super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->size_ = 0;
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet SlewRateLimiter_update(SlewRateLimiter *const self,
+                                        const float data,
+                                        float *const filtered_data) {
+  return self->super_.vptr_->update((Filter *)self, data, filtered_data);
+}
+
+inline ModuleRet SlewRateLimiter_get_filtered_data(SlewRateLimiter *const self,
+                                                   float *const filtered_data) {
+  return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
+}
+
+inline ModuleRet SlewRateLimiter_update_block(SlewRateLimiter *const self,
+                                              const float *const data,
+                                              float *const filtered_data,
+                                              const int length,
+                                              int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for moving the output toward data by at most max_step.
+ *
+ * @param[in] output The last output.
+ * @param[in] data The data.
+ * @param[in] max_step The maximum change of output.
+ * @return float The new output.
+ */
+static inline float __SlewRateLimiter_step(const float output,
+                                           const float data,
+                                           const float max_step) {
+  const float step = data - output;
+  if (step > max_step) {
+    return output + max_step;
+  }
+  if (step < -max_step) {
+    return output - max_step;
+  }
+  return data;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __SlewRateLimiter_update(Filter *const _self, float data,
+                                   float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  SlewRateLimiter *const self = (SlewRateLimiter *)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  self->filtered_data_ =
+      __SlewRateLimiter_step(self->filtered_data_, data, self->max_step_);
+  if (filtered_data != NULL) {
+    *filtered_data = self->filtered_data_;
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __SlewRateLimiter_get_filtered_data(Filter *const _self,
+                                              float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  SlewRateLimiter *const self = (SlewRateLimiter *)_self;
+  *filtered_data = self->filtered_data_;
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __SlewRateLimiter_update_block(Filter *const _self,
+                                         const float *data,
+                                         float *const filtered_data,
+                                         int length,
+                                         int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  SlewRateLimiter *const self = (SlewRateLimiter *)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  // keep the output in a local variable for the whole block
+  const float max_step = self->max_step_;
+  float output = self->filtered_data_;
+  for (int i = 0; i < length; i++) {
+    output = __SlewRateLimiter_step(output, data[i], max_step);
+    filtered_data[i] = output;
+  }
+
+  self->filtered_data_ = output;
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void SlewRateLimiter_ctor(SlewRateLimiter *const self, const float max_step,
+                          const float initial_data,
+                          Filter *const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(max_step));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter *)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __SlewRateLimiter_update,
+      .get_filtered_data = __SlewRateLimiter_get_filtered_data,
+      .update_block = __SlewRateLimiter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->max_step_ = max_step;
+  self->filtered_data_ = initial_data;
+}
+
+/* member function -----------------------------------------------------------*/
+void SlewRateLimiter_set_max_step(SlewRateLimiter *const self,
+                                  const float max_step) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(max_step));
+
+  self->max_step_ = max_step;
+}
+
+void SlewRateLimiter_reset(SlewRateLimiter *const self, const float data) {
+  module_assert(IS_NOT_NULL(self));
+
+  self->filtered_data_ = data;
+}
+
+/* type ----------------------------------------------------------------------*/
+/// @brief Type of stage of FilterPipeline for updating it directly.
+typedef enum filter_pipeline_stage_type {
+  FilterPipelineStageVirtual = 0,
+  FilterPipelineStageMovingAverage,
+  FilterPipelineStageMovingAverageNormalize,
+  FilterPipelineStageNormalize,
+  FilterPipelineStageKalmanFilter1D,
+  FilterPipelineStageFir,
+  FilterPipelineStageBiquad,
+  FilterPipelineStageMedian,
+} FilterPipelineStageType;
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet FilterPipeline_update(FilterPipeline *const self,
+                                       const float data,
+                                       float *const filtered_data) {
+  return self->super_.vptr_->update((Filter *)self, data, filtered_data);
+}
+
+inline ModuleRet FilterPipeline_get_filtered_data(FilterPipeline *const self,
+                                                  float *const filtered_data) {
+  return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
+}
+
+inline ModuleRet FilterPipeline_update_block(FilterPipeline *const self,
+                                             const float *const data,
+                                             float *const filtered_data,
+                                             const int length,
+                                             int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for getting the type of a stage for updating it directly.
+ *
+ * @param[in] stage The stage.
+ * @return FilterPipelineStageType The type of the stage.
+ */
+static FilterPipelineStageType __FilterPipeline_stage_type(
+    const Filter *const stage) {
+  // the kernels of the stage do not process its chained filter
+  if (stage->chained_filter_ != NULL) {
+    return FilterPipelineStageVirtual;
+  }
+
+  const struct FilterVtbl *const vptr = stage->vptr_;
+  if (vptr->update == __MovingAverageFilter_update) {
+    return FilterPipelineStageMovingAverage;
+  } else if (vptr->update == __NormalizeFilter_update) {
+    return FilterPipelineStageNormalize;
+  } else if (vptr->update == __KalmanFilter1D_update) {
+    return FilterPipelineStageKalmanFilter1D;
+  } else if (vptr->update == __FirFilter_update) {
+    return FilterPipelineStageFir;
+  } else if (vptr->update == __BiquadFilter_update) {
+    return FilterPipelineStageBiquad;
+  } else if (vptr->update == __MedianFilter_update) {
+    return FilterPipelineStageMedian;
+  }
+  return FilterPipelineStageVirtual;
+}
+
+/**
+ * @brief Function for processing a block by a moving average filter followed
+ * by a normalize filter in a single pass.
+ *
+ * @param[in,out] moving_average_filter The moving average filter.
+ * @param[in,out] normalize_filter The normalize filter.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, can be the same buffer as data.
+ * @param[in] length The length of data.
+ * @return int The number of filtered data.
+ */
+static int __FilterPipeline_moving_average_normalize_block(
+    MovingAverageFilter *const moving_average_filter,
+    NormalizeFilter *const normalize_filter, const float *const data,
+    float *const filtered_data, const int length) {
+  // keep the state of both filters in local variables for the whole block
+  float *const buffer = moving_average_filter->buffer_;
+  const int window_size = moving_average_filter->window_size_;
+  int size = moving_average_filter->size_;
+  int index = moving_average_filter->index_;
+  float sum = moving_average_filter->sum_;
+  float round_sum = moving_average_filter->round_sum_;
+  const bool is_partial = moving_average_filter->is_partial_;
+  float lower_bound = normalize_filter->lower_bound_;
+  float upper_bound = normalize_filter->upper_bound_;
+
+  int count = 0;
+  for (int i = 0; i < length; i++) {
+    const float value = data[i];
+    if (size == window_size) {
+      sum -= buffer[index];
+    } else {
+      size++;
+    }
+    buffer[index] = value;
+    sum += value;
+    round_sum += value;
+
+    if (++index == window_size) {
+      index = 0;
+      sum = round_sum;
+      round_sum = 0.0F;
+    }
+
+    if (size == window_size || is_partial) {
+      const float average = sum / size;
+      if (upper_bound < average) {
+        upper_bound = average;
+      }
+      if (lower_bound > average) {
+        lower_bound = average;
+      }
+      filtered_data[count++] =
+          (average - lower_bound) / (upper_bound - lower_bound);
+    }
+  }
+
+  moving_average_filter->size_ = size;
+  moving_average_filter->index_ = index;
+  moving_average_filter->sum_ = sum;
+  moving_average_filter->round_sum_ = round_sum;
+  normalize_filter->lower_bound_ = lower_bound;
+  normalize_filter->upper_bound_ = upper_bound;
+  if (count > 0) {
+    normalize_filter->filtered_data_ = filtered_data[count - 1];
+  }
+  return count;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __FilterPipeline_update(Filter *const _self, float data,
+                                  float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  FilterPipeline *const self = (FilterPipeline *)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  for (int i = 0; i < self->num_stages_; i++) {
+    Filter *const stage = self->stages_[i];
+    switch ((FilterPipelineStageType)self->stage_types_[i]) {
+      case FilterPipelineStageMovingAverage: {
+        MovingAverageFilter *const filter = (MovingAverageFilter *)stage;
+        if (!__MovingAverageFilter_process(filter, data)) {
+          return ModuleBusy;
+        }
+        data = __MovingAverageFilter_average(filter);
+        break;
+      }
+
+      case FilterPipelineStageMovingAverageNormalize: {
+        MovingAverageFilter *const filter = (MovingAverageFilter *)stage;
+        if (!__MovingAverageFilter_process(filter, data)) {
+          return ModuleBusy;
+        }
+        data = __NormalizeFilter_process((NormalizeFilter *)self->stages_[++i],
+                                         __MovingAverageFilter_average(filter));
+        break;
+      }
+
+      case FilterPipelineStageNormalize:
+        data = __NormalizeFilter_process((NormalizeFilter *)stage, data);
+        break;
+
+      case FilterPipelineStageKalmanFilter1D:
+        data = KalmanFilter1D_update((KalmanFilter1D *)stage, data);
+        break;
+
+      case FilterPipelineStageFir: {
+        FirFilter *const filter = (FirFilter *)stage;
+        data = __FirFilter_process(filter, data);
+        filter->filtered_data_ = data;
+        break;
+      }
+
+      case FilterPipelineStageBiquad: {
+        BiquadFilter *const filter = (BiquadFilter *)stage;
+        data = __BiquadFilter_process(filter, data);
+        filter->filtered_data_ = data;
+        break;
+      }
+
+      case FilterPipelineStageMedian: {
+        MedianFilter *const filter = (MedianFilter *)stage;
+        __MedianFilter_insert(filter, data);
+        if (filter->size_ != filter->window_size_) {
+          return ModuleBusy;
+        }
+        data = __MedianFilter_median(filter);
+        break;
+      }
+
+      default: {
+        ModuleRet ret = Filter_update(stage, data, &data);
+        if (ret != ModuleOK) {
+          return ret;
+        }
+        break;
+      }
+    }
+  }
+
+  self->is_ready_ = true;
+  self->filtered_data_ = data;
+  if (filtered_data != NULL) {
+    *filtered_data = data;
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __FilterPipeline_get_filtered_data(Filter *const _self,
+                                             float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  FilterPipeline *const self = (FilterPipeline *)_self;
+  if (self->is_ready_) {
+    *filtered_data = self->filtered_data_;
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+// from Filter base class
+ModuleRet __FilterPipeline_update_block(Filter *const _self, const float *data,
+                                        float *const filtered_data, int length,
+                                        int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  FilterPipeline *const self = (FilterPipeline *)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret =
+      __Filter_update_chained_block(_self, &data, filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  // each stage processes the output of the previous stage in place
+  for (int i = 0; i < self->num_stages_ && length > 0; i++) {
+    if (self->stage_types_[i] == FilterPipelineStageMovingAverageNormalize) {
+      length = __FilterPipeline_moving_average_normalize_block(
+          (MovingAverageFilter *)self->stages_[i],
+          (NormalizeFilter *)self->stages_[i + 1], data, filtered_data,
+          length);
+      i++;
+    } else {
+      ret = Filter_update_block(self->stages_[i], data, filtered_data, length,
+                                &length);
+      if (ret != ModuleOK) {
+        return ret;
+      }
+    }
+    data = filtered_data;
+  }
+
+  if (length > 0) {
+    self->is_ready_ = true;
+    self->filtered_data_ = filtered_data[length - 1];
+  }
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void FilterPipeline_ctor(FilterPipeline *const self,
+                         Filter *const *const stages, const int num_stages,
+                         const bool fused, Filter *const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(stages));
+  module_assert(IS_POSTIVE(num_stages));
+  module_assert(IS_LESS_OR_EQUAL(num_stages, FILTER_PIPELINE_MAX_NUM_STAGES));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter *)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __FilterPipeline_update,
+      .get_filtered_data = __FilterPipeline_get_filtered_data,
+      .update_block = __FilterPipeline_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  for (int i = 0; i < num_stages; i++) {
+    module_assert(IS_NOT_NULL(stages[i]));
+    self->stages_[i] = stages[i];
+    self->stage_types_[i] = __FilterPipeline_stage_type(stages[i]);
+  }
+  self->num_stages_ = num_stages;
+  self->is_ready_ = false;
+  self->filtered_data_ = 0.0F;
+
+  // fuse moving average filter followed by normalize filter
+  for (int i = 0; fused && i + 1 < num_stages; i++) {
+    if (self->stage_types_[i] == FilterPipelineStageMovingAverage &&
+        self->stage_types_[i + 1] == FilterPipelineStageNormalize) {
+      self->stage_types_[i] = FilterPipelineStageMovingAverageNormalize;
+    }
+  }
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet FilterPublisher_update(FilterPublisher *const self,
+                                        const float data,
+                                        float *const filtered_data) {
+  return self->super_.vptr_->update((Filter *)self, data, filtered_data);
+}
+
+inline ModuleRet FilterPublisher_get_filtered_data(
+    FilterPublisher *const self, float *const filtered_data) {
+  return self->super_.vptr_->get_filtered_data((Filter *)self, filtered_data);
+}
+
+inline ModuleRet FilterPublisher_update_block(FilterPublisher *const self,
+                                              const float *const data,
+                                              float *const filtered_data,
+                                              const int length,
+                                              int *const filtered_length) {
+  return self->super_.vptr_->update_block((Filter *)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for publishing the filtered data with the current tick
+ * count.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] filtered_data The filtered data.
+ * @return None.
+ */
+static void __FilterPublisher_publish(FilterPublisher *const self,
+                                      const float filtered_data) {
+  const struct filter_publication publication = {
+      .filtered_data = filtered_data,
+      .timestamp = xPortIsInsideInterrupt() ? xTaskGetTickCountFromISR()
+                                            : xTaskGetTickCount(),
+  };
+  SeqLock_write(&self->seq_lock_, &publication);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __FilterPublisher_update(Filter *const _self, float data,
+                                   float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  FilterPublisher *const self = (FilterPublisher *)_self;
+  ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  __FilterPublisher_publish(self, data);
+  if (filtered_data != NULL) {
+    *filtered_data = data;
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __FilterPublisher_get_filtered_data(Filter *const _self,
+                                              float *const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  FilterPublisher *const self = (FilterPublisher *)_self;
+  struct filter_publication publication;
+  if (SeqLock_read(&self->seq_lock_, &publication) == 0) {
+    return ModuleBusy;
+  }
+
+  *filtered_data = publication.filtered_data;
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __FilterPublisher_update_block(Filter *const _self,
+                                         const float *const data,
+                                         float *const filtered_data,
+                                         const int length,
+                                         int *const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  FilterPublisher *const self = (FilterPublisher *)_self;
+  ModuleRet ret = Filter_update_block(self->super_.chained_filter_, data,
+                                      filtered_data, length, filtered_length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  // readers only need the latest data, hence publish once per block
+  if (*filtered_length > 0) {
+    __FilterPublisher_publish(self, filtered_data[*filtered_length - 1]);
+  }
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void FilterPublisher_ctor(FilterPublisher *const self, Filter *const filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filter));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter *)self, filter);
+  static struct FilterVtbl vtbl = {
+      .update = __FilterPublisher_update,
+      .get_filtered_data = __FilterPublisher_get_filtered_data,
+      .update_block = __FilterPublisher_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  SeqLock_ctor(&self->seq_lock_, self->seq_lock_buffer_,
+               sizeof(struct filter_publication));
+}
+
+/* member function -----------------------------------------------------------*/
+ModuleRet FilterPublisher_get_snapshot(const FilterPublisher *const self,
+                                       struct filter_snapshot *const snapshot) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(snapshot));
+
+  struct filter_publication publication;
+  const uint32_t sequence = SeqLock_read(&self->seq_lock_, &publication);
+  if (sequence == 0) {
+    return ModuleBusy;
+  }
+
+  snapshot->filtered_data = publication.filtered_data;
+  snapshot->timestamp = publication.timestamp;
+  snapshot->publish_count = sequence >> 1;
+  return ModuleOK;
+}
+
+uint32_t FilterPublisher_get_publish_count(const FilterPublisher *const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return SeqLock_get_sequence(&self->seq_lock_) >> 1;
+}
@@ -0,0 +1,373 @@
+#include "stm32_module/filter_bank.h"
+
+// glibc include
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/module_common.h"
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet FilterBank_update(FilterBank* const self,
+                                   const float* const data,
+                                   float* const filtered_data) {
+  return self->vptr_->update(self, data, filtered_data);
+}
+
+/* virtual function definition -----------------------------------------------*/
+/**
+ * @brief Pure virtual function for FilterBank_update().
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data of each channel.
+ * @param[out] filtered_data The filtered data of each channel.
+ * @return ModuleRet Error code.
+ */
+ModuleRet __FilterBank_update(FilterBank* const self, const float* const data,
+                              float* const filtered_data) {
+  (void)self;
+  (void)data;
+  (void)filtered_data;
+
+  module_assert(0);
+  return ModuleError;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void FilterBank_ctor(FilterBank* const self, const int num_channels,
+                     float* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_POSTIVE(num_channels));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  static struct FilterBankVtbl vtbl = {
+      .update = __FilterBank_update,
+  };
+  self->vptr_ = &vtbl;
+
+  self->num_channels_ = num_channels;
+  self->filtered_data_ = filtered_data;
+  for (int i = 0; i < num_channels; i++) {
+    filtered_data[i] = 0.0F;
+  }
+}
+
+/* member function -----------------------------------------------------------*/
+float FilterBank_get_filtered_data(FilterBank* const self, const int channel) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(channel));
+  module_assert(IS_LESS(channel, self->num_channels_));
+
+  return self->filtered_data_[channel];
+}
+
+/**
+ * @brief Function for copying the filtered data of all channels to user.
+ *
+ * @param[in] self The instance of the class.
+ * @param[out] filtered_data The filtered data of each channel, NULL if no need
+ * to get filtered data.
+ * @return None.
+ */
+static void __FilterBank_copy_filtered_data(const FilterBank* const self,
+                                            float* const filtered_data) {
+  if (filtered_data == NULL) {
+    return;
+  }
+  for (int i = 0; i < self->num_channels_; i++) {
+    filtered_data[i] = self->filtered_data_[i];
+  }
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet MovingAverageFilterBank_update(
+    MovingAverageFilterBank* const self, const float* const data,
+    float* const filtered_data) {
+  return self->super_.vptr_->update((FilterBank*)self, data, filtered_data);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from FilterBank base class
+ModuleRet __MovingAverageFilterBank_update(FilterBank* const _self,
+                                           const float* const data,
+                                           float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+
+  MovingAverageFilterBank* const self = (MovingAverageFilterBank*)_self;
+  const int num_channels = self->super_.num_channels_;
+  float* const row = &self->buffer_[self->index_ * num_channels];
+  float* const sum = self->sum_;
+  float* const round_sum = self->round_sum_;
+
+  // replace the oldest row in the ring buffer
+  if (self->size_ == self->window_size_) {
+    for (int i = 0; i < num_channels; i++) {
+      sum[i] = sum[i] - row[i] + data[i];
+      round_sum[i] += data[i];
+      row[i] = data[i];
+    }
+  } else {
+    self->size_++;
+    for (int i = 0; i < num_channels; i++) {
+      sum[i] += data[i];
+      round_sum[i] += data[i];
+      row[i] = data[i];
+    }
+  }
+
+  // the sum of a whole round is exact up to rounding of the round itself
+  if (++self->index_ == self->window_size_) {
+    self->index_ = 0;
+    for (int i = 0; i < num_channels; i++) {
+      sum[i] = round_sum[i];
+      round_sum[i] = 0.0F;
+    }
+  }
+
+  if (self->size_ == self->window_size_) {
+    const float window_size = (float)self->window_size_;
+    float* const output = self->super_.filtered_data_;
+    for (int i = 0; i < num_channels; i++) {
+      output[i] = sum[i] / window_size;
+    }
+    __FilterBank_copy_filtered_data(_self, filtered_data);
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void MovingAverageFilterBank_ctor(MovingAverageFilterBank* const self,
+                                  float* const buffer, const int num_channels,
+                                  const int window_size) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(buffer));
+  module_assert(IS_POSTIVE(num_channels));
+  module_assert(IS_POSTIVE(window_size));
+
+  // construct inherited class and redirect virtual function
+  FilterBank_ctor((FilterBank*)self, num_channels,
+                  &buffer[(window_size + 2) * num_channels]);
+  static struct FilterBankVtbl vtbl = {
+      .update = __MovingAverageFilterBank_update,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->buffer_ = buffer;
+  self->sum_ = &buffer[window_size * num_channels];
+  self->round_sum_ = &buffer[(window_size + 1) * num_channels];
+  self->window_size_ = window_size;
+  self->size_ = 0;
+  self->index_ = 0;
+  for (int i = 0; i < num_channels; i++) {
+    self->sum_[i] = 0.0F;
+    self->round_sum_[i] = 0.0F;
+  }
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet BiquadFilterBank_update(BiquadFilterBank* const self,
+                                         const float* const data,
+                                         float* const filtered_data) {
+  return self->super_.vptr_->update((FilterBank*)self, data, filtered_data);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from FilterBank base class
+ModuleRet __BiquadFilterBank_update(FilterBank* const _self,
+                                    const float* const data,
+                                    float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+
+  BiquadFilterBank* const self = (BiquadFilterBank*)_self;
+  const int num_channels = self->super_.num_channels_;
+  const float* const b0 = self->coefficients_;
+  const float* const b1 = &b0[num_channels];
+  const float* const b2 = &b1[num_channels];
+  const float* const a1 = &b2[num_channels];
+  const float* const a2 = &a1[num_channels];
+  float* const s1 = self->state_;
+  float* const s2 = &s1[num_channels];
+  float* const output = self->super_.filtered_data_;
+
+  for (int i = 0; i < num_channels; i++) {
+    const float x = data[i];
+    const float y = b0[i] * x + s1[i];
+    s1[i] = b1[i] * x - a1[i] * y + s2[i];
+    s2[i] = b2[i] * x - a2[i] * y;
+    output[i] = y;
+  }
+
+  __FilterBank_copy_filtered_data(_self, filtered_data);
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void BiquadFilterBank_ctor(BiquadFilterBank* const self, float* const buffer,
+                           const int num_channels,
+                           const float* const coefficients) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(buffer));
+  module_assert(IS_POSTIVE(num_channels));
+  module_assert(IS_NOT_NULL(coefficients));
+
+  // construct inherited class and redirect virtual function
+  FilterBank_ctor((FilterBank*)self, num_channels, &buffer[7 * num_channels]);
+  static struct FilterBankVtbl vtbl = {
+      .update = __BiquadFilterBank_update,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->coefficients_ = buffer;
+  self->state_ = &buffer[5 * num_channels];
+  for (int i = 0; i < num_channels; i++) {
+    BiquadFilterBank_set_coefficients(self, i, coefficients);
+    self->state_[i] = 0.0F;
+    self->state_[num_channels + i] = 0.0F;
+  }
+}
+
+/* member function -----------------------------------------------------------*/
+void BiquadFilterBank_set_coefficients(BiquadFilterBank* const self,
+                                       const int channel,
+                                       const float* const coefficients) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(channel));
+  module_assert(IS_LESS(channel, self->super_.num_channels_));
+  module_assert(IS_NOT_NULL(coefficients));
+
+  for (int i = 0; i < 5; i++) {
+    self->coefficients_[i * self->super_.num_channels_ + channel] =
+        coefficients[i];
+  }
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet KalmanFilter1DBank_update(KalmanFilter1DBank* const self,
+                                           const float* const data,
+                                           float* const filtered_data) {
+  return self->super_.vptr_->update((FilterBank*)self, data, filtered_data);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from FilterBank base class
+ModuleRet __KalmanFilter1DBank_update(FilterBank* const _self,
+                                      const float* const data,
+                                      float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+
+  KalmanFilter1DBank* const self = (KalmanFilter1DBank*)_self;
+  const int num_channels = self->super_.num_channels_;
+  float* const x = self->super_.filtered_data_;
+  float* const K = self->K_;
+
+  // fixed gains without division in steady state
+  if (self->is_steady_state_) {
+    for (int i = 0; i < num_channels; i++) {
+      x[i] = x[i] + K[i] * (data[i] - x[i]);
+    }
+    __FilterBank_copy_filtered_data(_self, filtered_data);
+    return ModuleOK;
+  }
+
+  float* const P = self->P_;
+  const float* const Q = self->Q_;
+  const float* const R = self->R_;
+  const float tolerance = self->tolerance_;
+  bool is_converged = true;
+
+  for (int i = 0; i < num_channels; i++) {
+    // predict step
+    const float x_pred = x[i];
+    const float P_pred = P[i] + Q[i];
+
+    // update step
+    const float K_next = P_pred / (P_pred + R[i]);
+    x[i] = x_pred + K_next * (data[i] - x_pred);
+    P[i] = (1 - K_next) * P_pred;
+
+    const float change = K_next - K[i];
+    is_converged &=
+        change <= tolerance * K_next && -change <= tolerance * K_next;
+    K[i] = K_next;
+  }
+
+  if (self->steady_state_enabled_ && is_converged) {
+    self->is_steady_state_ = true;
+  }
+
+  __FilterBank_copy_filtered_data(_self, filtered_data);
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void KalmanFilter1DBank_ctor(KalmanFilter1DBank* const self,
+                             float* const buffer, const int num_channels,
+                             const float Q, const float R, const float x0,
+                             const float P0) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(buffer));
+  module_assert(IS_POSTIVE(num_channels));
+
+  // construct inherited class and redirect virtual function
+  FilterBank_ctor((FilterBank*)self, num_channels, buffer);
+  static struct FilterBankVtbl vtbl = {
+      .update = __KalmanFilter1DBank_update,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->P_ = &buffer[num_channels];
+  self->Q_ = &buffer[2 * num_channels];
+  self->R_ = &buffer[3 * num_channels];
+  self->K_ = &buffer[4 * num_channels];
+  self->tolerance_ = 0.0F;
+  self->steady_state_enabled_ = false;
+  self->is_steady_state_ = false;
+  for (int i = 0; i < num_channels; i++) {
+    self->super_.filtered_data_[i] = x0;
+    self->P_[i] = P0;
+    self->Q_[i] = Q;
+    self->R_[i] = R;
+    self->K_[i] = 0.0F;
+  }
+}
+
+/* member function -----------------------------------------------------------*/
+void KalmanFilter1DBank_set_noise(KalmanFilter1DBank* const self,
+                                  const int channel, const float Q,
+                                  const float R) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(channel));
+  module_assert(IS_LESS(channel, self->super_.num_channels_));
+
+  self->Q_[channel] = Q;
+  self->R_[channel] = R;
+  self->is_steady_state_ = false;
+}
+
+void KalmanFilter1DBank_enable_steady_state(KalmanFilter1DBank* const self,
+                                            const float tolerance) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(tolerance));
+
+  self->tolerance_ = tolerance;
+  self->steady_state_enabled_ = true;
+}
+
+void KalmanFilter1DBank_disable_steady_state(KalmanFilter1DBank* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  self->steady_state_enabled_ = false;
+  self->is_steady_state_ = false;
+}
+
+bool KalmanFilter1DBank_is_steady_state(KalmanFilter1DBank* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return self->is_steady_state_;
+}
@@ -0,0 +1,1172 @@
+#include "stm32_module/fixed_point_filter.h"
+
+// glibc include
+#include <stdbool.h>
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/filter.h"
+#include "stm32_module/module_common.h"
+
+/* static function prototype -------------------------------------------------*/
+static ModuleRet __MovingAverageFilterQ15_process(
+    MovingAverageFilterQ15* const self, const q15_t data,
+    q15_t* const filtered_data);
+static ModuleRet __MovingAverageFilterQ31_process(
+    MovingAverageFilterQ31* const self, const q31_t data,
+    q31_t* const filtered_data);
+static q15_t __NormalizeFilterQ15_normalize(NormalizeFilterQ15* const self,
+                                            const q15_t data);
+static q31_t __NormalizeFilterQ31_normalize(NormalizeFilterQ31* const self,
+                                            const q31_t data);
+
+/* conversion function -------------------------------------------------------*/
+q15_t Q15_from_float(const float value) {
+  const float scaled = value * 32768.0F;
+  if (scaled >= 32767.0F) {
+    return Q15_MAX;
+  }
+  if (scaled <= -32768.0F) {
+    return Q15_MIN;
+  }
+  return (q15_t)(scaled >= 0.0F ? scaled + 0.5F : scaled - 0.5F);
+}
+
+float Q15_to_float(const q15_t value) {
+  return (float)value * (1.0F / 32768.0F);
+}
+
+q31_t Q31_from_float(const float value) {
+  const float scaled = value * 2147483648.0F;
+  // float has only 24 bits of precision, hence nothing to round beyond 2^24
+  if (scaled >= 2147483648.0F) {
+    return Q31_MAX;
+  }
+  if (scaled <= -2147483648.0F) {
+    return Q31_MIN;
+  }
+  return (q31_t)(scaled >= 0.0F ? scaled + 0.5F : scaled - 0.5F);
+}
+
+float Q31_to_float(const q31_t value) {
+  return (float)value * (1.0F / 2147483648.0F);
+}
+
+void Q15_from_float_block(const float* const src, q15_t* const dst,
+                          const int length) {
+  module_assert(IS_NOT_NULL(src));
+  module_assert(IS_NOT_NULL(dst));
+
+  for (int i = 0; i < length; i++) {
+    dst[i] = Q15_from_float(src[i]);
+  }
+}
+
+void Q15_to_float_block(const q15_t* const src, float* const dst,
+                        const int length) {
+  module_assert(IS_NOT_NULL(src));
+  module_assert(IS_NOT_NULL(dst));
+
+  for (int i = 0; i < length; i++) {
+    dst[i] = Q15_to_float(src[i]);
+  }
+}
+
+void Q31_from_float_block(const float* const src, q31_t* const dst,
+                          const int length) {
+  module_assert(IS_NOT_NULL(src));
+  module_assert(IS_NOT_NULL(dst));
+
+  for (int i = 0; i < length; i++) {
+    dst[i] = Q31_from_float(src[i]);
+  }
+}
+
+void Q31_to_float_block(const q31_t* const src, float* const dst,
+                        const int length) {
+  module_assert(IS_NOT_NULL(src));
+  module_assert(IS_NOT_NULL(dst));
+
+  for (int i = 0; i < length; i++) {
+    dst[i] = Q31_to_float(src[i]);
+  }
+}
+
+/* static function -----------------------------------------------------------*/
+/**
+ * @brief Function for dividing with rounding to nearest.
+ *
+ * @param[in] numerator The numerator.
+ * @param[in] denominator The denominator, must be positive.
+ * @return int32_t The quotient.
+ */
+static int32_t __FixedPointFilter_divide(const int32_t numerator,
+                                         const int32_t denominator) {
+  return (numerator >= 0 ? numerator + denominator / 2
+                         : numerator - denominator / 2) /
+         denominator;
+}
+
+/**
+ * @brief Function for multiplying by a reciprocal in Q31 with rounding to
+ * nearest, which is faster than division on mcu without fast divider.
+ *
+ * @param[in] value The value.
+ * @param[in] reciprocal The reciprocal in Q31, at most 1.
+ * @return int32_t The product.
+ */
+static int32_t __FixedPointFilter_multiply(const int32_t value,
+                                           const uint32_t reciprocal) {
+  return (int32_t)(((int64_t)value * reciprocal + ((int64_t)1 << 30)) >> 31);
+}
+
+/**
+ * @brief Function for dividing 64 bit integer with rounding to nearest.
+ *
+ * @param[in] numerator The numerator.
+ * @param[in] denominator The denominator, must be positive.
+ * @return int64_t The quotient.
+ */
+static int64_t __FixedPointFilter_divide_long(const int64_t numerator,
+                                              const int64_t denominator) {
+  return (numerator >= 0 ? numerator + denominator / 2
+                         : numerator - denominator / 2) /
+         denominator;
+}
+
+/**
+ * @brief Function for processing data by the chained filter in float, if any.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] data The data to be processed, replaced by the filtered data.
+ * @return ModuleRet Error code.
+ */
+static ModuleRet __FilterQ15_update_chained(Filter* const self,
+                                            q15_t* const data) {
+  if (self->chained_filter_ == NULL) {
+    return ModuleOK;
+  }
+
+  float value = Q15_to_float(*data);
+  ModuleRet ret = Filter_update(self->chained_filter_, value, &value);
+  *data = Q15_from_float(value);
+  return ret;
+}
+
+/**
+ * @brief Function for processing data by the chained filter in float, if any.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] data The data to be processed, replaced by the filtered data.
+ * @return ModuleRet Error code.
+ */
+static ModuleRet __FilterQ31_update_chained(Filter* const self,
+                                            q31_t* const data) {
+  if (self->chained_filter_ == NULL) {
+    return ModuleOK;
+  }
+
+  float value = Q31_to_float(*data);
+  ModuleRet ret = Filter_update(self->chained_filter_, value, &value);
+  *data = Q31_from_float(value);
+  return ret;
+}
+
+/**
+ * @brief Function for processing a block of data by the chained filter in
+ * float, if any, chunk by chunk.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] data The data to be added, which is replaced by filtered_data
+ * if there is a chained filter.
+ * @param[out] filtered_data The filtered data of the chained filter.
+ * @param[in,out] length The length of data, which is replaced by the number of
+ * filtered data of the chained filter.
+ * @return ModuleRet Error code.
+ */
+static ModuleRet __FilterQ15_update_chained_block(Filter* const self,
+                                                  const q15_t** const data,
+                                                  q15_t* const filtered_data,
+                                                  int* const length) {
+  if (self->chained_filter_ == NULL) {
+    return ModuleOK;
+  }
+
+  float buffer[FIXED_POINT_FILTER_CHUNK_SIZE];
+  ModuleRet ret = ModuleOK;
+  int count = 0;
+  for (int i = 0; i < *length && ret == ModuleOK;
+       i += FIXED_POINT_FILTER_CHUNK_SIZE) {
+    const int chunk_length = *length - i < FIXED_POINT_FILTER_CHUNK_SIZE
+                                 ? *length - i
+                                 : FIXED_POINT_FILTER_CHUNK_SIZE;
+    Q15_to_float_block(*data + i, buffer, chunk_length);
+
+    // filtered data never overtakes data, hence the buffers can be the same
+    int chunk_filtered_length;
+    ret = Filter_update_block(self->chained_filter_, buffer, buffer,
+                              chunk_length, &chunk_filtered_length);
+    Q15_from_float_block(buffer, filtered_data + count, chunk_filtered_length);
+    count += chunk_filtered_length;
+  }
+
+  *data = filtered_data;
+  *length = count;
+  return ret;
+}
+
+/**
+ * @brief Function for processing a block of data by the chained filter in
+ * float, if any, chunk by chunk.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in,out] data The data to be added, which is replaced by filtered_data
+ * if there is a chained filter.
+ * @param[out] filtered_data The filtered data of the chained filter.
+ * @param[in,out] length The length of data, which is replaced by the number of
+ * filtered data of the chained filter.
+ * @return ModuleRet Error code.
+ */
+static ModuleRet __FilterQ31_update_chained_block(Filter* const self,
+                                                  const q31_t** const data,
+                                                  q31_t* const filtered_data,
+                                                  int* const length) {
+  if (self->chained_filter_ == NULL) {
+    return ModuleOK;
+  }
+
+  float buffer[FIXED_POINT_FILTER_CHUNK_SIZE];
+  ModuleRet ret = ModuleOK;
+  int count = 0;
+  for (int i = 0; i < *length && ret == ModuleOK;
+       i += FIXED_POINT_FILTER_CHUNK_SIZE) {
+    const int chunk_length = *length - i < FIXED_POINT_FILTER_CHUNK_SIZE
+                                 ? *length - i
+                                 : FIXED_POINT_FILTER_CHUNK_SIZE;
+    Q31_to_float_block(*data + i, buffer, chunk_length);
+
+    // filtered data never overtakes data, hence the buffers can be the same
+    int chunk_filtered_length;
+    ret = Filter_update_block(self->chained_filter_, buffer, buffer,
+                              chunk_length, &chunk_filtered_length);
+    Q31_from_float_block(buffer, filtered_data + count, chunk_filtered_length);
+    count += chunk_filtered_length;
+  }
+
+  *data = filtered_data;
+  *length = count;
+  return ret;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __MovingAverageFilterQ15_update(Filter* const _self, float data,
+                                          float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  MovingAverageFilterQ15* const self = (MovingAverageFilterQ15*)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  q15_t value;
+  ModuleRet ret =
+      __MovingAverageFilterQ15_process(self, Q15_from_float(data), &value);
+  if (ret == ModuleOK && filtered_data != NULL) {
+    *filtered_data = Q15_to_float(value);
+  }
+  return ret;
+}
+
+// from Filter base class
+ModuleRet __MovingAverageFilterQ15_get_filtered_data(
+    Filter* const _self, float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  q15_t value;
+  ModuleRet ret = MovingAverageFilterQ15_get_filtered_data(
+      (MovingAverageFilterQ15*)_self, &value);
+  if (ret == ModuleOK) {
+    *filtered_data = Q15_to_float(value);
+  }
+  return ret;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void MovingAverageFilterQ15_ctor(MovingAverageFilterQ15* const self,
+                                 q15_t* const filter_buffer,
+                                 const int window_size,
+                                 Filter* const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filter_buffer));
+  module_assert(IS_POSTIVE(window_size));
+  // the running sum must not overflow
+  module_assert(IS_LESS(window_size, 65536));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter*)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __MovingAverageFilterQ15_update,
+      .get_filtered_data = __MovingAverageFilterQ15_get_filtered_data,
+      .update_block = __Filter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->buffer_ = filter_buffer;
+  self->window_size_ = window_size;
+  self->size_ = 0;
+  self->index_ = 0;
+  self->sum_ = 0;
+  self->reciprocal_ =
+      (uint32_t)((((uint64_t)1 << 31) + window_size / 2) / window_size);
+}
+
+/* member function -----------------------------------------------------------*/
+ModuleRet MovingAverageFilterQ15_update(MovingAverageFilterQ15* const self,
+                                        q15_t data,
+                                        q15_t* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+
+  // process chained filter first
+  ModuleRet ret = __FilterQ15_update_chained((Filter*)self, &data);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  return __MovingAverageFilterQ15_process(self, data, filtered_data);
+}
+
+/**
+ * @brief Function for adding new data to the filter without processing the
+ * chained filter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ */
+static ModuleRet __MovingAverageFilterQ15_process(
+    MovingAverageFilterQ15* const self, const q15_t data,
+    q15_t* const filtered_data) {
+  // replace the oldest data in the ring buffer
+  if (self->size_ == self->window_size_) {
+    self->sum_ -= self->buffer_[self->index_];
+  } else {
+    self->size_++;
+  }
+  self->buffer_[self->index_] = data;
+  self->sum_ += data;
+  if (++self->index_ == self->window_size_) {
+    self->index_ = 0;
+  }
+
+  if (self->size_ == self->window_size_) {
+    if (filtered_data != NULL) {
+      *filtered_data =
+          (q15_t)__FixedPointFilter_multiply(self->sum_, self->reciprocal_);
+    }
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+ModuleRet MovingAverageFilterQ15_update_block(
+    MovingAverageFilterQ15* const self, const q15_t* data,
+    q15_t* const filtered_data, int length, int* const filtered_length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret = __FilterQ15_update_chained_block((Filter*)self, &data,
+                                                   filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  // keep the state in local variables for the whole block
+  q15_t* const buffer = self->buffer_;
+  const int window_size = self->window_size_;
+  int size = self->size_;
+  int index = self->index_;
+  int32_t sum = self->sum_;
+  const uint32_t reciprocal = self->reciprocal_;
+
+  int count = 0;
+  for (int i = 0; i < length; i++) {
+    const q15_t value = data[i];
+    if (size == window_size) {
+      sum -= buffer[index];
+    } else {
+      size++;
+    }
+    buffer[index] = value;
+    sum += value;
+    if (++index == window_size) {
+      index = 0;
+    }
+
+    if (size == window_size) {
+      filtered_data[count++] =
+          (q15_t)__FixedPointFilter_multiply(sum, reciprocal);
+    }
+  }
+
+  self->size_ = size;
+  self->index_ = index;
+  self->sum_ = sum;
+  *filtered_length = count;
+  return ModuleOK;
+}
+
+ModuleRet MovingAverageFilterQ15_get_filtered_data(
+    MovingAverageFilterQ15* const self, q15_t* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  if (self->size_ == self->window_size_) {
+    *filtered_data =
+        (q15_t)__FixedPointFilter_multiply(self->sum_, self->reciprocal_);
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __MovingAverageFilterQ31_update(Filter* const _self, float data,
+                                          float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  MovingAverageFilterQ31* const self = (MovingAverageFilterQ31*)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  q31_t value;
+  ModuleRet ret =
+      __MovingAverageFilterQ31_process(self, Q31_from_float(data), &value);
+  if (ret == ModuleOK && filtered_data != NULL) {
+    *filtered_data = Q31_to_float(value);
+  }
+  return ret;
+}
+
+// from Filter base class
+ModuleRet __MovingAverageFilterQ31_get_filtered_data(
+    Filter* const _self, float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  q31_t value;
+  ModuleRet ret = MovingAverageFilterQ31_get_filtered_data(
+      (MovingAverageFilterQ31*)_self, &value);
+  if (ret == ModuleOK) {
+    *filtered_data = Q31_to_float(value);
+  }
+  return ret;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void MovingAverageFilterQ31_ctor(MovingAverageFilterQ31* const self,
+                                 q31_t* const filter_buffer,
+                                 const int window_size,
+                                 Filter* const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filter_buffer));
+  module_assert(IS_POSTIVE(window_size));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter*)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __MovingAverageFilterQ31_update,
+      .get_filtered_data = __MovingAverageFilterQ31_get_filtered_data,
+      .update_block = __Filter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->buffer_ = filter_buffer;
+  self->window_size_ = window_size;
+  self->size_ = 0;
+  self->index_ = 0;
+  self->sum_ = 0;
+}
+
+/* member function -----------------------------------------------------------*/
+ModuleRet MovingAverageFilterQ31_update(MovingAverageFilterQ31* const self,
+                                        q31_t data,
+                                        q31_t* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+
+  // process chained filter first
+  ModuleRet ret = __FilterQ31_update_chained((Filter*)self, &data);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  return __MovingAverageFilterQ31_process(self, data, filtered_data);
+}
+
+/**
+ * @brief Function for adding new data to the filter without processing the
+ * chained filter.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be added.
+ * @param[out] filtered_data The filtered data, NULL if no need to get filtered
+ * data.
+ * @return ModuleRet Error code.
+ */
+static ModuleRet __MovingAverageFilterQ31_process(
+    MovingAverageFilterQ31* const self, const q31_t data,
+    q31_t* const filtered_data) {
+  // replace the oldest data in the ring buffer
+  if (self->size_ == self->window_size_) {
+    self->sum_ -= self->buffer_[self->index_];
+  } else {
+    self->size_++;
+  }
+  self->buffer_[self->index_] = data;
+  self->sum_ += data;
+  if (++self->index_ == self->window_size_) {
+    self->index_ = 0;
+  }
+
+  if (self->size_ == self->window_size_) {
+    if (filtered_data != NULL) {
+      *filtered_data =
+          (q31_t)__FixedPointFilter_divide_long(self->sum_, self->window_size_);
+    }
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+ModuleRet MovingAverageFilterQ31_update_block(
+    MovingAverageFilterQ31* const self, const q31_t* data,
+    q31_t* const filtered_data, int length, int* const filtered_length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret = __FilterQ31_update_chained_block((Filter*)self, &data,
+                                                   filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  // keep the state in local variables for the whole block
+  q31_t* const buffer = self->buffer_;
+  const int window_size = self->window_size_;
+  int size = self->size_;
+  int index = self->index_;
+  int64_t sum = self->sum_;
+
+  int count = 0;
+  for (int i = 0; i < length; i++) {
+    const q31_t value = data[i];
+    if (size == window_size) {
+      sum -= buffer[index];
+    } else {
+      size++;
+    }
+    buffer[index] = value;
+    sum += value;
+    if (++index == window_size) {
+      index = 0;
+    }
+
+    if (size == window_size) {
+      filtered_data[count++] =
+          (q31_t)__FixedPointFilter_divide_long(sum, window_size);
+    }
+  }
+
+  self->size_ = size;
+  self->index_ = index;
+  self->sum_ = sum;
+  *filtered_length = count;
+  return ModuleOK;
+}
+
+ModuleRet MovingAverageFilterQ31_get_filtered_data(
+    MovingAverageFilterQ31* const self, q31_t* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  if (self->size_ == self->window_size_) {
+    *filtered_data =
+        (q31_t)__FixedPointFilter_divide_long(self->sum_, self->window_size_);
+    return ModuleOK;
+  }
+  return ModuleBusy;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __NormalizeFilterQ15_update(Filter* const _self, float data,
+                                      float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  NormalizeFilterQ15* const self = (NormalizeFilterQ15*)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  self->filtered_data_ =
+      __NormalizeFilterQ15_normalize(self, Q15_from_float(data));
+  if (filtered_data != NULL) {
+    *filtered_data = Q15_to_float(self->filtered_data_);
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __NormalizeFilterQ15_get_filtered_data(Filter* const _self,
+                                                 float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  NormalizeFilterQ15* const self = (NormalizeFilterQ15*)_self;
+  *filtered_data = Q15_to_float(self->filtered_data_);
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void NormalizeFilterQ15_ctor(NormalizeFilterQ15* const self,
+                             const q15_t lower_bound, const q15_t upper_bound,
+                             Filter* const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter*)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __NormalizeFilterQ15_update,
+      .get_filtered_data = __NormalizeFilterQ15_get_filtered_data,
+      .update_block = __Filter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->filtered_data_ = 0;
+  self->lower_bound_ = lower_bound;
+  self->upper_bound_ = upper_bound;
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for normalizing data and updating bounds.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be normalized.
+ * @return q15_t The normalized data.
+ */
+static q15_t __NormalizeFilterQ15_normalize(NormalizeFilterQ15* const self,
+                                            const q15_t data) {
+  // update bounds
+  if (self->upper_bound_ < data) {
+    self->upper_bound_ = data;
+  }
+  if (self->lower_bound_ > data) {
+    self->lower_bound_ = data;
+  }
+
+  // difference and range fit in 16 bits, hence the quotient fits in 32 bits
+  const int32_t range = (int32_t)self->upper_bound_ - self->lower_bound_;
+  if (range == 0) {
+    return 0;
+  }
+  const int32_t quotient = __FixedPointFilter_divide(
+      ((int32_t)data - self->lower_bound_) * 32768, range);
+  return quotient > Q15_MAX ? Q15_MAX : (q15_t)quotient;
+}
+
+ModuleRet NormalizeFilterQ15_update(NormalizeFilterQ15* const self,
+                                    q15_t data, q15_t* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+
+  // process chained filter first
+  ModuleRet ret = __FilterQ15_update_chained((Filter*)self, &data);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  self->filtered_data_ = __NormalizeFilterQ15_normalize(self, data);
+  if (filtered_data != NULL) {
+    *filtered_data = self->filtered_data_;
+  }
+  return ModuleOK;
+}
+
+ModuleRet NormalizeFilterQ15_update_block(NormalizeFilterQ15* const self,
+                                          const q15_t* data,
+                                          q15_t* const filtered_data,
+                                          int length,
+                                          int* const filtered_length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret = __FilterQ15_update_chained_block((Filter*)self, &data,
+                                                   filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  for (int i = 0; i < length; i++) {
+    filtered_data[i] = __NormalizeFilterQ15_normalize(self, data[i]);
+  }
+  if (length > 0) {
+    self->filtered_data_ = filtered_data[length - 1];
+  }
+
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+ModuleRet NormalizeFilterQ15_get_filtered_data(NormalizeFilterQ15* const self,
+                                               q15_t* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  *filtered_data = self->filtered_data_;
+  return ModuleOK;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __NormalizeFilterQ31_update(Filter* const _self, float data,
+                                      float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  NormalizeFilterQ31* const self = (NormalizeFilterQ31*)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  self->filtered_data_ =
+      __NormalizeFilterQ31_normalize(self, Q31_from_float(data));
+  if (filtered_data != NULL) {
+    *filtered_data = Q31_to_float(self->filtered_data_);
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __NormalizeFilterQ31_get_filtered_data(Filter* const _self,
+                                                 float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  NormalizeFilterQ31* const self = (NormalizeFilterQ31*)_self;
+  *filtered_data = Q31_to_float(self->filtered_data_);
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void NormalizeFilterQ31_ctor(NormalizeFilterQ31* const self,
+                             const q31_t lower_bound, const q31_t upper_bound,
+                             Filter* const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter*)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __NormalizeFilterQ31_update,
+      .get_filtered_data = __NormalizeFilterQ31_get_filtered_data,
+      .update_block = __Filter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->filtered_data_ = 0;
+  self->lower_bound_ = lower_bound;
+  self->upper_bound_ = upper_bound;
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for normalizing data and updating bounds.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] data The data to be normalized.
+ * @return q31_t The normalized data.
+ */
+static q31_t __NormalizeFilterQ31_normalize(NormalizeFilterQ31* const self,
+                                            const q31_t data) {
+  // update bounds
+  if (self->upper_bound_ < data) {
+    self->upper_bound_ = data;
+  }
+  if (self->lower_bound_ > data) {
+    self->lower_bound_ = data;
+  }
+
+  // difference and range fit in 32 bits unsigned, hence the shifted
+  // difference fits in 64 bits unsigned
+  const uint64_t range = (uint64_t)((int64_t)self->upper_bound_ -
+                                    self->lower_bound_);
+  if (range == 0) {
+    return 0;
+  }
+  const uint64_t difference =
+      (uint64_t)((int64_t)data - self->lower_bound_);
+  const uint64_t quotient = ((difference << 31) + range / 2) / range;
+  return quotient > (uint64_t)Q31_MAX ? Q31_MAX : (q31_t)quotient;
+}
+
+ModuleRet NormalizeFilterQ31_update(NormalizeFilterQ31* const self,
+                                    q31_t data, q31_t* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+
+  // process chained filter first
+  ModuleRet ret = __FilterQ31_update_chained((Filter*)self, &data);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  self->filtered_data_ = __NormalizeFilterQ31_normalize(self, data);
+  if (filtered_data != NULL) {
+    *filtered_data = self->filtered_data_;
+  }
+  return ModuleOK;
+}
+
+ModuleRet NormalizeFilterQ31_update_block(NormalizeFilterQ31* const self,
+                                          const q31_t* data,
+                                          q31_t* const filtered_data,
+                                          int length,
+                                          int* const filtered_length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  // process chained filter first
+  *filtered_length = 0;
+  ModuleRet ret = __FilterQ31_update_chained_block((Filter*)self, &data,
+                                                   filtered_data, &length);
+  if (ret != ModuleOK) {
+    return ret;
+  }
+
+  for (int i = 0; i < length; i++) {
+    filtered_data[i] = __NormalizeFilterQ31_normalize(self, data[i]);
+  }
+  if (length > 0) {
+    self->filtered_data_ = filtered_data[length - 1];
+  }
+
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+ModuleRet NormalizeFilterQ31_get_filtered_data(NormalizeFilterQ31* const self,
+                                               q31_t* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  *filtered_data = self->filtered_data_;
+  return ModuleOK;
+}
+
+/* static function -----------------------------------------------------------*/
+/**
+ * @brief Function for the predict step and the covariance update of kalman
+ * filter in Q31, which does not depend on the measurement.
+ *
+ * @param[in] Q The process noise covariance.
+ * @param[in] R The measurement noise covariance.
+ * @param[in,out] P The covariance, replaced by the updated covariance.
+ * @param[out] is_converged True if the covariance is unchanged, hence the
+ * returned gain stays the same for all following updates.
+ * @return q31_t The kalman gain.
+ */
+static q31_t __KalmanFilter1DQ31_gain(const q31_t Q, const q31_t R,
+                                      q31_t* const P,
+                                      bool* const is_converged) {
+  // predict step
+  const int64_t P_pred_wide = (int64_t)*P + Q;
+  const q31_t P_pred = P_pred_wide > Q31_MAX ? Q31_MAX : (q31_t)P_pred_wide;
+
+  // update step
+  const int64_t denominator = (int64_t)P_pred + R;
+  int64_t K = 0;
+  if (denominator != 0) {
+    K = __FixedPointFilter_divide_long((int64_t)P_pred << 31, denominator);
+  }
+  if (K > Q31_MAX) {
+    K = Q31_MAX;
+  }
+  const q31_t P_next = (q31_t)(((((int64_t)1 << 31) - K) * P_pred) >> 31);
+  *is_converged = P_next == *P;
+  *P = P_next;
+
+  return (q31_t)K;
+}
+
+/**
+ * @brief Function for the correct step of kalman filter in Q31.
+ *
+ * @param[in] K The kalman gain.
+ * @param[in] x The state.
+ * @param[in] z The measurement.
+ * @return q31_t The corrected state.
+ */
+static inline q31_t __KalmanFilter1DQ31_correct(const q31_t K, const q31_t x,
+                                                const q31_t z) {
+  // the state moves towards the measurement, hence never saturates
+  return x + (q31_t)((((int64_t)K * ((int64_t)z - x)) + ((int64_t)1 << 30)) >>
+                     31);
+}
+
+/**
+ * @brief Function for rounding the Q31 state of KalmanFilter1DQ15 to Q15.
+ *
+ * @param[in] x The state in Q31.
+ * @return q15_t The state in Q15.
+ */
+static inline q15_t __KalmanFilter1DQ15_round(const q31_t x) {
+  // the state lies between Q15 measurements, hence never saturates
+  return (q15_t)(((int64_t)x + (1 << 15)) >> 16);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __KalmanFilter1DQ15_update(Filter* const _self, float data,
+                                     float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  KalmanFilter1DQ15* const self = (KalmanFilter1DQ15*)_self;
+  const q15_t x = KalmanFilter1DQ15_update(self, Q15_from_float(data));
+  if (filtered_data != NULL) {
+    *filtered_data = Q15_to_float(x);
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __KalmanFilter1DQ15_get_filtered_data(Filter* const _self,
+                                                float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  KalmanFilter1DQ15* const self = (KalmanFilter1DQ15*)_self;
+  *filtered_data = Q15_to_float(__KalmanFilter1DQ15_round(self->x_));
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void KalmanFilter1DQ15_ctor(KalmanFilter1DQ15* const self, const q31_t Q,
+                            const q31_t R, const q15_t x0, const q31_t P0) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(Q));
+  module_assert(IS_NOT_NEGATIVE(R));
+  module_assert(IS_NOT_NEGATIVE(P0));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter*)self, NULL);
+  static struct FilterVtbl vtbl = {
+      .update = __KalmanFilter1DQ15_update,
+      .get_filtered_data = __KalmanFilter1DQ15_get_filtered_data,
+      .update_block = __Filter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->Q_ = Q;
+  self->R_ = R;
+  self->x_ = (q31_t)x0 * 65536;
+  self->P_ = P0;
+  self->K_ = 0;
+  self->is_converged_ = false;
+}
+
+/* member function -----------------------------------------------------------*/
+q15_t KalmanFilter1DQ15_update(KalmanFilter1DQ15* const self, const q15_t z) {
+  if (!self->is_converged_) {
+    self->K_ = __KalmanFilter1DQ31_gain(self->Q_, self->R_, &self->P_,
+                                        &self->is_converged_);
+  }
+  self->x_ = __KalmanFilter1DQ31_correct(self->K_, self->x_, (q31_t)z * 65536);
+
+  return __KalmanFilter1DQ15_round(self->x_);
+}
+
+ModuleRet KalmanFilter1DQ15_update_block(KalmanFilter1DQ15* const self,
+                                         const q15_t* const z, q15_t* const x,
+                                         const int length,
+                                         int* const filtered_length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(z));
+  module_assert(IS_NOT_NULL(x));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  // keep the state in local variables for the whole block
+  const q31_t Q = self->Q_;
+  const q31_t R = self->R_;
+  q31_t x_est = self->x_;
+  q31_t P = self->P_;
+  q31_t K = self->K_;
+  bool is_converged = self->is_converged_;
+
+  for (int i = 0; i < length; i++) {
+    if (!is_converged) {
+      K = __KalmanFilter1DQ31_gain(Q, R, &P, &is_converged);
+    }
+    x_est = __KalmanFilter1DQ31_correct(K, x_est, (q31_t)z[i] * 65536);
+    x[i] = __KalmanFilter1DQ15_round(x_est);
+  }
+
+  self->x_ = x_est;
+  self->P_ = P;
+  self->K_ = K;
+  self->is_converged_ = is_converged;
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+q15_t KalmanFilter1DQ15_get_state(KalmanFilter1DQ15* const self) {
+  return __KalmanFilter1DQ15_round(self->x_);
+}
+
+q31_t KalmanFilter1DQ15_get_covariance(KalmanFilter1DQ15* const self) {
+  return self->P_;
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __KalmanFilter1DQ31_update(Filter* const _self, float data,
+                                     float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  KalmanFilter1DQ31* const self = (KalmanFilter1DQ31*)_self;
+  const q31_t x = KalmanFilter1DQ31_update(self, Q31_from_float(data));
+  if (filtered_data != NULL) {
+    *filtered_data = Q31_to_float(x);
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __KalmanFilter1DQ31_get_filtered_data(Filter* const _self,
+                                                float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  KalmanFilter1DQ31* const self = (KalmanFilter1DQ31*)_self;
+  *filtered_data = Q31_to_float(self->x_);
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void KalmanFilter1DQ31_ctor(KalmanFilter1DQ31* const self, const q31_t Q,
+                            const q31_t R, const q31_t x0, const q31_t P0) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(Q));
+  module_assert(IS_NOT_NEGATIVE(R));
+  module_assert(IS_NOT_NEGATIVE(P0));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter*)self, NULL);
+  static struct FilterVtbl vtbl = {
+      .update = __KalmanFilter1DQ31_update,
+      .get_filtered_data = __KalmanFilter1DQ31_get_filtered_data,
+      .update_block = __Filter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->Q_ = Q;
+  self->R_ = R;
+  self->x_ = x0;
+  self->P_ = P0;
+  self->K_ = 0;
+  self->is_converged_ = false;
+}
+
+/* member function -----------------------------------------------------------*/
+q31_t KalmanFilter1DQ31_update(KalmanFilter1DQ31* const self, const q31_t z) {
+  if (!self->is_converged_) {
+    self->K_ = __KalmanFilter1DQ31_gain(self->Q_, self->R_, &self->P_,
+                                        &self->is_converged_);
+  }
+  self->x_ = __KalmanFilter1DQ31_correct(self->K_, self->x_, z);
+
+  return self->x_;
+}
+
+ModuleRet KalmanFilter1DQ31_update_block(KalmanFilter1DQ31* const self,
+                                         const q31_t* const z, q31_t* const x,
+                                         const int length,
+                                         int* const filtered_length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(z));
+  module_assert(IS_NOT_NULL(x));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  // keep the state in local variables for the whole block
+  const q31_t Q = self->Q_;
+  const q31_t R = self->R_;
+  q31_t x_est = self->x_;
+  q31_t P = self->P_;
+  q31_t K = self->K_;
+  bool is_converged = self->is_converged_;
+
+  for (int i = 0; i < length; i++) {
+    if (!is_converged) {
+      K = __KalmanFilter1DQ31_gain(Q, R, &P, &is_converged);
+    }
+    x_est = __KalmanFilter1DQ31_correct(K, x_est, z[i]);
+    x[i] = x_est;
+  }
+
+  self->x_ = x_est;
+  self->P_ = P;
+  self->K_ = K;
+  self->is_converged_ = is_converged;
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+q31_t KalmanFilter1DQ31_get_state(KalmanFilter1DQ31* const self) {
+  return self->x_;
+}
+
+q31_t KalmanFilter1DQ31_get_covariance(KalmanFilter1DQ31* const self) {
+  return self->P_;
+}
@@ -0,0 +1,89 @@
+#include "stm32_module/flash.h"
+
+// glibc include
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/module_common.h"
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet Flash_read(Flash* const self, const uint32_t address,
+                            void* const data, const uint32_t size) {
+  return self->vptr_->read(self, address, data, size);
+}
+
+inline ModuleRet Flash_write(Flash* const self, const uint32_t address,
+                             const void* const data, const uint32_t size) {
+  return self->vptr_->write(self, address, data, size);
+}
+
+inline ModuleRet Flash_erase(Flash* const self, const int sector) {
+  return self->vptr_->erase(self, sector);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// pure virtual function for Flash base class
+ModuleRet __Flash_read(Flash* const self, const uint32_t address,
+                       void* const data, const uint32_t size) {
+  (void)self;
+  (void)address;
+  (void)data;
+  (void)size;
+
+  module_assert(0);
+  return ModuleError;
+}
+
+// pure virtual function for Flash base class
+ModuleRet __Flash_write(Flash* const self, const uint32_t address,
+                        const void* const data, const uint32_t size) {
+  (void)self;
+  (void)address;
+  (void)data;
+  (void)size;
+
+  module_assert(0);
+  return ModuleError;
+}
+
+// pure virtual function for Flash base class
+ModuleRet __Flash_erase(Flash* const self, const int sector) {
+  (void)self;
+  (void)sector;
+
+  module_assert(0);
+  return ModuleError;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void Flash_ctor(Flash* const self, const uint32_t sector_size,
+                const int num_sectors) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_POSTIVE(sector_size));
+  module_assert(IS_POSTIVE(num_sectors));
+
+  // assign base virtual function
+  static struct FlashVtbl vtbl_base = {
+      .read = __Flash_read,
+      .write = __Flash_write,
+      .erase = __Flash_erase,
+  };
+  self->vptr_ = &vtbl_base;
+
+  // initialize member variable
+  self->sector_size_ = sector_size;
+  self->num_sectors_ = num_sectors;
+}
+
+/* member function -----------------------------------------------------------*/
+uint32_t Flash_get_sector_size(const Flash* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return self->sector_size_;
+}
+
+int Flash_get_num_sectors(const Flash* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return self->num_sectors_;
+}
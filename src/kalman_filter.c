@@ -0,0 +1,239 @@
+#include "stm32_module/kalman_filter.h"
+
+// glibc include
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/module_common.h"
+
+/* static function -----------------------------------------------------------*/
+/**
+ * @brief Kernel of KalmanFilter_predict() for n states.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] n The number of states, constant in each call site so that the
+ * loops are fully unrolled.
+ * @return None.
+ */
+static inline void __KalmanFilter_predict(KalmanFilter* const self,
+                                          const int n) {
+  const float* const F = self->F_;
+  const float* const Q = self->Q_;
+
+  // x = F * x
+  float x[KALMAN_FILTER_MAX_NUM_STATES];
+  for (int i = 0; i < n; i++) {
+    x[i] = 0.0F;
+    for (int j = 0; j < n; j++) {
+      x[i] += F[i * n + j] * self->x_[j];
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    self->x_[i] = x[i];
+  }
+
+  // P = F * P * F^T + Q, computing the upper triangle only
+  float FP[KALMAN_FILTER_MAX_NUM_STATES][KALMAN_FILTER_MAX_NUM_STATES];
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      FP[i][j] = 0.0F;
+      for (int k = 0; k < n; k++) {
+        FP[i][j] += F[i * n + k] * self->P_[k][j];
+      }
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = i; j < n; j++) {
+      float sum = Q[i * n + j];
+      for (int k = 0; k < n; k++) {
+        sum += FP[i][k] * F[j * n + k];
+      }
+      self->P_[i][j] = sum;
+      self->P_[j][i] = sum;
+    }
+  }
+}
+
+/**
+ * @brief Kernel of KalmanFilter_update() for n states.
+ *
+ * @param[in,out] self The instance of the class.
+ * @param[in] n The number of states, constant in each call site so that the
+ * loops are fully unrolled.
+ * @param[in] H Measurement matrix of 1 x n.
+ * @param[in] R Measurement noise variance.
+ * @param[in] z The measurement.
+ * @return ModuleRet Error code.
+ */
+static inline ModuleRet __KalmanFilter_update(KalmanFilter* const self,
+                                              const int n,
+                                              const float* const H,
+                                              const float R, const float z) {
+  // innovation variance S = H * P * H^T + R, where PH = P * H^T
+  float PH[KALMAN_FILTER_MAX_NUM_STATES];
+  float S = R;
+  for (int i = 0; i < n; i++) {
+    PH[i] = 0.0F;
+    for (int j = 0; j < n; j++) {
+      PH[i] += self->P_[i][j] * H[j];
+    }
+    S += H[i] * PH[i];
+  }
+  if (!(S > 0.0F)) {
+    return ModuleError;
+  }
+
+  // gain K = P * H^T / S and innovation y = z - H * x
+  const float S_inv = 1.0F / S;
+  float K[KALMAN_FILTER_MAX_NUM_STATES];
+  float y = z;
+  for (int i = 0; i < n; i++) {
+    K[i] = PH[i] * S_inv;
+    y -= H[i] * self->x_[i];
+  }
+  for (int i = 0; i < n; i++) {
+    self->x_[i] += K[i] * y;
+  }
+
+  // joseph form P = A * P * A^T + K * R * K^T, where A = I - K * H
+  float A[KALMAN_FILTER_MAX_NUM_STATES][KALMAN_FILTER_MAX_NUM_STATES];
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      A[i][j] = (i == j ? 1.0F : 0.0F) - K[i] * H[j];
+    }
+  }
+  float AP[KALMAN_FILTER_MAX_NUM_STATES][KALMAN_FILTER_MAX_NUM_STATES];
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      AP[i][j] = 0.0F;
+      for (int k = 0; k < n; k++) {
+        AP[i][j] += A[i][k] * self->P_[k][j];
+      }
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = i; j < n; j++) {
+      float sum = K[i] * R * K[j];
+      for (int k = 0; k < n; k++) {
+        sum += AP[i][k] * A[j][k];
+      }
+      self->P_[i][j] = sum;
+      self->P_[j][i] = sum;
+    }
+  }
+
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void KalmanFilter_ctor(KalmanFilter* const self, const int num_states,
+                       const float* const F, const float* const Q,
+                       const float* const x0, const float* const P0) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_KALMAN_FILTER_NUM_STATES(num_states));
+  module_assert(IS_NOT_NULL(F));
+  module_assert(IS_NOT_NULL(Q));
+  module_assert(IS_NOT_NULL(x0));
+  module_assert(IS_NOT_NULL(P0));
+
+  // initialize member variable
+  self->num_states_ = num_states;
+  self->F_ = F;
+  self->Q_ = Q;
+  for (int i = 0; i < num_states; i++) {
+    self->x_[i] = x0[i];
+    for (int j = 0; j < num_states; j++) {
+      self->P_[i][j] = P0[i * num_states + j];
+    }
+  }
+}
+
+/* member function -----------------------------------------------------------*/
+void KalmanFilter_predict(KalmanFilter* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  // dispatch to the kernel specialized for the number of states
+  switch (self->num_states_) {
+    case 2:
+      __KalmanFilter_predict(self, 2);
+      break;
+    case 3:
+      __KalmanFilter_predict(self, 3);
+      break;
+    case 4:
+      __KalmanFilter_predict(self, 4);
+      break;
+    case 5:
+      __KalmanFilter_predict(self, 5);
+      break;
+    case 6:
+      __KalmanFilter_predict(self, 6);
+      break;
+    default:
+      module_assert(0);
+      break;
+  }
+}
+
+ModuleRet KalmanFilter_update(KalmanFilter* const self, const float* const H,
+                              const float R, const float z) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(H));
+
+  // dispatch to the kernel specialized for the number of states
+  switch (self->num_states_) {
+    case 2:
+      return __KalmanFilter_update(self, 2, H, R, z);
+    case 3:
+      return __KalmanFilter_update(self, 3, H, R, z);
+    case 4:
+      return __KalmanFilter_update(self, 4, H, R, z);
+    case 5:
+      return __KalmanFilter_update(self, 5, H, R, z);
+    case 6:
+      return __KalmanFilter_update(self, 6, H, R, z);
+    default:
+      module_assert(0);
+      return ModuleError;
+  }
+}
+
+ModuleRet KalmanFilter_update_sequential(KalmanFilter* const self,
+                                         const float* const H,
+                                         const float* const R,
+                                         const float* const z,
+                                         const int num_measurements) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(H));
+  module_assert(IS_NOT_NULL(R));
+  module_assert(IS_NOT_NULL(z));
+  module_assert(IS_NOT_NEGATIVE(num_measurements));
+
+  ModuleRet ret = ModuleOK;
+  for (int i = 0; i < num_measurements; i++) {
+    if (KalmanFilter_update(self, &H[i * self->num_states_], R[i], z[i]) !=
+        ModuleOK) {
+      ret = ModuleError;
+    }
+  }
+  return ret;
+}
+
+float KalmanFilter_get_state(KalmanFilter* const self, const int index) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(index));
+  module_assert(IS_LESS(index, self->num_states_));
+
+  return self->x_[index];
+}
+
+float KalmanFilter_get_covariance(KalmanFilter* const self, const int row,
+                                  const int col) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(row));
+  module_assert(IS_LESS(row, self->num_states_));
+  module_assert(IS_NOT_NEGATIVE(col));
+  module_assert(IS_LESS(col, self->num_states_));
+
+  return self->P_[row][col];
+}
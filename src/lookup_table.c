@@ -0,0 +1,423 @@
+#include "stm32_module/lookup_table.h"
+
+// glibc include
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/filter.h"
+#include "stm32_module/fixed_point_filter.h"
+#include "stm32_module/module_common.h"
+
+/* static function -----------------------------------------------------------*/
+/**
+ * @brief Function for computing the inverse of the spacing of breakpoints if
+ * they are uniform.
+ *
+ * @param[in] x Breakpoints in strictly increasing order.
+ * @param[in] num_points The number of breakpoints.
+ * @return float The inverse of the spacing, or 0 if not uniform.
+ */
+static float __LookupTable_inverse_step(const float* const x,
+                                        const int num_points) {
+  const float step = (x[num_points - 1] - x[0]) / (float)(num_points - 1);
+
+  // a deviation much smaller than the spacing can put the computed index off
+  // by at most one segment, which the search corrects
+  for (int i = 1; i < num_points - 1; i++) {
+    const float deviation = x[i] - (x[0] + (float)i * step);
+    if (deviation > 1e-3F * step || deviation < -1e-3F * step) {
+      return 0.0F;
+    }
+  }
+  return 1.0F / step;
+}
+
+/**
+ * @brief Function for finding the segment containing data within the
+ * breakpoints.
+ *
+ * @param[in] x Breakpoints in strictly increasing order.
+ * @param[in] num_points The number of breakpoints.
+ * @param[in] inverse_step The inverse of the spacing if uniform, otherwise 0.
+ * @param[in] data The data, which must be strictly within the breakpoints.
+ * @return int The index of the first breakpoint of the segment.
+ */
+static inline int __LookupTable_find(const float* const x,
+                                     const int num_points,
+                                     const float inverse_step,
+                                     const float data) {
+  // O(1) for uniform breakpoints, corrected by one segment if data is on the
+  // other side of a breakpoint off the nominal spacing
+  if (inverse_step != 0.0F) {
+    int index = (int)((data - x[0]) * inverse_step);
+    if (index > num_points - 2) {
+      index = num_points - 2;
+    }
+    if (data < x[index]) {
+      index--;
+    } else if (data >= x[index + 1]) {
+      index++;
+    }
+    return index;
+  }
+
+  // binary search for the last breakpoint not greater than data
+  int low = 0;
+  int high = num_points - 1;
+  while (high - low > 1) {
+    const int middle = (low + high) / 2;
+    if (x[middle] <= data) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+/**
+ * @brief Function for looking up the table by the precomputed slope.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] x The data.
+ * @return float The interpolated value.
+ */
+static inline float __LookupTable1D_lookup(const LookupTable1D* const self,
+                                           const float x) {
+  const float* const breakpoints = self->x_;
+  const int num_points = self->num_points_;
+
+  // saturate out of the breakpoints
+  if (!(x > breakpoints[0])) {
+    return self->y_[0];
+  }
+  if (x >= breakpoints[num_points - 1]) {
+    return self->y_[num_points - 1];
+  }
+
+  const int index =
+      __LookupTable_find(breakpoints, num_points, self->inverse_step_, x);
+  return self->y_[index] + self->slope_[index] * (x - breakpoints[index]);
+}
+
+/* virtual function redirection ----------------------------------------------*/
+inline ModuleRet LookupTable1D_update(LookupTable1D* const self,
+                                      const float data,
+                                      float* const filtered_data) {
+  return self->super_.vptr_->update((Filter*)self, data, filtered_data);
+}
+
+inline ModuleRet LookupTable1D_get_filtered_data(LookupTable1D* const self,
+                                                 float* const filtered_data) {
+  return self->super_.vptr_->get_filtered_data((Filter*)self, filtered_data);
+}
+
+inline ModuleRet LookupTable1D_update_block(LookupTable1D* const self,
+                                            const float* const data,
+                                            float* const filtered_data,
+                                            const int length,
+                                            int* const filtered_length) {
+  return self->super_.vptr_->update_block((Filter*)self, data, filtered_data,
+                                          length, filtered_length);
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __LookupTable1D_update(Filter* const _self, float data,
+                                 float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  LookupTable1D* const self = (LookupTable1D*)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  self->filtered_data_ = __LookupTable1D_lookup(self, data);
+  if (filtered_data != NULL) {
+    *filtered_data = self->filtered_data_;
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __LookupTable1D_get_filtered_data(Filter* const _self,
+                                            float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  LookupTable1D* const self = (LookupTable1D*)_self;
+  *filtered_data = self->filtered_data_;
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __LookupTable1D_update_block(Filter* const _self, const float* data,
+                                       float* const filtered_data, int length,
+                                       int* const filtered_length) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(data));
+  module_assert(IS_NOT_NULL(filtered_data));
+  module_assert(IS_NOT_NEGATIVE(length));
+  module_assert(IS_NOT_NULL(filtered_length));
+
+  LookupTable1D* const self = (LookupTable1D*)_self;
+  // process chained filter first
+  *filtered_length = 0;
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update_block(self->super_.chained_filter_, data,
+                                        filtered_data, length, &length);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+    data = filtered_data;
+  }
+
+  for (int i = 0; i < length; i++) {
+    filtered_data[i] = __LookupTable1D_lookup(self, data[i]);
+  }
+
+  if (length > 0) {
+    self->filtered_data_ = filtered_data[length - 1];
+  }
+  *filtered_length = length;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void LookupTable1D_ctor(LookupTable1D* const self, const float* const x,
+                        const float* const y, float* const slope_buffer,
+                        const int num_points, Filter* const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(x));
+  module_assert(IS_NOT_NULL(y));
+  module_assert(IS_NOT_NULL(slope_buffer));
+  module_assert(IS_LOOKUP_TABLE_NUM_POINTS(num_points));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter*)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __LookupTable1D_update,
+      .get_filtered_data = __LookupTable1D_get_filtered_data,
+      .update_block = __LookupTable1D_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->x_ = x;
+  self->y_ = y;
+  self->slope_ = slope_buffer;
+  self->num_points_ = num_points;
+  self->inverse_step_ = __LookupTable_inverse_step(x, num_points);
+  self->filtered_data_ = y[0];
+  for (int i = 0; i < num_points - 1; i++) {
+    module_assert(IS_LESS(x[i], x[i + 1]));
+    slope_buffer[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+  }
+}
+
+/* member function -----------------------------------------------------------*/
+float LookupTable1D_lookup(const LookupTable1D* const self, const float x) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __LookupTable1D_lookup(self, x);
+}
+
+/* constructor ---------------------------------------------------------------*/
+void LookupTable2D_ctor(LookupTable2D* const self, const float* const x,
+                        const float* const y, const float* const z,
+                        float* const inverse_spacing_buffer, const int num_x,
+                        const int num_y) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(x));
+  module_assert(IS_NOT_NULL(y));
+  module_assert(IS_NOT_NULL(z));
+  module_assert(IS_NOT_NULL(inverse_spacing_buffer));
+  module_assert(IS_LOOKUP_TABLE_NUM_POINTS(num_x));
+  module_assert(IS_LOOKUP_TABLE_NUM_POINTS(num_y));
+
+  // initialize member variable
+  self->x_ = x;
+  self->y_ = y;
+  self->z_ = z;
+  self->x_inverse_spacing_ = inverse_spacing_buffer;
+  self->y_inverse_spacing_ = &inverse_spacing_buffer[num_x - 1];
+  self->num_x_ = num_x;
+  self->num_y_ = num_y;
+  self->x_inverse_step_ = __LookupTable_inverse_step(x, num_x);
+  self->y_inverse_step_ = __LookupTable_inverse_step(y, num_y);
+  for (int i = 0; i < num_x - 1; i++) {
+    module_assert(IS_LESS(x[i], x[i + 1]));
+    self->x_inverse_spacing_[i] = 1.0F / (x[i + 1] - x[i]);
+  }
+  for (int i = 0; i < num_y - 1; i++) {
+    module_assert(IS_LESS(y[i], y[i + 1]));
+    self->y_inverse_spacing_[i] = 1.0F / (y[i + 1] - y[i]);
+  }
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for finding the segment and the fraction in it of data on
+ * an axis, where data out of the breakpoints is saturated to the edge.
+ *
+ * @param[in] x Breakpoints in strictly increasing order.
+ * @param[in] inverse_spacing Inverse spacing of each segment.
+ * @param[in] num_points The number of breakpoints.
+ * @param[in] inverse_step The inverse of the spacing if uniform, otherwise 0.
+ * @param[in] data The data.
+ * @param[out] fraction The fraction of data in the segment in [0, 1].
+ * @return int The index of the first breakpoint of the segment.
+ */
+static inline int __LookupTable2D_find(const float* const x,
+                                       const float* const inverse_spacing,
+                                       const int num_points,
+                                       const float inverse_step,
+                                       const float data,
+                                       float* const fraction) {
+  if (!(data > x[0])) {
+    *fraction = 0.0F;
+    return 0;
+  }
+  if (data >= x[num_points - 1]) {
+    *fraction = 1.0F;
+    return num_points - 2;
+  }
+
+  const int index = __LookupTable_find(x, num_points, inverse_step, data);
+  *fraction = (data - x[index]) * inverse_spacing[index];
+  return index;
+}
+
+float LookupTable2D_lookup(const LookupTable2D* const self, const float x,
+                           const float y) {
+  float x_fraction;
+  float y_fraction;
+  const int i = __LookupTable2D_find(self->x_, self->x_inverse_spacing_,
+                                     self->num_x_, self->x_inverse_step_, x,
+                                     &x_fraction);
+  const int j = __LookupTable2D_find(self->y_, self->y_inverse_spacing_,
+                                     self->num_y_, self->y_inverse_step_, y,
+                                     &y_fraction);
+
+  // interpolate along the second axis on both rows, then the first axis
+  const float* const row = &self->z_[i * self->num_y_ + j];
+  const float* const next_row = &row[self->num_y_];
+  const float z0 = row[0] + (row[1] - row[0]) * y_fraction;
+  const float z1 = next_row[0] + (next_row[1] - next_row[0]) * y_fraction;
+  return z0 + (z1 - z0) * x_fraction;
+}
+
+/* member function -----------------------------------------------------------*/
+/**
+ * @brief Function for looking up the table in Q15 by shift and mask.
+ *
+ * @param[in] self The instance of the class.
+ * @param[in] x The data.
+ * @return q15_t The interpolated value rounded to nearest.
+ */
+static inline q15_t __LookupTable1DQ15_lookup(
+    const LookupTable1DQ15* const self, const q15_t x) {
+  const q15_t* const y = self->y_;
+  const int shift = self->shift_;
+
+  // saturate out of the breakpoints
+  const int32_t offset = (int32_t)x - self->x0_;
+  if (offset <= 0) {
+    return y[0];
+  }
+  const int32_t index = offset >> shift;
+  if (index >= self->num_points_ - 1) {
+    return y[self->num_points_ - 1];
+  }
+
+  // difference fits in 17 bits and fraction in 15 bits
+  const int32_t fraction = offset & ((1 << shift) - 1);
+  const int32_t difference = (int32_t)y[index + 1] - y[index];
+  return (q15_t)(y[index] +
+                 ((difference * fraction + ((1 << shift) >> 1)) >> shift));
+}
+
+/* virtual function definition -----------------------------------------------*/
+// from Filter base class
+ModuleRet __LookupTable1DQ15_update(Filter* const _self, float data,
+                                    float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+
+  LookupTable1DQ15* const self = (LookupTable1DQ15*)_self;
+  // process chained filter first
+  if (self->super_.chained_filter_ != NULL) {
+    ModuleRet ret = Filter_update(self->super_.chained_filter_, data, &data);
+    if (ret != ModuleOK) {
+      return ret;
+    }
+  }
+
+  self->filtered_data_ =
+      __LookupTable1DQ15_lookup(self, Q15_from_float(data));
+  if (filtered_data != NULL) {
+    *filtered_data = Q15_to_float(self->filtered_data_);
+  }
+  return ModuleOK;
+}
+
+// from Filter base class
+ModuleRet __LookupTable1DQ15_get_filtered_data(Filter* const _self,
+                                               float* const filtered_data) {
+  module_assert(IS_NOT_NULL(_self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  LookupTable1DQ15* const self = (LookupTable1DQ15*)_self;
+  *filtered_data = Q15_to_float(self->filtered_data_);
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void LookupTable1DQ15_ctor(LookupTable1DQ15* const self, const q15_t* const y,
+                           const int num_points, const q15_t x0,
+                           const int shift, Filter* const chained_filter) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(y));
+  module_assert(IS_LOOKUP_TABLE_NUM_POINTS(num_points));
+  module_assert(IS_LOOKUP_TABLE_Q15_SHIFT(shift));
+
+  // construct inherited class and redirect virtual function
+  Filter_ctor((Filter*)self, chained_filter);
+  static struct FilterVtbl vtbl = {
+      .update = __LookupTable1DQ15_update,
+      .get_filtered_data = __LookupTable1DQ15_get_filtered_data,
+      .update_block = __Filter_update_block,
+  };
+  self->super_.vptr_ = &vtbl;
+
+  // initialize member variable
+  self->y_ = y;
+  self->num_points_ = num_points;
+  self->x0_ = x0;
+  self->shift_ = shift;
+  self->filtered_data_ = y[0];
+}
+
+/* member function -----------------------------------------------------------*/
+q15_t LookupTable1DQ15_lookup(const LookupTable1DQ15* const self,
+                              const q15_t x) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __LookupTable1DQ15_lookup(self, x);
+}
+
+void LookupTable1DQ15_lookup_block(const LookupTable1DQ15* const self,
+                                   const q15_t* const x, q15_t* const y,
+                                   const int length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(x));
+  module_assert(IS_NOT_NULL(y));
+  module_assert(IS_NOT_NEGATIVE(length));
+
+  for (int i = 0; i < length; i++) {
+    y[i] = __LookupTable1DQ15_lookup(self, x[i]);
+  }
+}
@@ -247,6 +247,58 @@ void SharedResource_end_access(SharedResource *const self) {
   xSemaphoreGive(self->mutex_handle_);
 }
 
+/* constructor ---------------------------------------------------------------*/
+void SeqLock_ctor(SeqLock *const self, void *const buffer, const size_t size) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(buffer));
+  module_assert(IS_POSTIVE(size));
+
+  // initialize member variable
+  self->sequence_ = 0;
+  self->buffer_ = (uint8_t *)buffer;
+  self->size_ = size;
+  memset(buffer, 0, 2 * size);
+}
+
+/* member function -----------------------------------------------------------*/
+void SeqLock_write(SeqLock *const self, const void *const data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+
+  const uint32_t sequence = self->sequence_;
+
+  // readers switch to the second copy while the first one is written
+  __atomic_store_n(&self->sequence_, sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memcpy(self->buffer_, data, self->size_);
+
+  // readers switch back to the first copy while the second one is written
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  __atomic_store_n(&self->sequence_, sequence + 2, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memcpy(self->buffer_ + self->size_, data, self->size_);
+}
+
+uint32_t SeqLock_read(const SeqLock *const self, void *const data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(data));
+
+  uint32_t sequence;
+  do {
+    sequence = __atomic_load_n(&self->sequence_, __ATOMIC_ACQUIRE);
+    memcpy(data, self->buffer_ + (sequence & 1) * self->size_, self->size_);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  } while (sequence != __atomic_load_n(&self->sequence_, __ATOMIC_RELAXED));
+
+  return sequence;
+}
+
+uint32_t SeqLock_get_sequence(const SeqLock *const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return __atomic_load_n(&self->sequence_, __ATOMIC_ACQUIRE);
+}
+
 /* virtual function redirection ----------------------------------------------*/
 inline ModuleRet Task_start(Task *const self) {
   return self->vptr_->start(self);
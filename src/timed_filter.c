@@ -0,0 +1,177 @@
+#include "stm32_module/timed_filter.h"
+
+// glibc include
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// stm32_module include
+#include "stm32_module/module_common.h"
+
+/* static function -----------------------------------------------------------*/
+/**
+ * @brief Function for checking if timestamp is later than reference, which
+ * works across wrap around of timestamps.
+ *
+ * @param[in] timestamp The timestamp.
+ * @param[in] reference The reference timestamp.
+ * @return bool True if timestamp is later than reference.
+ */
+static inline bool __TimedFilter_is_later(const uint32_t timestamp,
+                                          const uint32_t reference) {
+  return (int32_t)(timestamp - reference) > 0;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void TimedExponentialFilter_ctor(TimedExponentialFilter* const self,
+                                 const float time_constant) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_POSTIVE(time_constant));
+
+  // initialize member variable
+  self->inverse_time_constant_ = 1.0F / time_constant;
+  self->timestamp_ = 0;
+  self->filtered_data_ = 0.0F;
+  self->is_ready_ = false;
+}
+
+/* member function -----------------------------------------------------------*/
+float TimedExponentialFilter_update(TimedExponentialFilter* const self,
+                                    const float data,
+                                    const uint32_t timestamp) {
+  module_assert(IS_NOT_NULL(self));
+
+  if (!self->is_ready_) {
+    self->is_ready_ = true;
+    self->filtered_data_ = data;
+  } else if (__TimedFilter_is_later(timestamp, self->timestamp_)) {
+    // decay of the old filtered data over the interval
+    const float dt = (float)(timestamp - self->timestamp_);
+    const float decay = expf(-dt * self->inverse_time_constant_);
+    self->filtered_data_ = data + decay * (self->filtered_data_ - data);
+  }
+  self->timestamp_ = timestamp;
+  return self->filtered_data_;
+}
+
+ModuleRet TimedExponentialFilter_get_filtered_data(
+    const TimedExponentialFilter* const self, float* const filtered_data) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(filtered_data));
+
+  if (!self->is_ready_) {
+    return ModuleBusy;
+  }
+  *filtered_data = self->filtered_data_;
+  return ModuleOK;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void TimedKalmanFilter1D_ctor(TimedKalmanFilter1D* const self, const float Q,
+                              const float R, const float x0, const float P0) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NEGATIVE(Q));
+  module_assert(IS_NOT_NEGATIVE(R));
+
+  // initialize member variable
+  self->Q_ = Q;
+  self->R_ = R;
+  self->x_ = x0;
+  self->P_ = P0;
+  self->timestamp_ = 0;
+  self->is_ready_ = false;
+}
+
+/* member function -----------------------------------------------------------*/
+float TimedKalmanFilter1D_update(TimedKalmanFilter1D* const self,
+                                 const float z, const uint32_t timestamp) {
+  module_assert(IS_NOT_NULL(self));
+
+  // predict over the interval, where the state of random walk is unchanged
+  float P = self->P_;
+  if (self->is_ready_ && __TimedFilter_is_later(timestamp, self->timestamp_)) {
+    P += self->Q_ * (float)(timestamp - self->timestamp_);
+  }
+  self->is_ready_ = true;
+  self->timestamp_ = timestamp;
+
+  // update
+  const float K = P / (P + self->R_);
+  self->x_ += K * (z - self->x_);
+  self->P_ = (1.0F - K) * P;
+  return self->x_;
+}
+
+float TimedKalmanFilter1D_get_state(const TimedKalmanFilter1D* const self) {
+  module_assert(IS_NOT_NULL(self));
+
+  return self->x_;
+}
+
+float TimedKalmanFilter1D_get_covariance(const TimedKalmanFilter1D* const self,
+                                         const uint32_t timestamp) {
+  module_assert(IS_NOT_NULL(self));
+
+  if (self->is_ready_ && __TimedFilter_is_later(timestamp, self->timestamp_)) {
+    return self->P_ + self->Q_ * (float)(timestamp - self->timestamp_);
+  }
+  return self->P_;
+}
+
+/* constructor ---------------------------------------------------------------*/
+void LinearResampler_ctor(LinearResampler* const self, const uint32_t period) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_POSTIVE(period));
+
+  // initialize member variable
+  self->period_ = period;
+  self->next_timestamp_ = 0;
+  self->timestamp_ = 0;
+  self->data_ = 0.0F;
+  self->is_ready_ = false;
+}
+
+/* member function -----------------------------------------------------------*/
+int LinearResampler_update(LinearResampler* const self, const float data,
+                           const uint32_t timestamp,
+                           float* const resampled_data, const int max_length) {
+  module_assert(IS_NOT_NULL(self));
+  module_assert(IS_NOT_NULL(resampled_data));
+  module_assert(IS_POSTIVE(max_length));
+
+  // the grid starts at the first data
+  if (!self->is_ready_) {
+    self->is_ready_ = true;
+    self->timestamp_ = timestamp;
+    self->data_ = data;
+    self->next_timestamp_ = timestamp + self->period_;
+    resampled_data[0] = data;
+    return 1;
+  }
+  if (!__TimedFilter_is_later(timestamp, self->timestamp_)) {
+    return 0;
+  }
+
+  // slope is computed once so that each grid point needs no division
+  const uint32_t period = self->period_;
+  const uint32_t start = self->timestamp_;
+  const float start_data = self->data_;
+  const float slope = (data - start_data) / (float)(timestamp - start);
+  uint32_t next_timestamp = self->next_timestamp_;
+  int count = 0;
+  while (!__TimedFilter_is_later(next_timestamp, timestamp)) {
+    if (count < max_length) {
+      resampled_data[count++] =
+          start_data + slope * (float)(next_timestamp - start);
+      next_timestamp += period;
+    } else {
+      // skip the rest of the grid points up to timestamp at once
+      next_timestamp += ((timestamp - next_timestamp) / period + 1) * period;
+    }
+  }
+
+  self->next_timestamp_ = next_timestamp;
+  self->timestamp_ = timestamp;
+  self->data_ = data;
+  return count;
+}
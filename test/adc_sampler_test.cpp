@@ -0,0 +1,287 @@
+// stl include
+#include <cstdint>
+
+extern "C" {
+// freertos include
+#include "FreeRTOS.h"
+#include "task.h"
+
+// stm32 include
+#include "stm32_module/stm32_hal.h"
+
+// stm32_module include
+#include "stm32_module/stm32_module.h"
+}
+
+// gtest include
+#include "gtest/gtest.h"
+
+// mock include
+#include "mock/mock.hpp"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::Test;
+using ::testing::WithArg;
+
+/* test parameters -----------------------------------------------------------*/
+#define NUM_CHANNELS 3
+#define NUM_SAMPLES 8
+#define WINDOW_SIZE 4
+#define NUM_HALVES 6
+
+/* other variables -----------------------------------------------------------*/
+extern bool is_first_adc_sampler;
+
+/**
+ * @brief Function to get the simulated conversion of a channel.
+ *
+ * @param channel The channel.
+ * @param i The index of the conversion.
+ * @return uint16_t The conversion of 12 bits.
+ */
+static uint16_t test_conversion(const int channel, const int i) {
+  return (uint16_t)((i * 37 + channel * 1000) & 0xFFF);
+}
+
+/* adc sampler initialization test -------------------------------------------*/
+TEST(AdcSamplerInitTest, AdcSamplerCtor) {
+  AdcSampler adc_sampler;
+  ADC_HandleTypeDef adc_handle;
+  uint16_t dma_buffer[ADC_SAMPLER_DMA_BUFFER_SIZE(NUM_CHANNELS, NUM_SAMPLES)];
+  float channel_buffer[NUM_SAMPLES];
+
+  is_first_adc_sampler = true;
+  AdcSampler_ctor(&adc_sampler, &adc_handle, dma_buffer, NUM_CHANNELS,
+                  NUM_SAMPLES, channel_buffer, NULL);
+
+  EXPECT_EQ(AdcSampler_get_block_count(&adc_sampler), 0);
+  EXPECT_EQ(AdcSampler_get_overrun_count(&adc_sampler), 0);
+  EXPECT_EQ(AdcSampler_get_skipped_count(&adc_sampler), 0);
+}
+
+/* adc sampler start test ----------------------------------------------------*/
+class AdcSamplerStartTest : public Test {
+ protected:
+  void SetUp() override {
+    // reset adc sampler list
+    is_first_adc_sampler = true;
+    AdcSampler_ctor(&adc_sampler_, &adc_handle_, dma_buffer_, NUM_CHANNELS,
+                    NUM_SAMPLES, channel_buffer_, NULL);
+    MovingAverageFilter_ctor(&moving_average_filter_, buffer_, WINDOW_SIZE,
+                             NULL);
+  }
+
+  AdcSampler adc_sampler_;
+
+  ADC_HandleTypeDef adc_handle_;
+
+  uint16_t dma_buffer_[ADC_SAMPLER_DMA_BUFFER_SIZE(NUM_CHANNELS, NUM_SAMPLES)];
+
+  float channel_buffer_[NUM_SAMPLES];
+
+  MovingAverageFilter moving_average_filter_;
+
+  float buffer_[WINDOW_SIZE];
+
+  HAL_ADCMock adc_mock_;
+
+  FreertosMock freertos_mock_;
+};
+
+TEST_F(AdcSamplerStartTest, SetFilter) {
+  EXPECT_EQ(AdcSampler_set_filter(&adc_sampler_, 0,
+                                  (Filter*)&moving_average_filter_),
+            ModuleOK);
+  EXPECT_EQ(AdcSampler_set_filter(&adc_sampler_, NUM_CHANNELS,
+                                  (Filter*)&moving_average_filter_),
+            ModuleError);
+}
+
+TEST_F(AdcSamplerStartTest, StartAdcSampler) {
+  EXPECT_CALL(freertos_mock_, xTaskCreateStatic)
+      .WillOnce(
+          WithArg<6>(Invoke([](StaticTask_t* t) { return (TaskHandle_t)t; })));
+  EXPECT_CALL(adc_mock_,
+              HAL_ADC_Start_DMA(&adc_handle_, (uint32_t*)dma_buffer_,
+                                ADC_SAMPLER_DMA_BUFFER_SIZE(NUM_CHANNELS,
+                                                            NUM_SAMPLES)))
+      .WillOnce(Return(HAL_OK));
+
+  EXPECT_EQ(AdcSampler_start(&adc_sampler_), ModuleOK);
+  EXPECT_EQ(adc_sampler_.super_.state_, TaskRunning);
+
+  EXPECT_EQ(AdcSampler_start(&adc_sampler_), ModuleError);
+  EXPECT_EQ(AdcSampler_set_filter(&adc_sampler_, 0,
+                                  (Filter*)&moving_average_filter_),
+            ModuleError);
+}
+
+TEST_F(AdcSamplerStartTest, StartAdcFailed) {
+  EXPECT_CALL(freertos_mock_, xTaskCreateStatic)
+      .WillOnce(
+          WithArg<6>(Invoke([](StaticTask_t* t) { return (TaskHandle_t)t; })));
+  EXPECT_CALL(adc_mock_, HAL_ADC_Start_DMA).WillOnce(Return(HAL_ERROR));
+
+  EXPECT_EQ(AdcSampler_start(&adc_sampler_), ModuleError);
+}
+
+/* adc sampler ingestion test ------------------------------------------------*/
+class AdcSamplerIngestionTest : public Test {
+ protected:
+  void SetUp() override {
+    ErrorHandler_ctor(&error_handler_);
+    ErrorHandler_start(&error_handler_);
+
+    // reset adc sampler list
+    is_first_adc_sampler = true;
+    AdcSampler_ctor(&adc_sampler_, &adc_handle_, &dma_buffer_[0][0][0],
+                    NUM_CHANNELS, NUM_SAMPLES, channel_buffer_,
+                    &error_handler_);
+    for (int i = 0; i < NUM_CHANNELS; i++) {
+      MovingAverageFilter_ctor(&moving_average_filter_[i], buffer_[i],
+                               WINDOW_SIZE, NULL);
+      AdcSampler_set_filter(&adc_sampler_, i,
+                            (Filter*)&moving_average_filter_[i]);
+    }
+    MovingAverageFilterBank_ctor(&moving_average_filter_bank_, bank_buffer_,
+                                 NUM_CHANNELS, WINDOW_SIZE);
+    AdcSampler_set_filter_bank(&adc_sampler_,
+                               (FilterBank*)&moving_average_filter_bank_);
+
+    EXPECT_CALL(adc_mock_, HAL_ADC_Start_DMA).WillOnce(Return(HAL_OK));
+    AdcSampler_start(&adc_sampler_);
+    // yield for adc sampler to run
+    vPortYield();
+  }
+
+  void TearDown() override {
+    Task_delete((Task*)&adc_sampler_);
+    Task_delete((Task*)&error_handler_);
+  }
+
+  /**
+   * @brief Function to simulate dma filling the next half of dma buffer.
+   *
+   * @return int The half filled.
+   */
+  int fill_half() {
+    const int half = num_halves_ % 2;
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+      for (int j = 0; j < NUM_CHANNELS; j++) {
+        dma_buffer_[half][i][j] =
+            test_conversion(j, num_halves_ * NUM_SAMPLES + i);
+      }
+    }
+    num_halves_++;
+    return half;
+  }
+
+  /**
+   * @brief Function to simulate the interrupt of dma completing a half.
+   *
+   * @param half The half completed.
+   */
+  void complete_half(const int half) {
+    if (half == 0) {
+      HAL_ADC_ConvHalfCpltCallback(&adc_handle_);
+    } else {
+      HAL_ADC_ConvCpltCallback(&adc_handle_);
+    }
+  }
+
+  uint32_t adc_error() {
+    uint32_t error_code = 0;
+    ErrorHandler_get_error(&error_handler_, ERROR_CODE_WORD(ERROR_CODE_ADC),
+                           &error_code);
+    return error_code & ERROR_CODE_BITS(ERROR_CODE_ADC);
+  }
+
+  ErrorHandler error_handler_;
+
+  AdcSampler adc_sampler_;
+
+  ADC_HandleTypeDef adc_handle_;
+
+  uint16_t dma_buffer_[2][NUM_SAMPLES][NUM_CHANNELS];
+
+  float channel_buffer_[NUM_SAMPLES];
+
+  MovingAverageFilter moving_average_filter_[NUM_CHANNELS];
+
+  float buffer_[NUM_CHANNELS][WINDOW_SIZE];
+
+  MovingAverageFilterBank moving_average_filter_bank_;
+
+  float bank_buffer_[MOVING_AVERAGE_FILTER_BANK_BUFFER_SIZE(NUM_CHANNELS,
+                                                            WINDOW_SIZE)];
+
+  int num_halves_ = 0;
+
+  HAL_ADCMock adc_mock_;
+};
+
+TEST_F(AdcSamplerIngestionTest, DeInterleave) {
+  for (int i = 0; i < NUM_HALVES; i++) {
+    complete_half(fill_half());
+    vTaskDelay(1);
+  }
+
+  EXPECT_EQ(AdcSampler_get_block_count(&adc_sampler_), NUM_HALVES);
+  EXPECT_EQ(AdcSampler_get_overrun_count(&adc_sampler_), 0);
+  EXPECT_EQ(adc_error(), 0);
+
+  // both filter and filter bank see every conversion of their channel in order
+  for (int j = 0; j < NUM_CHANNELS; j++) {
+    float sum = 0.0F;
+    for (int i = 0; i < WINDOW_SIZE; i++) {
+      sum += (float)test_conversion(j, NUM_HALVES * NUM_SAMPLES - 1 - i);
+    }
+
+    float filtered_data;
+    EXPECT_EQ(MovingAverageFilter_get_filtered_data(&moving_average_filter_[j],
+                                                    &filtered_data),
+              ModuleOK);
+    EXPECT_FLOAT_EQ(filtered_data, sum / WINDOW_SIZE);
+    EXPECT_FLOAT_EQ(FilterBank_get_filtered_data(
+                        (FilterBank*)&moving_average_filter_bank_, j),
+                    sum / WINDOW_SIZE);
+  }
+}
+
+TEST_F(AdcSamplerIngestionTest, Overrun) {
+  // suspend the scheduler so that dma completes both halves before the task
+  // processes any of them
+  vTaskSuspendAll();
+  complete_half(fill_half());
+  complete_half(fill_half());
+  xTaskResumeAll();
+  vTaskDelay(10);
+
+  // the first half is being overwritten by dma, hence dropped
+  EXPECT_EQ(AdcSampler_get_block_count(&adc_sampler_), 1);
+  EXPECT_EQ(AdcSampler_get_skipped_count(&adc_sampler_), 1);
+  EXPECT_EQ(AdcSampler_get_overrun_count(&adc_sampler_), 1);
+  EXPECT_EQ(adc_error(), ERROR_CODE_BITS(ERROR_CODE_ADC));
+
+  // error is cleared once a half is processed without overrun
+  complete_half(fill_half());
+  vTaskDelay(10);
+
+  EXPECT_EQ(AdcSampler_get_block_count(&adc_sampler_), 2);
+  EXPECT_EQ(AdcSampler_get_skipped_count(&adc_sampler_), 1);
+  EXPECT_EQ(AdcSampler_get_overrun_count(&adc_sampler_), 1);
+  EXPECT_EQ(adc_error(), 0);
+}
+
+TEST_F(AdcSamplerIngestionTest, AdcError) {
+  HAL_ADC_ErrorCallback(&adc_handle_);
+  vTaskDelay(10);
+
+  EXPECT_EQ(AdcSampler_get_block_count(&adc_sampler_), 0);
+  EXPECT_EQ(AdcSampler_get_overrun_count(&adc_sampler_), 1);
+  EXPECT_EQ(adc_error(), ERROR_CODE_BITS(ERROR_CODE_ADC));
+}
+
+int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }
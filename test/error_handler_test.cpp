@@ -1,9 +1,12 @@
 // stl include
+#include <chrono>
 #include <cstdint>
+#include <iostream>
 
 extern "C" {
 // freertos include
 #include "FreeRTOS.h"
+#include "event_groups.h"
 
 // stm32_module include
 #include "stm32_module/stm32_module.h"
@@ -15,6 +18,8 @@ extern "C" {
 // mock include
 #include "mock/mock.hpp"
 
+using ::testing::_;
+using ::testing::InSequence;
 using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::Test;
@@ -26,7 +31,9 @@ TEST(ErrorHandlerInitTest, ErrorHandlerCtor) {
 
   ErrorHandler_ctor(&error_handler);
 
-  EXPECT_EQ(error_handler.error_code_, 0);
+  for (uint32_t i = 0; i < ERROR_CODE_NUM_WORDS; i++) {
+    EXPECT_EQ(error_handler.error_code_[i], 0);
+  }
 }
 
 /* error handler start test --------------------------------------------------*/
@@ -43,7 +50,8 @@ TEST_F(ErrorHandlerStartTest, WriteGetErrorCodeWhileNotStarted) {
   uint32_t error_code = 0x12345678;
   EXPECT_EQ(ErrorHandler_write_error(&error_handler_, error_code, ERROR_SET),
             ModuleError);
-  EXPECT_EQ(ErrorHandler_get_error(&error_handler_, &error_code), ModuleError);
+  EXPECT_EQ(ErrorHandler_get_error(&error_handler_, 0, &error_code),
+            ModuleError);
   EXPECT_EQ(error_code, 0x12345678);
 }
 
@@ -76,12 +84,688 @@ TEST_F(ErrorHandlerAccessErrorTest, ErrorHandlerWriteError) {
                 &error_handler_, ERROR_CODE_CAN_TX | ERROR_CODE_CAN_RX_CRITICAL,
                 ERROR_SET),
             ModuleOK);
-  EXPECT_EQ(ErrorHandler_get_error(&error_handler_, &error_code_), ModuleOK);
+  EXPECT_EQ(ErrorHandler_get_error(&error_handler_, 0, &error_code_),
+            ModuleOK);
   EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX | ERROR_CODE_CAN_RX_CRITICAL);
 
   ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
-  ErrorHandler_get_error(&error_handler_, &error_code_);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_RX_CRITICAL);
+}
+
+TEST_F(ErrorHandlerAccessErrorTest, ErrorHandlerWriteMultiWordError) {
+  const uint32_t error_code_word_1 = ERROR_CODE(1, 3);
+
+  EXPECT_EQ(ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX,
+                                     ERROR_SET),
+            ModuleOK);
+  EXPECT_EQ(ErrorHandler_write_error(&error_handler_, error_code_word_1,
+                                     ERROR_SET),
+            ModuleOK);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX);
+  ErrorHandler_get_error(&error_handler_, 1, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_BITS(error_code_word_1));
+
+  ErrorHandler_write_error(&error_handler_, error_code_word_1, ERROR_CLEAR);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX);
+  ErrorHandler_get_error(&error_handler_, 1, &error_code_);
+  EXPECT_EQ(error_code_, 0);
+}
+
+TEST_F(ErrorHandlerAccessErrorTest, ErrorHandlerWriteErrorInOrder) {
+  // suspend the scheduler so that all events are queued before being handled
+  vTaskSuspendAll();
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_CRITICAL,
+                           ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  xTaskResumeAll();
+
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
   EXPECT_EQ(error_code_, ERROR_CODE_CAN_RX_CRITICAL);
+  EXPECT_EQ(ErrorHandler_get_overflow_count(&error_handler_), 0);
+}
+
+TEST_F(ErrorHandlerAccessErrorTest, ErrorHandlerEventQueueOverflow) {
+  vTaskSuspendAll();
+  for (uint32_t i = 0; i < ERROR_HANDLER_EVENT_QUEUE_LENGTH; i++) {
+    EXPECT_EQ(ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX,
+                                       i % 2 ? ERROR_CLEAR : ERROR_SET),
+              ModuleOK);
+  }
+  EXPECT_EQ(ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX,
+                                     ERROR_SET),
+            ModuleBusy);
+  xTaskResumeAll();
+
+  // the event is lost, but the error still follows the last requested state
+  EXPECT_EQ(ErrorHandler_get_overflow_count(&error_handler_), 1);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX);
+}
+
+TEST_F(ErrorHandlerAccessErrorTest, ErrorHandlerGetSnapshot) {
+  struct error_snapshot snapshot;
+
+  EXPECT_EQ(ErrorHandler_get_snapshot(&error_handler_, &snapshot), ModuleOK);
+  EXPECT_EQ(snapshot.error_code[0], 0);
+  EXPECT_EQ(snapshot.error_code[1], 0);
+  EXPECT_EQ(snapshot.change_count, 0);
+
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE(1, 2), ERROR_SET);
+  EXPECT_EQ(ErrorHandler_get_change_count(&error_handler_), 2);
+  ErrorHandler_get_snapshot(&error_handler_, &snapshot);
+  EXPECT_EQ(snapshot.error_code[0], ERROR_CODE_CAN_TX);
+  EXPECT_EQ(snapshot.error_code[1], ERROR_CODE_BITS(ERROR_CODE(1, 2)));
+  EXPECT_EQ(snapshot.change_count, 2);
+
+  // writing an error already set does not change the error state
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  EXPECT_EQ(ErrorHandler_get_change_count(&error_handler_), 2);
+}
+
+/**
+ * @brief Task standing in for an interrupt, which preempts the test task at a
+ * tick in the middle of its writes, as an interrupt would.
+ */
+struct interrupt_writer {
+  Task super_;
+
+  ErrorHandler* error_handler_;
+
+  volatile bool is_stopped_;
+
+  volatile bool is_done_;
+
+  StackType_t task_stack_[4 * configMINIMAL_STACK_SIZE];
+};
+
+static void interrupt_writer_task_code(void* const _self) {
+  struct interrupt_writer* const self = (struct interrupt_writer*)_self;
+
+  // keep transitions below the storm threshold so that every write is queued
+  for (int i = 0; i < ERROR_HANDLER_STORM_THRESHOLD / 2; i++) {
+    vTaskDelay(ERROR_HANDLER_STORM_WINDOW / ERROR_HANDLER_STORM_THRESHOLD * 4);
+    ErrorHandler_write_error(self->error_handler_, ERROR_CODE_CAN_TX,
+                             ERROR_SET);
+  }
+
+  // let the test task finish its write before the final write
+  self->is_stopped_ = true;
+  vTaskDelay(2);
+  ErrorHandler_write_error(self->error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  self->is_done_ = true;
+  vTaskSuspend(NULL);
+}
+
+TEST_F(ErrorHandlerAccessErrorTest, ConcurrentWriteFromTaskAndInterrupt) {
+  struct interrupt_writer interrupt_writer;
+  Task_ctor(&interrupt_writer.super_, interrupt_writer_task_code);
+  interrupt_writer.error_handler_ = &error_handler_;
+  interrupt_writer.is_stopped_ = false;
+  interrupt_writer.is_done_ = false;
+  Task_create_freertos_task(&interrupt_writer.super_, "interrupt_writer",
+                            TaskPriorityHigh, interrupt_writer.task_stack_,
+                            4 * configMINIMAL_STACK_SIZE);
+
+  // clear the error the interrupt sets, where only the first clear after each
+  // set changes the requested state
+  while (!interrupt_writer.is_stopped_) {
+    ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  }
+  while (!interrupt_writer.is_done_) {
+    vTaskDelay(1);
+  }
+  Task_delete(&interrupt_writer.super_);
+
+  // the error follows the last write, and agrees with the requested state
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX);
+  EXPECT_EQ(error_handler_.requested_error_code_[0], ERROR_CODE_CAN_TX);
+  EXPECT_EQ(ErrorHandler_get_overflow_count(&error_handler_), 0);
+  EXPECT_EQ(error_code_ & ERROR_CODE_STORM, 0);
+}
+
+/* error handler callback test -----------------------------------------------*/
+class ErrorHandlerCallbackTest : public Test {
+ protected:
+  void SetUp() override {
+    ErrorHandler_ctor(&error_handler_);
+    ErrorHandler_add_error_callback(&error_handler_, &error_callback_cb_,
+                                    error_callback, NULL, ERROR_CODE_CAN_TX);
+    ErrorHandler_start(&error_handler_);
+  }
+
+  void TearDown() override { Task_delete((Task*)&error_handler_); }
+
+  ErrorHandler error_handler_;
+
+  struct error_callback_cb error_callback_cb_;
+
+  CallbackMock callback_mock_;
+};
+
+TEST_F(ErrorHandlerCallbackTest, CallbackInOrder) {
+  InSequence s;
+  EXPECT_CALL(callback_mock_, error_callback(_, ERROR_CODE_CAN_TX | ERROR_SET))
+      .Times(1);
+  EXPECT_CALL(callback_mock_,
+              error_callback(_, ERROR_CODE_CAN_TX | ERROR_CLEAR))
+      .Times(1);
+  EXPECT_CALL(callback_mock_, error_callback(_, ERROR_CODE_CAN_TX | ERROR_SET))
+      .Times(1);
+
+  vTaskSuspendAll();
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_CRITICAL,
+                           ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  xTaskResumeAll();
+}
+
+TEST_F(ErrorHandlerCallbackTest, CallbackOnlyOnChange) {
+  EXPECT_CALL(callback_mock_, error_callback(_, ERROR_CODE_CAN_TX | ERROR_SET))
+      .Times(1);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+
+  EXPECT_CALL(callback_mock_,
+              error_callback(_, ERROR_CODE_CAN_TX | ERROR_CLEAR))
+      .Times(1);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+}
+
+TEST_F(ErrorHandlerCallbackTest, CallbackMatchingBits) {
+  // add callbacks while the error handler is running
+  struct error_callback_cb error_callback_cb[2];
+  int arg[2];
+  EXPECT_EQ(ErrorHandler_add_error_callback(
+                &error_handler_, &error_callback_cb[0], error_callback, &arg[0],
+                ERROR_CODE_CAN_TX | ERROR_CODE_CAN_RX_CRITICAL),
+            ModuleOK);
+  EXPECT_EQ(ErrorHandler_add_error_callback(
+                &error_handler_, &error_callback_cb[1], error_callback, &arg[1],
+                ERROR_CODE(1, 0)),
+            ModuleOK);
+
+  EXPECT_CALL(callback_mock_,
+              error_callback(NULL, ERROR_CODE_CAN_TX | ERROR_SET))
+      .Times(1);
+  EXPECT_CALL(callback_mock_,
+              error_callback(&arg[0], ERROR_CODE_CAN_TX | ERROR_SET))
+      .Times(1);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+
+  EXPECT_CALL(callback_mock_,
+              error_callback(&arg[0], ERROR_CODE_CAN_RX_CRITICAL |
+                                          ERROR_CODE_CAN_RX_OPTIONAL |
+                                          ERROR_SET))
+      .Times(1);
+  ErrorHandler_write_error(
+      &error_handler_, ERROR_CODE_CAN_RX_CRITICAL | ERROR_CODE_CAN_RX_OPTIONAL,
+      ERROR_SET);
+
+  EXPECT_CALL(callback_mock_,
+              error_callback(&arg[1], ERROR_CODE(1, 0) | ERROR_SET))
+      .Times(1);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE(1, 0), ERROR_SET);
+}
+
+TEST_F(ErrorHandlerCallbackTest, AddCallbackOverLimit) {
+  struct error_callback_cb error_callback_cb[ERROR_HANDLER_MAX_CALLBACKS];
+
+  // one callback is already added in SetUp
+  for (int i = 0; i < ERROR_HANDLER_MAX_CALLBACKS - 1; i++) {
+    EXPECT_EQ(ErrorHandler_add_error_callback(
+                  &error_handler_, &error_callback_cb[i], error_callback, NULL,
+                  ERROR_CODE_CAN_TX),
+              ModuleOK);
+  }
+  EXPECT_EQ(ErrorHandler_add_error_callback(
+                &error_handler_,
+                &error_callback_cb[ERROR_HANDLER_MAX_CALLBACKS - 1],
+                error_callback, NULL, ERROR_CODE_CAN_TX),
+            ModuleError);
+}
+
+/* error handler callback execution test -------------------------------------*/
+// benchmark parameters
+#define NUM_NOISY_CALLBACKS 4
+#define NOISY_CALLBACK_DURATION std::chrono::milliseconds(1)
+#define NUM_BENCHMARK_ROUNDS 10
+
+static std::chrono::steady_clock::time_point critical_callback_time;
+
+static volatile int noisy_callback_count;
+
+static volatile int noisy_callback_count_at_critical;
+
+static void critical_callback(void*, uint32_t) {
+  critical_callback_time = std::chrono::steady_clock::now();
+  noisy_callback_count_at_critical = noisy_callback_count;
+}
+
+static void noisy_callback(void*, uint32_t) {
+  noisy_callback_count = noisy_callback_count + 1;
+  // emulate slow callback such as logging
+  const auto end = std::chrono::steady_clock::now() + NOISY_CALLBACK_DURATION;
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+class ErrorHandlerCallbackExecutionTest : public Test {
+ protected:
+  void SetUp() override {
+    ErrorHandler_ctor(&error_handler_);
+    ErrorCallbackWorker_ctor(&worker_, TaskPriorityLow);
+    ErrorCallbackWorker_start(&worker_);
+  }
+
+  void TearDown() override {
+    Task_delete((Task*)&error_handler_);
+    Task_delete((Task*)&worker_);
+  }
+
+  /**
+   * @brief Function to measure the worst-case latency from writing a critical
+   * error to its callback being called, while noisy errors are written at the
+   * same time.
+   *
+   * @param error_handler The error handler.
+   * @param noisy_before_critical The most noisy callbacks called before the
+   * critical callback in a round.
+   */
+  std::chrono::microseconds measure_critical_latency(
+      ErrorHandler* error_handler, int* noisy_before_critical) {
+    std::chrono::microseconds worst_latency(0);
+    *noisy_before_critical = 0;
+    for (int i = 0; i < NUM_BENCHMARK_ROUNDS; i++) {
+      for (uint32_t option : {ERROR_SET, ERROR_CLEAR}) {
+        const int noisy_callback_count_at_start = noisy_callback_count;
+        vTaskSuspendAll();
+        for (int j = 0; j < NUM_NOISY_CALLBACKS; j++) {
+          ErrorHandler_write_error(error_handler, ERROR_CODE(1, j), option);
+        }
+        ErrorHandler_write_error(error_handler, ERROR_CODE_CAN_TX, option);
+        const auto start = std::chrono::steady_clock::now();
+        xTaskResumeAll();
+
+        const auto latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                critical_callback_time - start);
+        if (latency > worst_latency) {
+          worst_latency = latency;
+        }
+        if (noisy_callback_count_at_critical - noisy_callback_count_at_start >
+            *noisy_before_critical) {
+          *noisy_before_critical =
+              noisy_callback_count_at_critical - noisy_callback_count_at_start;
+        }
+      }
+    }
+
+    return worst_latency;
+  }
+
+  ErrorHandler error_handler_;
+
+  ErrorCallbackWorker worker_;
+
+  struct error_callback_cb error_callback_cb_[NUM_NOISY_CALLBACKS + 1];
+
+  CallbackMock callback_mock_;
+};
+
+TEST_F(ErrorHandlerCallbackExecutionTest, DeferredCallback) {
+  int arg;
+  ErrorHandler_add_deferred_error_callback(&error_handler_,
+                                           &error_callback_cb_[0], &worker_,
+                                           error_callback, &arg,
+                                           ERROR_CODE_CAN_TX);
+  ErrorHandler_start(&error_handler_);
+
+  InSequence s;
+  EXPECT_CALL(callback_mock_,
+              error_callback(&arg, ERROR_CODE_CAN_TX | ERROR_SET))
+      .Times(1);
+  EXPECT_CALL(callback_mock_,
+              error_callback(&arg, ERROR_CODE_CAN_TX | ERROR_CLEAR))
+      .Times(1);
+
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  EXPECT_EQ(ErrorCallbackWorker_get_dropped_count(&worker_), 0);
+}
+
+TEST_F(ErrorHandlerCallbackExecutionTest, EventGroup) {
+  StaticEventGroup_t event_group_cb;
+  EventGroupHandle_t event_group = xEventGroupCreateStatic(&event_group_cb);
+  ErrorHandler_add_error_event_group(
+      &error_handler_, &error_callback_cb_[0], event_group, 0x1,
+      ERROR_CODE_CAN_TX | ERROR_CODE_CAN_RX_CRITICAL);
+  ErrorHandler_start(&error_handler_);
+
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  EXPECT_EQ(xEventGroupGetBits(event_group), 0x1);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_CRITICAL,
+                           ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  // still set since ERROR_CODE_CAN_RX_CRITICAL is set
+  EXPECT_EQ(xEventGroupGetBits(event_group), 0x1);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_CRITICAL,
+                           ERROR_CLEAR);
+  EXPECT_EQ(xEventGroupGetBits(event_group), 0);
+
+  vEventGroupDelete(event_group);
+}
+
+TEST_F(ErrorHandlerCallbackExecutionTest, CriticalLatencyBenchmark) {
+  // noisy callbacks called inline in the error handler task
+  ErrorHandler inline_error_handler;
+  ErrorHandler_ctor(&inline_error_handler);
+  struct error_callback_cb inline_error_callback_cb[NUM_NOISY_CALLBACKS + 1];
+  for (int i = 0; i < NUM_NOISY_CALLBACKS; i++) {
+    ErrorHandler_add_error_callback(&inline_error_handler,
+                                    &inline_error_callback_cb[i],
+                                    noisy_callback, NULL, ERROR_CODE(1, i));
+  }
+  ErrorHandler_add_error_callback(
+      &inline_error_handler, &inline_error_callback_cb[NUM_NOISY_CALLBACKS],
+      critical_callback, NULL, ERROR_CODE_CAN_TX);
+  ErrorHandler_start(&inline_error_handler);
+  int inline_noisy_before_critical;
+  const auto inline_latency = measure_critical_latency(
+      &inline_error_handler, &inline_noisy_before_critical);
+  Task_delete((Task*)&inline_error_handler);
+
+  // noisy callbacks deferred to the worker
+  for (int i = 0; i < NUM_NOISY_CALLBACKS; i++) {
+    ErrorHandler_add_deferred_error_callback(&error_handler_,
+                                             &error_callback_cb_[i], &worker_,
+                                             noisy_callback, NULL,
+                                             ERROR_CODE(1, i));
+  }
+  ErrorHandler_add_error_callback(&error_handler_,
+                                  &error_callback_cb_[NUM_NOISY_CALLBACKS],
+                                  critical_callback, NULL, ERROR_CODE_CAN_TX);
+  ErrorHandler_start(&error_handler_);
+  int deferred_noisy_before_critical;
+  const auto deferred_latency = measure_critical_latency(
+      &error_handler_, &deferred_noisy_before_critical);
+
+  std::cout << "[ BENCHMARK] worst-case critical callback latency with "
+            << NUM_NOISY_CALLBACKS << " noisy callbacks: inline "
+            << inline_latency.count() << " us, deferred "
+            << deferred_latency.count() << " us" << std::endl;
+
+  // the critical callback waits for the noisy callbacks written before it
+  // only if they are called inline
+  EXPECT_EQ(inline_noisy_before_critical, NUM_NOISY_CALLBACKS);
+  EXPECT_EQ(deferred_noisy_before_critical, 0);
+  EXPECT_EQ(ErrorCallbackWorker_get_dropped_count(&worker_), 0);
+}
+
+/* error handler policy test -------------------------------------------------*/
+// error policy parameters
+#define AUTO_CLEAR_PERIOD 20
+#define DEBOUNCE_PERIOD 100
+#define DEBOUNCE_COUNT 3
+
+class ErrorHandlerPolicyTest : public Test {
+ protected:
+  void SetUp() override {
+    ErrorHandler_ctor(&error_handler_);
+    ErrorHandler_add_error_policy(&error_handler_, &error_policy_cb_[0],
+                                  ERROR_CODE_CAN_TX, ErrorPolicyLatching, 0,
+                                  0);
+    ErrorHandler_add_error_policy(&error_handler_, &error_policy_cb_[1],
+                                  ERROR_CODE_CAN_RX_CRITICAL,
+                                  ErrorPolicyAutoClear, AUTO_CLEAR_PERIOD, 0);
+    ErrorHandler_add_error_policy(&error_handler_, &error_policy_cb_[2],
+                                  ERROR_CODE_CAN_RX_OPTIONAL,
+                                  ErrorPolicyDebounce, DEBOUNCE_PERIOD,
+                                  DEBOUNCE_COUNT);
+    ErrorHandler_start(&error_handler_);
+  }
+
+  void TearDown() override { Task_delete((Task*)&error_handler_); }
+
+  ErrorHandler error_handler_;
+
+  struct error_policy_cb error_policy_cb_[3];
+
+  uint32_t error_code_;
+};
+
+TEST_F(ErrorHandlerPolicyTest, AddPolicyWhileStarted) {
+  struct error_policy_cb error_policy_cb;
+  EXPECT_EQ(ErrorHandler_add_error_policy(&error_handler_, &error_policy_cb,
+                                          ERROR_CODE_ADC, ErrorPolicyLatching,
+                                          0, 0),
+            ModuleError);
+}
+
+TEST_F(ErrorHandlerPolicyTest, Latching) {
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX);
+
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX);
+
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_RESET);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, 0);
+}
+
+TEST_F(ErrorHandlerPolicyTest, AutoClear) {
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_CRITICAL,
+                           ERROR_SET);
+  vTaskDelay(AUTO_CLEAR_PERIOD / 2);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_CRITICAL,
+                           ERROR_SET);
+  vTaskDelay(AUTO_CLEAR_PERIOD / 2 + 5);
+  // re-asserted within the period
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_RX_CRITICAL);
+
+  vTaskDelay(AUTO_CLEAR_PERIOD);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, 0);
+}
+
+TEST_F(ErrorHandlerPolicyTest, Debounce) {
+  for (int i = 0; i < DEBOUNCE_COUNT - 1; i++) {
+    ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_OPTIONAL,
+                             ERROR_SET);
+    ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+    EXPECT_EQ(error_code_, 0);
+  }
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_OPTIONAL,
+                           ERROR_SET);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_RX_OPTIONAL);
+
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_OPTIONAL,
+                           ERROR_CLEAR);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, 0);
+
+  // a single set after clearing the tripped error doesn't trip again
+  for (int i = 0; i < DEBOUNCE_COUNT - 1; i++) {
+    ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_OPTIONAL,
+                             ERROR_SET);
+    ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+    EXPECT_EQ(error_code_, 0);
+  }
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_RX_OPTIONAL,
+                           ERROR_SET);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_RX_OPTIONAL);
+}
+
+/* error handler vehicle state test ------------------------------------------*/
+class ErrorHandlerVehicleStateTest : public Test {
+ protected:
+  void SetUp() override {
+    ErrorHandler_ctor(&error_handler_);
+    ErrorHandler_set_error_severity(&error_handler_, ERROR_CODE_APPS_MASK,
+                                    ErrorSeverityWarning);
+    ErrorHandler_set_error_severity(&error_handler_, ERROR_CODE_CAN_TX,
+                                    ErrorSeverityFatal);
+    ErrorHandler_set_reaction(&error_handler_, VehicleStateWarning,
+                              ERROR_REACTION_TORQUE_CUT);
+    ErrorHandler_set_reaction(&error_handler_, VehicleStateFatal,
+                              ERROR_REACTION_TORQUE_CUT |
+                                  ERROR_REACTION_SHUTDOWN);
+    ErrorHandler_start(&error_handler_);
+  }
+
+  void TearDown() override { Task_delete((Task*)&error_handler_); }
+
+  ErrorHandler error_handler_;
+
+  uint32_t vehicle_status_;
+};
+
+TEST_F(ErrorHandlerVehicleStateTest, SetSeverityWhileStarted) {
+  EXPECT_EQ(ErrorHandler_set_error_severity(&error_handler_, ERROR_CODE_ADC,
+                                            ErrorSeverityFatal),
+            ModuleError);
+  EXPECT_EQ(ErrorHandler_set_reaction(&error_handler_, VehicleStateDegraded,
+                                      ERROR_REACTION_LIMP_MODE),
+            ModuleError);
+}
+
+TEST_F(ErrorHandlerVehicleStateTest, InfoError) {
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_ADC, ERROR_SET);
+
+  vehicle_status_ = ErrorHandler_get_vehicle_status(&error_handler_);
+  EXPECT_EQ(VEHICLE_STATUS_STATE(vehicle_status_), VehicleStateNormal);
+  EXPECT_EQ(VEHICLE_STATUS_REACTION(vehicle_status_), ERROR_REACTION_NONE);
+  EXPECT_EQ(VEHICLE_STATUS_CHANGE_COUNT(vehicle_status_), 0);
+}
+
+TEST_F(ErrorHandlerVehicleStateTest, StateTransition) {
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_APPS1_LOW, ERROR_SET);
+  vehicle_status_ = ErrorHandler_get_vehicle_status(&error_handler_);
+  EXPECT_EQ(VEHICLE_STATUS_STATE(vehicle_status_), VehicleStateWarning);
+  EXPECT_EQ(VEHICLE_STATUS_REACTION(vehicle_status_),
+            ERROR_REACTION_TORQUE_CUT);
+  EXPECT_EQ(VEHICLE_STATUS_CHANGE_COUNT(vehicle_status_), 1);
+
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_APPS1_LOW,
+                           ERROR_CLEAR);
+  vehicle_status_ = ErrorHandler_get_vehicle_status(&error_handler_);
+  EXPECT_EQ(VEHICLE_STATUS_STATE(vehicle_status_), VehicleStateNormal);
+  EXPECT_EQ(VEHICLE_STATUS_REACTION(vehicle_status_), ERROR_REACTION_NONE);
+  EXPECT_EQ(VEHICLE_STATUS_CHANGE_COUNT(vehicle_status_), 2);
+}
+
+TEST_F(ErrorHandlerVehicleStateTest, FatalStateLatched) {
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  vehicle_status_ = ErrorHandler_get_vehicle_status(&error_handler_);
+  EXPECT_EQ(VEHICLE_STATUS_STATE(vehicle_status_), VehicleStateFatal);
+  EXPECT_EQ(VEHICLE_STATUS_REACTION(vehicle_status_),
+            ERROR_REACTION_TORQUE_CUT | ERROR_REACTION_SHUTDOWN);
+
+  // reset while fatal error is set takes no effect
+  ErrorHandler_reset_vehicle_state(&error_handler_);
+  vehicle_status_ = ErrorHandler_get_vehicle_status(&error_handler_);
+  EXPECT_EQ(VEHICLE_STATUS_STATE(vehicle_status_), VehicleStateFatal);
+
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  vehicle_status_ = ErrorHandler_get_vehicle_status(&error_handler_);
+  EXPECT_EQ(VEHICLE_STATUS_STATE(vehicle_status_), VehicleStateFatal);
+
+  ErrorHandler_reset_vehicle_state(&error_handler_);
+  vehicle_status_ = ErrorHandler_get_vehicle_status(&error_handler_);
+  EXPECT_EQ(VEHICLE_STATUS_STATE(vehicle_status_), VehicleStateNormal);
+  EXPECT_EQ(VEHICLE_STATUS_CHANGE_COUNT(vehicle_status_), 2);
+}
+
+/* error handler storm test -------------------------------------------------*/
+class ErrorHandlerStormTest : public Test {
+ protected:
+  void SetUp() override {
+    ErrorHandler_ctor(&error_handler_);
+    ErrorHandler_add_error_callback(&error_handler_, &error_callback_cb_,
+                                    error_callback, NULL, ERROR_CODE_STORM);
+    ErrorHandler_start(&error_handler_);
+  }
+
+  void TearDown() override { Task_delete((Task*)&error_handler_); }
+
+  ErrorHandler error_handler_;
+
+  struct error_callback_cb error_callback_cb_;
+
+  CallbackMock callback_mock_;
+
+  uint32_t error_code_;
+};
+
+TEST_F(ErrorHandlerStormTest, OccurrenceCount) {
+  for (int i = 0; i < 3; i++) {
+    ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  }
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+
+  EXPECT_EQ(
+      ErrorHandler_get_occurrence_count(&error_handler_, ERROR_CODE_CAN_TX), 3);
+  EXPECT_EQ(ErrorHandler_get_occurrence_count(&error_handler_,
+                                              ERROR_CODE_CAN_RX_CRITICAL),
+            0);
+}
+
+TEST_F(ErrorHandlerStormTest, UnchangedWriteNotQueued) {
+  vTaskSuspendAll();
+  for (uint32_t i = 0; i < 2 * ERROR_HANDLER_EVENT_QUEUE_LENGTH; i++) {
+    EXPECT_EQ(ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX,
+                                       ERROR_SET),
+              ModuleOK);
+  }
+  xTaskResumeAll();
+
+  EXPECT_EQ(ErrorHandler_get_overflow_count(&error_handler_), 0);
+  EXPECT_EQ(ErrorHandler_get_change_count(&error_handler_), 1);
+}
+
+TEST_F(ErrorHandlerStormTest, StormDetection) {
+  InSequence s;
+  EXPECT_CALL(callback_mock_, error_callback(_, ERROR_CODE_STORM | ERROR_SET))
+      .Times(1);
+  EXPECT_CALL(callback_mock_,
+              error_callback(_, ERROR_CODE_STORM | ERROR_CLEAR))
+      .Times(1);
+
+  for (int i = 0; i < 2 * ERROR_HANDLER_STORM_THRESHOLD; i++) {
+    ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX,
+                             i % 2 ? ERROR_CLEAR : ERROR_SET);
+  }
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_ & ERROR_CODE_STORM, ERROR_CODE_STORM);
+
+  // writes of error code in storm are not queued
+  const uint32_t change_count = ErrorHandler_get_change_count(&error_handler_);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  EXPECT_EQ(ErrorHandler_get_change_count(&error_handler_), change_count);
+
+  // the error follows the last requested state at the end of storm window, and
+  // the storm ends after a window without storm
+  vTaskDelay(ERROR_HANDLER_STORM_WINDOW + 1);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX | ERROR_CODE_STORM);
+
+  vTaskDelay(2 * ERROR_HANDLER_STORM_WINDOW);
+  ErrorHandler_get_error(&error_handler_, 0, &error_code_);
+  EXPECT_EQ(error_code_, ERROR_CODE_CAN_TX);
 }
 
 int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }
@@ -0,0 +1,268 @@
+// stl include
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+// freertos include
+#include "FreeRTOS.h"
+
+// stm32_module include
+#include "stm32_module/stm32_module.h"
+}
+
+// gtest include
+#include "gtest/gtest.h"
+
+// mock include
+#include "mock/mock.hpp"
+
+using ::testing::Invoke;
+using ::testing::Test;
+using ::testing::WithArg;
+
+/* macro ---------------------------------------------------------------------*/
+#define FLASH_FILE "fault_recorder_test.bin"
+#define FLASH_SLOTS_PER_SECTOR 4
+#define FLASH_SECTOR_SIZE (FLASH_SLOTS_PER_SECTOR * sizeof(struct fault_record))
+#define FLASH_NUM_SECTORS 4
+
+/* fault recorder initialization test ----------------------------------------*/
+TEST(FaultRecorderInitTest, FaultRecorderCtor) {
+  std::remove(FLASH_FILE);
+  FileFlash flash;
+  FileFlash_ctor(&flash, FLASH_FILE, FLASH_SECTOR_SIZE, FLASH_NUM_SECTORS);
+  FaultRecorder fault_recorder;
+
+  FaultRecorder_ctor(&fault_recorder, (Flash*)&flash);
+
+  EXPECT_EQ(fault_recorder.slots_per_sector_, FLASH_SLOTS_PER_SECTOR);
+  EXPECT_EQ(fault_recorder.sequence_, 0);
+  EXPECT_EQ(FaultRecorder_get_dropped_count(&fault_recorder), 0);
+
+  FileFlash_dtor(&flash);
+  std::remove(FLASH_FILE);
+}
+
+/* fault recorder start test -------------------------------------------------*/
+class FaultRecorderStartTest : public Test {
+ protected:
+  void SetUp() override {
+    std::remove(FLASH_FILE);
+    FileFlash_ctor(&flash_, FLASH_FILE, FLASH_SECTOR_SIZE, FLASH_NUM_SECTORS);
+    FaultRecorder_ctor(&fault_recorder_, (Flash*)&flash_);
+  }
+
+  void TearDown() override {
+    FileFlash_dtor(&flash_);
+    std::remove(FLASH_FILE);
+  }
+
+  FileFlash flash_;
+
+  FaultRecorder fault_recorder_;
+
+  FreertosMock freertos_mock_;
+};
+
+TEST_F(FaultRecorderStartTest, FaultRecorderStart) {
+  EXPECT_CALL(freertos_mock_, xTaskCreateStatic)
+      .WillOnce(
+          WithArg<6>(Invoke([](StaticTask_t* t) { return (TaskHandle_t)t; })));
+
+  EXPECT_EQ(FaultRecorder_start(&fault_recorder_), ModuleOK);
+  EXPECT_EQ(fault_recorder_.super_.state_, TaskRunning);
+
+  float freeze_frame;
+  EXPECT_EQ(FaultRecorder_set_freeze_frame(&fault_recorder_, &freeze_frame,
+                                           sizeof(freeze_frame)),
+            ModuleError);
+}
+
+/* fault recorder record test ------------------------------------------------*/
+class FaultRecorderRecordTest : public Test {
+ protected:
+  void SetUp() override {
+    std::remove(FLASH_FILE);
+    FileFlash_ctor(&flash_, FLASH_FILE, FLASH_SECTOR_SIZE, FLASH_NUM_SECTORS);
+    power_on();
+  }
+
+  void TearDown() override {
+    power_off();
+    FileFlash_dtor(&flash_);
+    std::remove(FLASH_FILE);
+  }
+
+  void power_on() {
+    ErrorHandler_ctor(&error_handler_);
+    FaultRecorder_ctor(&fault_recorder_, (Flash*)&flash_);
+    FaultRecorder_set_freeze_frame(&fault_recorder_, freeze_frame_,
+                                   sizeof(freeze_frame_));
+    FaultRecorder_attach(&fault_recorder_, &error_handler_);
+    FaultRecorder_start(&fault_recorder_);
+    ErrorHandler_start(&error_handler_);
+  }
+
+  void power_off() {
+    Task_delete((Task*)&error_handler_);
+    Task_delete((Task*)&fault_recorder_);
+  }
+
+  FileFlash flash_;
+
+  ErrorHandler error_handler_;
+
+  FaultRecorder fault_recorder_;
+
+  float freeze_frame_[2] = {0.0F, 0.0F};
+
+  struct fault_record record_;
+};
+
+TEST_F(FaultRecorderRecordTest, RecordTransition) {
+  freeze_frame_[0] = 0.25F;
+  freeze_frame_[1] = 0.75F;
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  freeze_frame_[0] = 0.5F;
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE(1, 2), ERROR_SET);
+
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 0, &record_), ModuleOK);
+  EXPECT_EQ(record_.sequence, 2);
+  EXPECT_EQ(record_.error_code, ERROR_CODE(1, 2) | ERROR_SET);
+
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 1, &record_), ModuleOK);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_CAN_TX | ERROR_CLEAR);
+  EXPECT_EQ(std::memcmp(record_.freeze_frame, freeze_frame_,
+                        sizeof(freeze_frame_)),
+            0);
+
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 2, &record_), ModuleOK);
+  EXPECT_EQ(record_.sequence, 0);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_CAN_TX | ERROR_SET);
+  const float expected_freeze_frame[2] = {0.25F, 0.75F};
+  EXPECT_EQ(std::memcmp(record_.freeze_frame, expected_freeze_frame,
+                        sizeof(expected_freeze_frame)),
+            0);
+  EXPECT_LE(record_.timestamp, xTaskGetTickCount());
+
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 3, &record_),
+            ModuleError);
+  EXPECT_EQ(FaultRecorder_get_dropped_count(&fault_recorder_), 0);
+}
+
+TEST_F(FaultRecorderRecordTest, TransitionTimestamp) {
+  // hold the error handler task so that the error is handled ticks after it
+  // is written
+  const TaskHandle_t error_handler_task =
+      (TaskHandle_t)&error_handler_.super_.task_control_block_;
+  vTaskSuspend(error_handler_task);
+  const TickType_t write_tick = xTaskGetTickCount();
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  vTaskDelay(10);
+  vTaskResume(error_handler_task);
+  vTaskDelay(1);
+
+  // the record is stamped when the error is written, not when it is handled
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 0, &record_), ModuleOK);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_CAN_TX | ERROR_SET);
+  EXPECT_GE(record_.timestamp, write_tick);
+  EXPECT_LE(record_.timestamp, write_tick + 1);
+}
+
+TEST_F(FaultRecorderRecordTest, RecoverAfterPowerCycle) {
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_ADC, ERROR_SET);
+
+  power_off();
+  FileFlash_dtor(&flash_);
+  FileFlash_ctor(&flash_, FLASH_FILE, FLASH_SECTOR_SIZE, FLASH_NUM_SECTORS);
+  power_on();
+
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 0, &record_), ModuleOK);
+  EXPECT_EQ(record_.sequence, 1);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_ADC | ERROR_SET);
+
+  // the log continues after the records before power cycle
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_D6T, ERROR_SET);
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 0, &record_), ModuleOK);
+  EXPECT_EQ(record_.sequence, 2);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_D6T | ERROR_SET);
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 2, &record_), ModuleOK);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_CAN_TX | ERROR_SET);
+}
+
+TEST_F(FaultRecorderRecordTest, WearLevelling) {
+  // wrap around the log 10 times and write 2 more records to the first sector
+  const int num_slots = FLASH_SLOTS_PER_SECTOR * FLASH_NUM_SECTORS;
+  const int num_records = 10 * num_slots + 2;
+  // spread the transitions over different error codes to avoid error storm
+  for (int i = 0; i < num_records; i++) {
+    ErrorHandler_write_error(&error_handler_, ERROR_CODE(1, (i / 2) % 8),
+                             i % 2 ? ERROR_CLEAR : ERROR_SET);
+  }
+
+  // every sector is erased evenly
+  EXPECT_EQ(FileFlash_get_erase_count(&flash_, 0), 11);
+  for (int i = 1; i < FLASH_NUM_SECTORS; i++) {
+    EXPECT_EQ(FileFlash_get_erase_count(&flash_, i), 10);
+  }
+
+  // records in the erased part of the first sector are lost
+  const int num_kept = num_slots - FLASH_SLOTS_PER_SECTOR + 2;
+  for (int i = 0; i < num_kept; i++) {
+    EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, i, &record_),
+              ModuleOK);
+    EXPECT_EQ(record_.sequence, num_records - i - 1);
+  }
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, num_kept, &record_),
+            ModuleError);
+}
+
+TEST_F(FaultRecorderRecordTest, WriteFailure) {
+  // the failed slot is skipped and the record is retried at the next slot
+  FileFlash_inject_failure(&flash_, 1, 0);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 0, &record_), ModuleOK);
+  EXPECT_EQ(record_.sequence, 1);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_CAN_TX | ERROR_SET);
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 1, &record_),
+            ModuleError);
+  EXPECT_EQ(FaultRecorder_get_write_failure_count(&fault_recorder_), 1);
+  EXPECT_EQ(FaultRecorder_get_dropped_count(&fault_recorder_), 0);
+
+  // the record is lost if flash fails in every attempt
+  FileFlash_inject_failure(&flash_, FAULT_RECORDER_MAX_ATTEMPTS, 0);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_CLEAR);
+  EXPECT_EQ(FaultRecorder_get_write_failure_count(&fault_recorder_),
+            1 + FAULT_RECORDER_MAX_ATTEMPTS);
+  EXPECT_EQ(FaultRecorder_get_dropped_count(&fault_recorder_), 1);
+
+  // records before the failures are still readable by index
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_ADC, ERROR_SET);
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 0, &record_), ModuleOK);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_ADC | ERROR_SET);
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_,
+                                      1 + FAULT_RECORDER_MAX_ATTEMPTS,
+                                      &record_),
+            ModuleOK);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_CAN_TX | ERROR_SET);
+}
+
+TEST_F(FaultRecorderRecordTest, EraseFailure) {
+  // the sector failed to erase is skipped as a whole
+  FileFlash_inject_failure(&flash_, 0, 1);
+  ErrorHandler_write_error(&error_handler_, ERROR_CODE_CAN_TX, ERROR_SET);
+
+  EXPECT_EQ(FaultRecorder_read_record(&fault_recorder_, 0, &record_), ModuleOK);
+  EXPECT_EQ(record_.sequence, FLASH_SLOTS_PER_SECTOR);
+  EXPECT_EQ(record_.error_code, ERROR_CODE_CAN_TX | ERROR_SET);
+  EXPECT_EQ(FileFlash_get_erase_count(&flash_, 0), 0);
+  EXPECT_EQ(FileFlash_get_erase_count(&flash_, 1), 1);
+  EXPECT_EQ(FaultRecorder_get_write_failure_count(&fault_recorder_), 1);
+  EXPECT_EQ(FaultRecorder_get_dropped_count(&fault_recorder_), 0);
+}
+
+int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }
@@ -0,0 +1,309 @@
+// stl include
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+extern "C" {
+// freertos include
+#include "FreeRTOS.h"
+
+// stm32_module include
+#include "stm32_module/stm32_module.h"
+}
+
+// gtest include
+#include "gtest/gtest.h"
+
+// mock include
+#include "mock/mock.hpp"
+
+using ::testing::Test;
+
+/* macro ---------------------------------------------------------------------*/
+// apps1, apps2, bse, steering and 4 wheel speed
+#define NUM_CHANNELS 8
+#define WINDOW_SIZE 16
+#define NUM_SAMPLES 1000
+#define NUM_BENCHMARK_SAMPLES 1000000
+
+/* benchmark helper ----------------------------------------------------------*/
+/**
+ * @brief Function to print the cost per sample of all channels of a benchmark.
+ *
+ * @param name The name of the benchmark.
+ * @param start The start time of the benchmark.
+ * @param num_samples The number of samples processed.
+ * @return double Cost per sample in ns.
+ */
+static double report_benchmark(
+    const char* name, const std::chrono::steady_clock::time_point start,
+    const int num_samples) {
+  const double ns_per_sample =
+      std::chrono::duration<double, std::nano>(
+          std::chrono::steady_clock::now() - start)
+          .count() /
+      num_samples;
+  std::cout << "[ BENCHMARK] " << name << ": " << ns_per_sample
+            << " ns/sample of " << NUM_CHANNELS << " channels" << std::endl;
+  return ns_per_sample;
+}
+
+/**
+ * @brief Function to generate test data of a channel.
+ *
+ * @param channel The channel.
+ * @param i The index of the data.
+ * @return float The data.
+ */
+static float test_data(const int channel, const int i) {
+  return std::sin(0.01F * (channel + 1) * i) +
+         (float)((i * 37 + channel * 11) % 100) / 500.0F;
+}
+
+/* filter bank test ----------------------------------------------------------*/
+class FilterBankTest : public Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < NUM_CHANNELS; i++) {
+      MovingAverageFilter_ctor(&moving_average_filter_[i], buffer_[i],
+                               WINDOW_SIZE, NULL);
+      BiquadFilter_ctor(&biquad_filter_[i], kCoefficients, state_[i], 1, NULL);
+      KalmanFilter1D_ctor(&kalman_filter_[i], 0.01F, 0.1F, 0.0F, 1.0F);
+    }
+    MovingAverageFilterBank_ctor(&moving_average_filter_bank_,
+                                 moving_average_bank_buffer_, NUM_CHANNELS,
+                                 WINDOW_SIZE);
+    BiquadFilterBank_ctor(&biquad_filter_bank_, biquad_bank_buffer_,
+                          NUM_CHANNELS, kCoefficients);
+    KalmanFilter1DBank_ctor(&kalman_filter_bank_, kalman_bank_buffer_,
+                            NUM_CHANNELS, 0.01F, 0.1F, 0.0F, 1.0F);
+  }
+
+  // second order butterworth lowpass at 0.1 of sampling frequency
+  const float kCoefficients[5] = {0.067455273F, 0.134910546F, 0.067455273F,
+                                  -1.142980502F, 0.412801594F};
+
+  MovingAverageFilter moving_average_filter_[NUM_CHANNELS];
+
+  BiquadFilter biquad_filter_[NUM_CHANNELS];
+
+  KalmanFilter1D kalman_filter_[NUM_CHANNELS];
+
+  MovingAverageFilterBank moving_average_filter_bank_;
+
+  BiquadFilterBank biquad_filter_bank_;
+
+  KalmanFilter1DBank kalman_filter_bank_;
+
+  float buffer_[NUM_CHANNELS][WINDOW_SIZE];
+
+  float state_[NUM_CHANNELS][2];
+
+  float moving_average_bank_buffer_[MOVING_AVERAGE_FILTER_BANK_BUFFER_SIZE(
+      NUM_CHANNELS, WINDOW_SIZE)];
+
+  float biquad_bank_buffer_[BIQUAD_FILTER_BANK_BUFFER_SIZE(NUM_CHANNELS)];
+
+  float kalman_bank_buffer_[KALMAN_FILTER_1D_BANK_BUFFER_SIZE(NUM_CHANNELS)];
+
+  float data_[NUM_CHANNELS];
+
+  float filtered_data_[2][NUM_CHANNELS];
+};
+
+TEST_F(FilterBankTest, MovingAverageFilter) {
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    ModuleRet ret;
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      data_[j] = test_data(j, i);
+      ret = MovingAverageFilter_update(&moving_average_filter_[j], data_[j],
+                                       &filtered_data_[0][j]);
+    }
+
+    ASSERT_EQ(MovingAverageFilterBank_update(&moving_average_filter_bank_,
+                                             data_, filtered_data_[1]),
+              ret);
+    if (ret == ModuleOK) {
+      for (int j = 0; j < NUM_CHANNELS; j++) {
+        EXPECT_EQ(filtered_data_[1][j], filtered_data_[0][j]);
+        EXPECT_EQ(FilterBank_get_filtered_data(
+                      (FilterBank*)&moving_average_filter_bank_, j),
+                  filtered_data_[0][j]);
+      }
+    }
+  }
+}
+
+TEST_F(FilterBankTest, BiquadFilter) {
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      data_[j] = test_data(j, i);
+      BiquadFilter_update(&biquad_filter_[j], data_[j], &filtered_data_[0][j]);
+    }
+
+    EXPECT_EQ(BiquadFilterBank_update(&biquad_filter_bank_, data_,
+                                      filtered_data_[1]),
+              ModuleOK);
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      EXPECT_FLOAT_EQ(filtered_data_[1][j], filtered_data_[0][j]);
+    }
+  }
+}
+
+TEST_F(FilterBankTest, KalmanFilter1D) {
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      data_[j] = test_data(j, i);
+      filtered_data_[0][j] =
+          KalmanFilter1D_update(&kalman_filter_[j], data_[j]);
+    }
+
+    EXPECT_EQ(KalmanFilter1DBank_update(&kalman_filter_bank_, data_,
+                                        filtered_data_[1]),
+              ModuleOK);
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      EXPECT_FLOAT_EQ(filtered_data_[1][j], filtered_data_[0][j]);
+    }
+  }
+}
+
+TEST_F(FilterBankTest, SetParameter) {
+  // pass through on channel 1 only
+  const float coefficients[5] = {1.0F, 0.0F, 0.0F, 0.0F, 0.0F};
+  BiquadFilterBank_set_coefficients(&biquad_filter_bank_, 1, coefficients);
+
+  // trust measurement on channel 2 only
+  KalmanFilter1DBank_set_noise(&kalman_filter_bank_, 2, 1.0F, 0.0F);
+
+  for (int j = 0; j < NUM_CHANNELS; j++) {
+    data_[j] = 2.0F;
+  }
+  BiquadFilterBank_update(&biquad_filter_bank_, data_, filtered_data_[0]);
+  KalmanFilter1DBank_update(&kalman_filter_bank_, data_, filtered_data_[1]);
+
+  EXPECT_FLOAT_EQ(filtered_data_[0][0], 2.0F * kCoefficients[0]);
+  EXPECT_FLOAT_EQ(filtered_data_[0][1], 2.0F);
+  EXPECT_LT(filtered_data_[1][0], 2.0F);
+  EXPECT_FLOAT_EQ(filtered_data_[1][2], 2.0F);
+}
+
+TEST_F(FilterBankTest, SteadyState) {
+  KalmanFilter1DBank_enable_steady_state(&kalman_filter_bank_, 1e-6F);
+  for (int j = 0; j < NUM_CHANNELS; j++) {
+    KalmanFilter1D_enable_steady_state(&kalman_filter_[j], 1e-6F);
+  }
+
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      data_[j] = test_data(j, i);
+      filtered_data_[0][j] =
+          KalmanFilter1D_update(&kalman_filter_[j], data_[j]);
+    }
+
+    KalmanFilter1DBank_update(&kalman_filter_bank_, data_, filtered_data_[1]);
+    EXPECT_EQ(KalmanFilter1DBank_is_steady_state(&kalman_filter_bank_),
+              KalmanFilter1D_is_steady_state(&kalman_filter_[0]));
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      EXPECT_FLOAT_EQ(filtered_data_[1][j], filtered_data_[0][j]);
+    }
+  }
+  EXPECT_TRUE(KalmanFilter1DBank_is_steady_state(&kalman_filter_bank_));
+
+  // converge again with new noise
+  KalmanFilter1DBank_set_noise(&kalman_filter_bank_, 0, 0.1F, 0.1F);
+  EXPECT_FALSE(KalmanFilter1DBank_is_steady_state(&kalman_filter_bank_));
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    KalmanFilter1DBank_update(&kalman_filter_bank_, data_, NULL);
+  }
+  EXPECT_TRUE(KalmanFilter1DBank_is_steady_state(&kalman_filter_bank_));
+
+  KalmanFilter1DBank_disable_steady_state(&kalman_filter_bank_);
+  EXPECT_FALSE(KalmanFilter1DBank_is_steady_state(&kalman_filter_bank_));
+}
+
+TEST_F(FilterBankTest, Benchmark) {
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      Filter_update((Filter*)&biquad_filter_[j], (float)((i + j) & 0xFF),
+                    &filtered_data_[0][j]);
+    }
+    sink += filtered_data_[0][0];
+  }
+  report_benchmark("independent biquad filters", start, NUM_BENCHMARK_SAMPLES);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      data_[j] = (float)((i + j) & 0xFF);
+    }
+    FilterBank_update((FilterBank*)&biquad_filter_bank_, data_,
+                      filtered_data_[1]);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("biquad filter bank", start, NUM_BENCHMARK_SAMPLES);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      Filter_update((Filter*)&moving_average_filter_[j],
+                    (float)((i + j) & 0xFF), &filtered_data_[0][j]);
+    }
+    sink += filtered_data_[0][0];
+  }
+  report_benchmark("independent moving average filters", start,
+                   NUM_BENCHMARK_SAMPLES);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      data_[j] = (float)((i + j) & 0xFF);
+    }
+    FilterBank_update((FilterBank*)&moving_average_filter_bank_, data_,
+                      filtered_data_[1]);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("moving average filter bank", start,
+                   NUM_BENCHMARK_SAMPLES);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      Filter_update((Filter*)&kalman_filter_[j], (float)((i + j) & 0xFF),
+                    &filtered_data_[0][j]);
+    }
+    sink += filtered_data_[0][0];
+  }
+  report_benchmark("independent kalman filters", start, NUM_BENCHMARK_SAMPLES);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      data_[j] = (float)((i + j) & 0xFF);
+    }
+    FilterBank_update((FilterBank*)&kalman_filter_bank_, data_,
+                      filtered_data_[1]);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("kalman filter bank", start, NUM_BENCHMARK_SAMPLES);
+
+  KalmanFilter1DBank_enable_steady_state(&kalman_filter_bank_, 1e-6F);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    for (int j = 0; j < NUM_CHANNELS; j++) {
+      data_[j] = (float)((i + j) & 0xFF);
+    }
+    FilterBank_update((FilterBank*)&kalman_filter_bank_, data_,
+                      filtered_data_[1]);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("steady state kalman filter bank", start,
+                   NUM_BENCHMARK_SAMPLES);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }
@@ -0,0 +1,1763 @@
+// stl include
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+// freertos include
+#include "FreeRTOS.h"
+#include "queue.h"
+
+// stm32_module include
+#include "stm32_module/stm32_module.h"
+}
+
+// gtest include
+#include "gtest/gtest.h"
+
+// mock include
+#include "mock/mock.hpp"
+
+using ::testing::Test;
+
+/* macro ---------------------------------------------------------------------*/
+#define WINDOW_SIZE 16
+#define NUM_BENCHMARK_SAMPLES 1000000
+#define BLOCK_SIZE 256
+#define NUM_BENCHMARK_BLOCKS 4000
+#define NUM_TAPS 32
+#define NUM_STAGES 4
+#define MEDIAN_WINDOW_SIZE 15
+#define CIC_ORDER 3
+#define DECIMATION 32
+#define SG_WINDOW_SIZE 15
+#define SG_MAX_WINDOW_SIZE 32
+#define SAMPLE_PERIOD 0.01F
+#define NUM_PUBLISH_TICKS 20
+
+/* benchmark helper ----------------------------------------------------------*/
+/**
+ * @brief Function to print the cost per sample of a benchmark.
+ *
+ * @param name The name of the benchmark.
+ * @param start The start time of the benchmark.
+ * @param num_samples The number of samples processed.
+ * @return double Cost per sample in ns.
+ */
+static double report_benchmark(
+    const char* name, const std::chrono::steady_clock::time_point start,
+    const int num_samples) {
+  const double ns_per_sample =
+      std::chrono::duration<double, std::nano>(
+          std::chrono::steady_clock::now() - start)
+          .count() /
+      num_samples;
+  std::cout << "[ BENCHMARK] " << name << ": " << ns_per_sample
+            << " ns/sample" << std::endl;
+  return ns_per_sample;
+}
+
+/* moving average filter test ------------------------------------------------*/
+/// @brief Moving average using freertos queue, as MovingAverageFilter was
+/// implemented before, for comparing the per-sample cost.
+struct QueueMovingAverage {
+  QueueHandle_t data_queue;
+
+  StaticQueue_t queue_cb;
+
+  float buffer[WINDOW_SIZE];
+
+  float sum;
+
+  QueueMovingAverage() : sum(0.0F) {
+    data_queue = xQueueCreateStatic(WINDOW_SIZE, sizeof(float),
+                                    (uint8_t*)buffer, &queue_cb);
+  }
+
+  ~QueueMovingAverage() { vQueueDelete(data_queue); }
+
+  ModuleRet update(float data, float* filtered_data) {
+    UBaseType_t queue_size;
+    if (xPortIsInsideInterrupt()) {
+      queue_size = uxQueueMessagesWaitingFromISR(data_queue);
+    } else {
+      queue_size = uxQueueMessagesWaiting(data_queue);
+    }
+    if (queue_size == WINDOW_SIZE) {
+      float oldest_value;
+      if (xPortIsInsideInterrupt()) {
+        xQueueReceiveFromISR(data_queue, &oldest_value, NULL);
+      } else {
+        xQueueReceive(data_queue, &oldest_value, 0);
+      }
+      sum -= oldest_value;
+    }
+    sum += data;
+    if (xPortIsInsideInterrupt()) {
+      xQueueSendToBackFromISR(data_queue, &data, NULL);
+    } else {
+      xQueueSendToBack(data_queue, &data, 0);
+    }
+    if (queue_size == WINDOW_SIZE) {
+      *filtered_data = sum / WINDOW_SIZE;
+      return ModuleOK;
+    }
+    return ModuleBusy;
+  }
+};
+
+class MovingAverageFilterTest : public Test {
+ protected:
+  void SetUp() override {
+    MovingAverageFilter_ctor(&filter_, buffer_, WINDOW_SIZE, NULL);
+  }
+
+  MovingAverageFilter filter_;
+
+  float buffer_[WINDOW_SIZE];
+
+  float filtered_data_;
+};
+
+TEST_F(MovingAverageFilterTest, WindowNotFilled) {
+  for (int i = 0; i < WINDOW_SIZE - 1; i++) {
+    EXPECT_EQ(MovingAverageFilter_update(&filter_, 1.0F, &filtered_data_),
+              ModuleBusy);
+  }
+  EXPECT_EQ(MovingAverageFilter_get_filtered_data(&filter_, &filtered_data_),
+            ModuleBusy);
+
+  EXPECT_EQ(MovingAverageFilter_update(&filter_, 1.0F, &filtered_data_),
+            ModuleOK);
+  EXPECT_FLOAT_EQ(filtered_data_, 1.0F);
+}
+
+TEST_F(MovingAverageFilterTest, Average) {
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    MovingAverageFilter_update(&filter_, (float)i, &filtered_data_);
+  }
+  EXPECT_FLOAT_EQ(filtered_data_, (WINDOW_SIZE - 1) / 2.0F);
+
+  // the oldest data slides out of the window
+  for (int i = WINDOW_SIZE; i < 3 * WINDOW_SIZE + 5; i++) {
+    EXPECT_EQ(MovingAverageFilter_update(&filter_, (float)i, &filtered_data_),
+              ModuleOK);
+    EXPECT_FLOAT_EQ(filtered_data_, i - (WINDOW_SIZE - 1) / 2.0F);
+  }
+  EXPECT_EQ(MovingAverageFilter_get_filtered_data(&filter_, &filtered_data_),
+            ModuleOK);
+  EXPECT_FLOAT_EQ(filtered_data_,
+                  3 * WINDOW_SIZE + 4 - (WINDOW_SIZE - 1) / 2.0F);
+}
+
+TEST_F(MovingAverageFilterTest, BoundedDrift) {
+  // large offset with small noise accumulates rounding error in running sum
+  double window[WINDOW_SIZE];
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    const float data = 1000.0F + 0.001F * std::sin(0.1F * i);
+    window[i % WINDOW_SIZE] = data;
+    MovingAverageFilter_update(&filter_, data, &filtered_data_);
+  }
+
+  double expected = 0.0;
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    expected += window[i];
+  }
+  expected /= WINDOW_SIZE;
+  EXPECT_NEAR(filtered_data_, expected, 1e-3);
+}
+
+TEST_F(MovingAverageFilterTest, Partial) {
+  MovingAverageFilter_set_partial(&filter_, true);
+  EXPECT_EQ(MovingAverageFilter_get_filtered_data(&filter_, &filtered_data_),
+            ModuleBusy);
+
+  // average of the data so far until the window is filled
+  for (int i = 0; i < 2 * WINDOW_SIZE; i++) {
+    EXPECT_EQ(MovingAverageFilter_update(&filter_, (float)i, &filtered_data_),
+              ModuleOK);
+    const int first = i < WINDOW_SIZE ? 0 : i - WINDOW_SIZE + 1;
+    EXPECT_FLOAT_EQ(filtered_data_, (first + i) / 2.0F);
+  }
+
+  // block kernel outputs every data
+  MovingAverageFilter_ctor(&filter_, buffer_, WINDOW_SIZE, NULL);
+  MovingAverageFilter_set_partial(&filter_, true);
+  float data[BLOCK_SIZE];
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    data[i] = (float)i;
+  }
+  int filtered_length;
+  EXPECT_EQ(MovingAverageFilter_update_block(&filter_, data, data, BLOCK_SIZE,
+                                             &filtered_length),
+            ModuleOK);
+  ASSERT_EQ(filtered_length, BLOCK_SIZE);
+  EXPECT_FLOAT_EQ(data[0], 0.0F);
+  EXPECT_FLOAT_EQ(data[3], 1.5F);
+  EXPECT_FLOAT_EQ(data[BLOCK_SIZE - 1],
+                  BLOCK_SIZE - 1 - (WINDOW_SIZE - 1) / 2.0F);
+}
+
+TEST_F(MovingAverageFilterTest, Prefill) {
+  MovingAverageFilter_prefill(&filter_, 2.0F);
+  EXPECT_EQ(MovingAverageFilter_get_filtered_data(&filter_, &filtered_data_),
+            ModuleOK);
+  EXPECT_FLOAT_EQ(filtered_data_, 2.0F);
+
+  // the prefilled value slides out of the window as usual
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    EXPECT_EQ(MovingAverageFilter_update(&filter_, 4.0F, &filtered_data_),
+              ModuleOK);
+    EXPECT_FLOAT_EQ(filtered_data_, 2.0F + 2.0F * (i + 1) / WINDOW_SIZE);
+  }
+}
+
+TEST_F(MovingAverageFilterTest, SaveRestore) {
+  float saved[WINDOW_SIZE];
+  EXPECT_EQ(MovingAverageFilter_save(&filter_, saved), 0);
+
+  for (int i = 0; i < WINDOW_SIZE + 5; i++) {
+    MovingAverageFilter_update(&filter_, (float)i, &filtered_data_);
+  }
+  ASSERT_EQ(MovingAverageFilter_save(&filter_, saved), WINDOW_SIZE);
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    EXPECT_EQ(saved[i], (float)(i + 5));
+  }
+
+  // restored filter continues as if it were never reset
+  MovingAverageFilter restored;
+  float restored_buffer[WINDOW_SIZE];
+  MovingAverageFilter_ctor(&restored, restored_buffer, WINDOW_SIZE, NULL);
+  MovingAverageFilter_restore(&restored, saved, WINDOW_SIZE);
+  for (int i = WINDOW_SIZE + 5; i < 3 * WINDOW_SIZE; i++) {
+    float restored_data;
+    MovingAverageFilter_update(&filter_, (float)i, &filtered_data_);
+    EXPECT_EQ(MovingAverageFilter_update(&restored, (float)i, &restored_data),
+              ModuleOK);
+    EXPECT_FLOAT_EQ(restored_data, filtered_data_);
+  }
+
+  // partially filled window and window larger than the filter
+  MovingAverageFilter_restore(&restored, saved, 3);
+  EXPECT_EQ(MovingAverageFilter_save(&restored, restored_buffer), 3);
+  EXPECT_EQ(MovingAverageFilter_get_filtered_data(&restored, &filtered_data_),
+            ModuleBusy);
+  float half_buffer[WINDOW_SIZE / 2];
+  MovingAverageFilter_ctor(&restored, half_buffer, WINDOW_SIZE / 2, NULL);
+  MovingAverageFilter_restore(&restored, saved, WINDOW_SIZE);
+  EXPECT_EQ(MovingAverageFilter_get_filtered_data(&restored, &filtered_data_),
+            ModuleOK);
+  EXPECT_FLOAT_EQ(filtered_data_,
+                  5.0F + WINDOW_SIZE / 2 + (WINDOW_SIZE / 2 - 1) / 2.0F);
+}
+
+TEST_F(MovingAverageFilterTest, Benchmark) {
+  QueueMovingAverage queue_moving_average;
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    queue_moving_average.update((float)(i & 0xFF), &filtered_data_);
+    sink += filtered_data_;
+  }
+  report_benchmark("freertos queue moving average", start,
+                   NUM_BENCHMARK_SAMPLES);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    MovingAverageFilter_update(&filter_, (float)(i & 0xFF), &filtered_data_);
+    sink += filtered_data_;
+  }
+  report_benchmark("ring buffer moving average", start, NUM_BENCHMARK_SAMPLES);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* filter block test ---------------------------------------------------------*/
+class FilterBlockTest : public Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 2; i++) {
+      MovingAverageFilter_ctor(&moving_average_filter_[i], buffer_[i],
+                               WINDOW_SIZE, NULL);
+      NormalizeFilter_ctor(&normalize_filter_[i], 0.0F, 1.0F,
+                           (Filter*)&moving_average_filter_[i]);
+      KalmanFilter1D_ctor(&kalman_filter_[i], 0.01F, 0.1F, 0.0F, 1.0F);
+    }
+  }
+
+  void fill_data(const int block) {
+    // exceed the initial bounds in the first blocks only
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      data_[i] = (float)((i * 37 + block * 11) % 100) / 50.0F -
+                 (block < 3 ? 0.5F : 0.0F);
+    }
+  }
+
+  MovingAverageFilter moving_average_filter_[2];
+
+  NormalizeFilter normalize_filter_[2];
+
+  KalmanFilter1D kalman_filter_[2];
+
+  float buffer_[2][WINDOW_SIZE];
+
+  float data_[BLOCK_SIZE];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(FilterBlockTest, ChainedFilter) {
+  for (int block = 0; block < 10; block++) {
+    fill_data(block);
+
+    int length = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      if (Filter_update((Filter*)&normalize_filter_[0], data_[i],
+                        &filtered_data_[0][length]) == ModuleOK) {
+        length++;
+      }
+    }
+
+    int filtered_length;
+    EXPECT_EQ(Filter_update_block((Filter*)&normalize_filter_[1], data_,
+                                  filtered_data_[1], BLOCK_SIZE,
+                                  &filtered_length),
+              ModuleOK);
+
+    // window of moving average is filled within the first block
+    EXPECT_EQ(filtered_length,
+              block == 0 ? BLOCK_SIZE - WINDOW_SIZE + 1 : BLOCK_SIZE);
+    ASSERT_EQ(filtered_length, length);
+    for (int i = 0; i < length; i++) {
+      EXPECT_FLOAT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+    }
+  }
+}
+
+TEST_F(FilterBlockTest, InPlace) {
+  fill_data(0);
+
+  int length = 0;
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    if (Filter_update((Filter*)&normalize_filter_[0], data_[i],
+                      &filtered_data_[0][length]) == ModuleOK) {
+      length++;
+    }
+  }
+
+  int filtered_length;
+  EXPECT_EQ(Filter_update_block((Filter*)&normalize_filter_[1], data_, data_,
+                                BLOCK_SIZE, &filtered_length),
+            ModuleOK);
+  ASSERT_EQ(filtered_length, length);
+  for (int i = 0; i < length; i++) {
+    EXPECT_FLOAT_EQ(data_[i], filtered_data_[0][i]);
+  }
+}
+
+TEST_F(FilterBlockTest, KalmanFilter1D) {
+  fill_data(0);
+
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    filtered_data_[0][i] = KalmanFilter1D_update(&kalman_filter_[0], data_[i]);
+  }
+
+  int filtered_length;
+  EXPECT_EQ(KalmanFilter1D_update_block(&kalman_filter_[1], data_,
+                                        filtered_data_[1], BLOCK_SIZE,
+                                        &filtered_length),
+            ModuleOK);
+  EXPECT_EQ(filtered_length, BLOCK_SIZE);
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    EXPECT_FLOAT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+  }
+  EXPECT_FLOAT_EQ(KalmanFilter1D_get_covariance(&kalman_filter_[1]),
+                  KalmanFilter1D_get_covariance(&kalman_filter_[0]));
+}
+
+TEST_F(FilterBlockTest, Benchmark) {
+  fill_data(3);
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int length = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      if (Filter_update((Filter*)&normalize_filter_[0], data_[i],
+                        &filtered_data_[0][length]) == ModuleOK) {
+        length++;
+      }
+    }
+    sink += filtered_data_[0][0];
+  }
+  report_benchmark("per-sample chained filter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int filtered_length;
+    Filter_update_block((Filter*)&normalize_filter_[1], data_,
+                        filtered_data_[1], BLOCK_SIZE, &filtered_length);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("block chained filter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* kalman filter 1d test -----------------------------------------------------*/
+class KalmanFilter1DTest : public Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 2; i++) {
+      KalmanFilter1D_ctor(&kalman_filter_[i], 0.01F, 0.1F, 0.0F, 1.0F);
+      KalmanFilter1D_ctor(&steady_state_filter_[i], 0.01F, 0.1F, 0.0F, 1.0F);
+      KalmanFilter1D_enable_steady_state(&steady_state_filter_[i], 1e-6F);
+    }
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      data_[i] = std::sin(0.05F * i) + (float)((i * 37) % 100) / 500.0F;
+    }
+  }
+
+  KalmanFilter1D kalman_filter_[2];
+
+  KalmanFilter1D steady_state_filter_[2];
+
+  float data_[BLOCK_SIZE];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(KalmanFilter1DTest, SteadyState) {
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    const float x = KalmanFilter1D_update(&kalman_filter_[0], data_[i]);
+    EXPECT_NEAR(KalmanFilter1D_update(&steady_state_filter_[0], data_[i]), x,
+                1e-5F);
+  }
+  EXPECT_FALSE(KalmanFilter1D_is_steady_state(&kalman_filter_[0]));
+  EXPECT_TRUE(KalmanFilter1D_is_steady_state(&steady_state_filter_[0]));
+
+  // the fixed gain keeps tracking the full update
+  for (int block = 0; block < 100; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      const float x = KalmanFilter1D_update(&kalman_filter_[0], data_[i]);
+      ASSERT_NEAR(KalmanFilter1D_update(&steady_state_filter_[0], data_[i]), x,
+                  1e-5F);
+    }
+  }
+
+  KalmanFilter1D_disable_steady_state(&steady_state_filter_[0]);
+  EXPECT_FALSE(KalmanFilter1D_is_steady_state(&steady_state_filter_[0]));
+}
+
+TEST_F(KalmanFilter1DTest, UpdateN) {
+  // converge in the middle of the batch
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    filtered_data_[0][i] =
+        KalmanFilter1D_update(&steady_state_filter_[0], data_[i]);
+  }
+  EXPECT_EQ(KalmanFilter1D_update_n(&steady_state_filter_[1], data_,
+                                    filtered_data_[1], BLOCK_SIZE),
+            filtered_data_[0][BLOCK_SIZE - 1]);
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    EXPECT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+  }
+  EXPECT_TRUE(KalmanFilter1D_is_steady_state(&steady_state_filter_[1]));
+  EXPECT_EQ(KalmanFilter1D_get_covariance(&steady_state_filter_[1]),
+            KalmanFilter1D_get_covariance(&steady_state_filter_[0]));
+
+  // in place without steady state
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    filtered_data_[0][i] = KalmanFilter1D_update(&kalman_filter_[0], data_[i]);
+  }
+  KalmanFilter1D_update_n(&kalman_filter_[1], data_, data_, BLOCK_SIZE);
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    EXPECT_EQ(data_[i], filtered_data_[0][i]);
+  }
+  EXPECT_FALSE(KalmanFilter1D_is_steady_state(&kalman_filter_[1]));
+}
+
+TEST_F(KalmanFilter1DTest, Benchmark) {
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    sink += KalmanFilter1D_update_n(&kalman_filter_[0], data_,
+                                    filtered_data_[0], BLOCK_SIZE);
+  }
+  report_benchmark("full gain kalman filter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    sink += KalmanFilter1D_update_n(&steady_state_filter_[0], data_,
+                                    filtered_data_[1], BLOCK_SIZE);
+  }
+  report_benchmark("steady state gain kalman filter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      sink += KalmanFilter1D_update(&steady_state_filter_[1], data_[i]);
+    }
+  }
+  report_benchmark("per-sample steady state gain kalman filter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* fir filter test -----------------------------------------------------------*/
+class FirFilterTest : public Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < NUM_TAPS; i++) {
+      coefficients_[i] = (float)(i + 1) / NUM_TAPS;
+    }
+    for (int i = 0; i < 2; i++) {
+      FirFilter_ctor(&filter_[i], coefficients_, delay_line_[i], NUM_TAPS,
+                     NULL);
+    }
+  }
+
+  FirFilter filter_[2];
+
+  float coefficients_[NUM_TAPS];
+
+  float delay_line_[2][2 * NUM_TAPS];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(FirFilterTest, ImpulseResponse) {
+  float filtered_data;
+  for (int i = 0; i < 3 * NUM_TAPS; i++) {
+    EXPECT_EQ(FirFilter_update(&filter_[0], i == 0 ? 1.0F : 0.0F,
+                               &filtered_data),
+              ModuleOK);
+    EXPECT_FLOAT_EQ(filtered_data, i < NUM_TAPS ? coefficients_[i] : 0.0F);
+  }
+  EXPECT_EQ(FirFilter_get_filtered_data(&filter_[0], &filtered_data),
+            ModuleOK);
+  EXPECT_FLOAT_EQ(filtered_data, 0.0F);
+}
+
+TEST_F(FirFilterTest, MovingAverage) {
+  for (int i = 0; i < NUM_TAPS; i++) {
+    coefficients_[i] = 1.0F / NUM_TAPS;
+  }
+  MovingAverageFilter moving_average_filter;
+  float buffer[NUM_TAPS];
+  MovingAverageFilter_ctor(&moving_average_filter, buffer, NUM_TAPS, NULL);
+
+  for (int i = 0; i < 5 * NUM_TAPS; i++) {
+    float filtered_data[2];
+    FirFilter_update(&filter_[0], (float)(i % 7), &filtered_data[0]);
+    if (MovingAverageFilter_update(&moving_average_filter, (float)(i % 7),
+                                   &filtered_data[1]) == ModuleOK) {
+      EXPECT_NEAR(filtered_data[0], filtered_data[1], 1e-5);
+    }
+  }
+}
+
+TEST_F(FirFilterTest, UpdateBlock) {
+  for (int block = 0; block < 3; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[0][i] = std::sin(0.05F * (block * BLOCK_SIZE + i));
+      filtered_data_[1][i] = filtered_data_[0][i];
+    }
+
+    // per-sample in place on the first copy, block in place on the second
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      FirFilter_update(&filter_[0], filtered_data_[0][i],
+                       &filtered_data_[0][i]);
+    }
+    int filtered_length;
+    EXPECT_EQ(FirFilter_update_block(&filter_[1], filtered_data_[1],
+                                     filtered_data_[1], BLOCK_SIZE,
+                                     &filtered_length),
+              ModuleOK);
+    ASSERT_EQ(filtered_length, BLOCK_SIZE);
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      EXPECT_FLOAT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+    }
+  }
+}
+
+TEST_F(FirFilterTest, Benchmark) {
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    filtered_data_[0][i] = (float)((i * 37) % 100) / 50.0F;
+  }
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int filtered_length;
+    FirFilter_update_block(&filter_[0], filtered_data_[0], filtered_data_[1],
+                           BLOCK_SIZE, &filtered_length);
+    sink += filtered_data_[1][0];
+  }
+  const double sample_cost = report_benchmark(
+      "fir filter block", start, NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+  std::cout << "[ BENCHMARK] fir filter block: "
+            << NUM_TAPS * 1000.0 / sample_cost << " taps/us" << std::endl;
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* biquad filter test --------------------------------------------------------*/
+class BiquadFilterTest : public Test {
+ protected:
+  void SetUp() override {
+    // second order butterworth lowpass at 0.1 of sampling frequency
+    for (int i = 0; i < NUM_STAGES; i++) {
+      coefficients_[5 * i + 0] = 0.067455273F;
+      coefficients_[5 * i + 1] = 0.134910546F;
+      coefficients_[5 * i + 2] = 0.067455273F;
+      coefficients_[5 * i + 3] = -1.142980502F;
+      coefficients_[5 * i + 4] = 0.412801594F;
+    }
+    for (int i = 0; i < 2; i++) {
+      BiquadFilter_ctor(&filter_[i], coefficients_, state_[i], NUM_STAGES,
+                        NULL);
+    }
+  }
+
+  BiquadFilter filter_[2];
+
+  float coefficients_[5 * NUM_STAGES];
+
+  float state_[2][2 * NUM_STAGES];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(BiquadFilterTest, PassThrough) {
+  const float coefficients[5] = {1.0F, 0.0F, 0.0F, 0.0F, 0.0F};
+  float state[2];
+  BiquadFilter filter;
+  BiquadFilter_ctor(&filter, coefficients, state, 1, NULL);
+
+  for (int i = 0; i < 10; i++) {
+    float filtered_data;
+    EXPECT_EQ(BiquadFilter_update(&filter, (float)i, &filtered_data),
+              ModuleOK);
+    EXPECT_FLOAT_EQ(filtered_data, (float)i);
+  }
+}
+
+TEST_F(BiquadFilterTest, DcGain) {
+  float filtered_data;
+  for (int i = 0; i < 1000; i++) {
+    BiquadFilter_update(&filter_[0], 2.0F, NULL);
+  }
+  EXPECT_EQ(BiquadFilter_get_filtered_data(&filter_[0], &filtered_data),
+            ModuleOK);
+  EXPECT_NEAR(filtered_data, 2.0F, 1e-4);
+}
+
+TEST_F(BiquadFilterTest, Cascade) {
+  // cascaded sections equal single section filters chained together
+  BiquadFilter filter[NUM_STAGES];
+  float state[NUM_STAGES][2];
+  for (int i = 0; i < NUM_STAGES; i++) {
+    BiquadFilter_ctor(&filter[i], &coefficients_[5 * i], state[i], 1,
+                      i == 0 ? NULL : (Filter*)&filter[i - 1]);
+  }
+
+  for (int i = 0; i < 200; i++) {
+    const float data = (float)((i * 37) % 100) / 50.0F;
+    float filtered_data[2];
+    BiquadFilter_update(&filter_[0], data, &filtered_data[0]);
+    BiquadFilter_update(&filter[NUM_STAGES - 1], data, &filtered_data[1]);
+    EXPECT_FLOAT_EQ(filtered_data[0], filtered_data[1]);
+  }
+}
+
+TEST_F(BiquadFilterTest, UpdateBlock) {
+  for (int block = 0; block < 3; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[0][i] = std::sin(0.05F * (block * BLOCK_SIZE + i));
+      filtered_data_[1][i] = filtered_data_[0][i];
+    }
+
+    // per-sample in place on the first copy, block in place on the second
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      BiquadFilter_update(&filter_[0], filtered_data_[0][i],
+                          &filtered_data_[0][i]);
+    }
+    int filtered_length;
+    EXPECT_EQ(BiquadFilter_update_block(&filter_[1], filtered_data_[1],
+                                        filtered_data_[1], BLOCK_SIZE,
+                                        &filtered_length),
+              ModuleOK);
+    ASSERT_EQ(filtered_length, BLOCK_SIZE);
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      EXPECT_FLOAT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+    }
+  }
+}
+
+TEST_F(BiquadFilterTest, Benchmark) {
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    filtered_data_[0][i] = (float)((i * 37) % 100) / 50.0F;
+  }
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      BiquadFilter_update(&filter_[0], filtered_data_[0][i],
+                          &filtered_data_[1][i]);
+    }
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("per-sample biquad filter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int filtered_length;
+    BiquadFilter_update_block(&filter_[1], filtered_data_[0],
+                              filtered_data_[1], BLOCK_SIZE, &filtered_length);
+    sink += filtered_data_[1][0];
+  }
+  const double block_cost = report_benchmark(
+      "block biquad filter", start, NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+  std::cout << "[ BENCHMARK] block biquad filter: "
+            << NUM_STAGES * 1000.0 / block_cost << " sections/us"
+            << std::endl;
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* median filter test --------------------------------------------------------*/
+/// @brief Median by sorting a copy of the window for every sample, for
+/// verifying MedianFilter and comparing the per-sample cost.
+struct SortMedian {
+  std::vector<float> window;
+
+  std::vector<float> sorted;
+
+  int index;
+
+  explicit SortMedian(const int window_size)
+      : window(window_size), sorted(window_size), index(0) {}
+
+  float update(const float data) {
+    window[index] = data;
+    index = (index + 1) % (int)window.size();
+    sorted = window;
+    std::sort(sorted.begin(), sorted.end());
+    const int size = (int)sorted.size();
+    if (size % 2 == 0) {
+      return (sorted[size / 2] + sorted[size / 2 - 1]) / 2.0F;
+    }
+    return sorted[size / 2];
+  }
+};
+
+/**
+ * @brief Function to generate noisy data with spikes.
+ *
+ * @param i The index of the data.
+ * @return float The data.
+ */
+static float spiky_data(const int i) {
+  const float spike = i % 17 == 0 ? 100.0F : (i % 29 == 0 ? -100.0F : 0.0F);
+  return (float)((i * 7919) % 101) / 10.0F + spike;
+}
+
+class MedianFilterTest : public Test {
+ protected:
+  void SetUp() override {
+    MedianFilter_ctor(&filter_, buffer_, heap_buffer_, MEDIAN_WINDOW_SIZE,
+                      NULL);
+  }
+
+  MedianFilter filter_;
+
+  float buffer_[MEDIAN_FILTER_MAX_WINDOW_SIZE];
+
+  uint8_t heap_buffer_[2 * MEDIAN_FILTER_MAX_WINDOW_SIZE];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(MedianFilterTest, WindowNotFilled) {
+  float filtered_data;
+  for (int i = 0; i < MEDIAN_WINDOW_SIZE - 1; i++) {
+    EXPECT_EQ(MedianFilter_update(&filter_, 1.0F, &filtered_data), ModuleBusy);
+  }
+  EXPECT_EQ(MedianFilter_get_filtered_data(&filter_, &filtered_data),
+            ModuleBusy);
+
+  EXPECT_EQ(MedianFilter_update(&filter_, 1.0F, &filtered_data), ModuleOK);
+  EXPECT_FLOAT_EQ(filtered_data, 1.0F);
+}
+
+TEST_F(MedianFilterTest, SpikeRejection) {
+  float filtered_data;
+  for (int i = 0; i < 10 * MEDIAN_WINDOW_SIZE; i++) {
+    // single sample spike every window
+    const float data = i % MEDIAN_WINDOW_SIZE == 7 ? 1000.0F : 1.0F;
+    if (MedianFilter_update(&filter_, data, &filtered_data) == ModuleOK) {
+      EXPECT_FLOAT_EQ(filtered_data, 1.0F);
+    }
+  }
+}
+
+TEST_F(MedianFilterTest, SortMedian) {
+  const int window_sizes[] = {1, 2, 3, 16, MEDIAN_WINDOW_SIZE,
+                              MEDIAN_FILTER_MAX_WINDOW_SIZE};
+  for (const int window_size : window_sizes) {
+    MedianFilter_ctor(&filter_, buffer_, heap_buffer_, window_size, NULL);
+    SortMedian sort_median(window_size);
+
+    for (int i = 0; i < 4 * MEDIAN_FILTER_MAX_WINDOW_SIZE; i++) {
+      const float expected = sort_median.update(spiky_data(i));
+      float filtered_data;
+      if (MedianFilter_update(&filter_, spiky_data(i), &filtered_data) ==
+          ModuleOK) {
+        ASSERT_EQ(filtered_data, expected)
+            << "window size " << window_size << " at " << i;
+      } else {
+        ASSERT_LT(i, window_size - 1);
+      }
+    }
+  }
+}
+
+TEST_F(MedianFilterTest, UpdateBlock) {
+  MedianFilter filter;
+  float buffer[MEDIAN_WINDOW_SIZE];
+  uint8_t heap_buffer[2 * MEDIAN_WINDOW_SIZE];
+  MedianFilter_ctor(&filter, buffer, heap_buffer, MEDIAN_WINDOW_SIZE, NULL);
+
+  for (int block = 0; block < 3; block++) {
+    int length = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[1][i] = spiky_data(block * BLOCK_SIZE + i);
+      if (MedianFilter_update(&filter_, filtered_data_[1][i],
+                              &filtered_data_[0][length]) == ModuleOK) {
+        length++;
+      }
+    }
+
+    int filtered_length;
+    EXPECT_EQ(MedianFilter_update_block(&filter, filtered_data_[1],
+                                        filtered_data_[1], BLOCK_SIZE,
+                                        &filtered_length),
+              ModuleOK);
+    ASSERT_EQ(filtered_length, length);
+    for (int i = 0; i < length; i++) {
+      EXPECT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+    }
+  }
+}
+
+TEST_F(MedianFilterTest, Benchmark) {
+  MedianFilter_ctor(&filter_, buffer_, heap_buffer_,
+                    MEDIAN_FILTER_MAX_WINDOW_SIZE, NULL);
+  SortMedian sort_median(MEDIAN_FILTER_MAX_WINDOW_SIZE);
+  const int num_samples = NUM_BENCHMARK_SAMPLES / 100;
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_samples; i++) {
+    sink += sort_median.update(spiky_data(i));
+  }
+  report_benchmark("sort per sample median", start, num_samples);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_samples; i++) {
+    float filtered_data = 0.0F;
+    MedianFilter_update(&filter_, spiky_data(i), &filtered_data);
+    sink += filtered_data;
+  }
+  report_benchmark("heap median filter", start, num_samples);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* cic decimator test --------------------------------------------------------*/
+/**
+ * @brief Function to measure the amplitude of a tone at the output rate of a
+ * decimator by correlation over whole cycles.
+ *
+ * @param decimator The decimator, which is settled before measurement.
+ * @param frequency The frequency of the tone relative to the output rate.
+ * @param decimation The decimation ratio.
+ * @param num_outputs The number of outputs to measure, which must contain
+ * whole cycles of the tone.
+ * @return double The amplitude relative to the input amplitude.
+ */
+static double tone_gain(CicDecimator* const decimator, const double frequency,
+                        const int decimation, const int num_outputs) {
+  const double pi = std::acos(-1.0);
+  const double amplitude = 1000.0;
+  double in_phase = 0.0;
+  double quadrature = 0.0;
+  int n = 0;
+  for (int i = 0; n < num_outputs; i++) {
+    const double phase = 2.0 * pi * frequency * i / decimation;
+    float decimated_data;
+    if (CicDecimator_update(decimator, (float)(amplitude * std::sin(phase)),
+                            &decimated_data) != ModuleOK) {
+      continue;
+    }
+
+    // skip the transient of the first outputs
+    if (i >= 8 * decimation) {
+      const double output_phase = 2.0 * pi * frequency * n;
+      in_phase += decimated_data * std::cos(output_phase);
+      quadrature += decimated_data * std::sin(output_phase);
+      n++;
+    }
+  }
+  return 2.0 * std::sqrt(in_phase * in_phase + quadrature * quadrature) /
+         num_outputs / amplitude;
+}
+
+class CicDecimatorTest : public Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 2; i++) {
+      CicDecimator_ctor(&decimator_[i], CIC_ORDER, DECIMATION, false, NULL);
+      CicDecimator_ctor(&compensated_decimator_[i], CIC_ORDER, DECIMATION,
+                        true, NULL);
+    }
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      data_[i] = (float)(2048 + (i * 37) % 1000 - 500);
+    }
+  }
+
+  /**
+   * @brief Function to compute the magnitude response of the decimator.
+   *
+   * @param frequency The frequency relative to the output rate.
+   * @param compensated Whether the droop is compensated.
+   * @return double The magnitude response.
+   */
+  static double response(const double frequency, const bool compensated) {
+    const double pi = std::acos(-1.0);
+    const double sinc = std::sin(pi * frequency) /
+                        (DECIMATION * std::sin(pi * frequency / DECIMATION));
+    double magnitude = std::pow(std::fabs(sinc), CIC_ORDER);
+    if (compensated) {
+      magnitude *=
+          1.0 + CIC_ORDER / 12.0 * (1.0 - std::cos(2.0 * pi * frequency));
+    }
+    return magnitude;
+  }
+
+  CicDecimator decimator_[2];
+
+  CicDecimator compensated_decimator_[2];
+
+  float data_[BLOCK_SIZE];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(CicDecimatorTest, Decimation) {
+  float decimated_data;
+  for (int i = 1; i <= 16 * DECIMATION; i++) {
+    const ModuleRet ret =
+        CicDecimator_update(&decimator_[0], 1000.0F, &decimated_data);
+    if (i % DECIMATION != 0 || i < CIC_ORDER * DECIMATION) {
+      EXPECT_EQ(ret, ModuleBusy);
+    } else {
+      // the dc gain is exact once settled
+      EXPECT_EQ(ret, ModuleOK);
+      EXPECT_EQ(decimated_data, 1000.0F);
+    }
+  }
+  EXPECT_EQ(CicDecimator_get_filtered_data(&decimator_[0], &decimated_data),
+            ModuleOK);
+  EXPECT_EQ(CicDecimator_get_filtered_data(&decimator_[1], &decimated_data),
+            ModuleBusy);
+}
+
+TEST_F(CicDecimatorTest, FrequencyResponse) {
+  const double frequencies[4] = {0.05, 0.1, 0.2, 0.3};
+  for (int i = 0; i < 4; i++) {
+    SetUp();
+    const double frequency = frequencies[i];
+    EXPECT_NEAR(tone_gain(&decimator_[0], frequency, DECIMATION, 200),
+                response(frequency, false), 0.005);
+    EXPECT_NEAR(
+        tone_gain(&compensated_decimator_[0], frequency, DECIMATION, 200),
+        response(frequency, true), 0.005);
+
+    // compensation flattens the passband
+    EXPECT_LT(std::fabs(response(frequency, true) - 1.0),
+              std::fabs(response(frequency, false) - 1.0));
+  }
+
+  // tones at multiples of the output rate alias to dc and are rejected
+  SetUp();
+  EXPECT_LT(tone_gain(&decimator_[0], 1.0, DECIMATION, 200), 0.005);
+  EXPECT_LT(tone_gain(&decimator_[1], 2.0, DECIMATION, 200), 0.005);
+}
+
+TEST_F(CicDecimatorTest, UpdateBlock) {
+  for (int order = 1; order <= CIC_DECIMATOR_MAX_ORDER; order++) {
+    for (int compensated = 0; compensated < 2; compensated++) {
+      SetUp();
+      CicDecimator_ctor(&decimator_[0], order, DECIMATION, compensated, NULL);
+      CicDecimator_ctor(&decimator_[1], order, DECIMATION, compensated, NULL);
+
+      // blocks not aligned to the decimation
+      int count = 0;
+      for (int block = 0; block < 4; block++) {
+        int length = 0;
+        for (int i = 0; i < BLOCK_SIZE - 3; i++) {
+          if (CicDecimator_update(&decimator_[0], data_[i],
+                                  &filtered_data_[0][length]) == ModuleOK) {
+            length++;
+          }
+        }
+
+        int filtered_length;
+        EXPECT_EQ(CicDecimator_update_block(&decimator_[1], data_,
+                                            filtered_data_[1],
+                                            BLOCK_SIZE - 3, &filtered_length),
+                  ModuleOK);
+        ASSERT_EQ(filtered_length, length);
+        for (int i = 0; i < length; i++) {
+          EXPECT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+        }
+        count += length;
+      }
+      EXPECT_EQ(count, 4 * (BLOCK_SIZE - 3) / DECIMATION - order -
+                           (compensated ? 2 : 0) + 1);
+
+      // in place
+      int filtered_length;
+      CicDecimator_update_block(&decimator_[0], data_, filtered_data_[0],
+                                BLOCK_SIZE, &filtered_length);
+      CicDecimator_update_block(&decimator_[1], data_, data_, BLOCK_SIZE,
+                                &filtered_length);
+      for (int i = 0; i < filtered_length; i++) {
+        EXPECT_EQ(data_[i], filtered_data_[0][i]);
+      }
+    }
+  }
+}
+
+TEST_F(CicDecimatorTest, ChainedFilter) {
+  // decimated adc counts normalized and smoothed at the output rate
+  NormalizeFilter normalize_filter[2];
+  KalmanFilter1D kalman_filter[2];
+  FilterPipeline pipeline[2];
+  for (int i = 0; i < 2; i++) {
+    NormalizeFilter_ctor(&normalize_filter[i], 0.0F, 4095.0F, NULL);
+    KalmanFilter1D_ctor(&kalman_filter[i], 0.01F, 0.1F, 0.0F, 1.0F);
+    Filter* const stages[3] = {(Filter*)&compensated_decimator_[i],
+                               (Filter*)&normalize_filter[i],
+                               (Filter*)&kalman_filter[i]};
+    FilterPipeline_ctor(&pipeline[i], stages, 3, true, NULL);
+  }
+
+  int length = 0;
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    if (FilterPipeline_update(&pipeline[0], data_[i],
+                              &filtered_data_[0][length]) == ModuleOK) {
+      length++;
+    }
+  }
+  int filtered_length;
+  EXPECT_EQ(FilterPipeline_update_block(&pipeline[1], data_, filtered_data_[1],
+                                        BLOCK_SIZE, &filtered_length),
+            ModuleOK);
+  ASSERT_EQ(filtered_length, length);
+  EXPECT_GT(length, 0);
+  for (int i = 0; i < length; i++) {
+    EXPECT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+    EXPECT_GE(filtered_data_[1][i], 0.0F);
+    EXPECT_LE(filtered_data_[1][i], 1.0F);
+  }
+}
+
+TEST_F(CicDecimatorTest, Benchmark) {
+  float moving_average_buffer[DECIMATION];
+  MovingAverageFilter moving_average_filter;
+  MovingAverageFilter_ctor(&moving_average_filter, moving_average_buffer,
+                           DECIMATION, NULL);
+  float sink = 0.0F;
+
+  // moving average per data, keeping every decimation-th output
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int length = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      if (MovingAverageFilter_update(&moving_average_filter, data_[i],
+                                     &filtered_data_[0][length]) ==
+              ModuleOK &&
+          i % DECIMATION == DECIMATION - 1) {
+        length++;
+      }
+    }
+    sink += filtered_data_[0][0];
+  }
+  report_benchmark("moving average decimation", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      CicDecimator_update(&decimator_[0], data_[i], &filtered_data_[0][0]);
+    }
+    sink += filtered_data_[0][0];
+  }
+  report_benchmark("per-sample cic decimator", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int filtered_length;
+    CicDecimator_update_block(&compensated_decimator_[1], data_,
+                              filtered_data_[1], BLOCK_SIZE,
+                              &filtered_length);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("block cic decimator", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* savitzky golay filter test ------------------------------------------------*/
+class SavitzkyGolayFilterTest : public Test {
+ protected:
+  /**
+   * @brief Function to set up the filters with the same parameters.
+   *
+   * @param window_size The number of data to fit.
+   * @param order The order of polynomial.
+   * @param derivative The order of derivative.
+   * @param delay The evaluated point in number of data before the latest one.
+   */
+  void set_up(const int window_size, const int order, const int derivative,
+              const int delay) {
+    window_size_ = window_size;
+    for (int i = 0; i < 2; i++) {
+      SavitzkyGolayFilter_ctor(&filter_[i], coefficients_[i], delay_line_[i],
+                               window_size, order, derivative, delay,
+                               SAMPLE_PERIOD, NULL);
+    }
+  }
+
+  SavitzkyGolayFilter filter_[2];
+
+  int window_size_;
+
+  float coefficients_[2][SG_MAX_WINDOW_SIZE];
+
+  float delay_line_[2][2 * SG_MAX_WINDOW_SIZE];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(SavitzkyGolayFilterTest, Coefficients) {
+  // classic 5 point quadratic smoothing at the center
+  set_up(5, 2, 0, 2);
+  const float expected[5] = {-3.0F, 12.0F, 17.0F, 12.0F, -3.0F};
+  for (int i = 0; i < 5; i++) {
+    EXPECT_NEAR(coefficients_[0][i], expected[i] / 35.0F, 1e-6F);
+  }
+
+  // linear fit of 2 points at the latest data is the finite difference
+  set_up(2, 1, 1, 0);
+  EXPECT_NEAR(coefficients_[0][0], 1.0F / SAMPLE_PERIOD, 1e-3F);
+  EXPECT_NEAR(coefficients_[0][1], -1.0F / SAMPLE_PERIOD, 1e-3F);
+}
+
+TEST_F(SavitzkyGolayFilterTest, WindowNotFilled) {
+  set_up(SG_WINDOW_SIZE, 2, 1, 0);
+  float filtered_data;
+  for (int i = 0; i < SG_WINDOW_SIZE - 1; i++) {
+    EXPECT_EQ(SavitzkyGolayFilter_update(&filter_[0], 1.0F, &filtered_data),
+              ModuleBusy);
+  }
+  EXPECT_EQ(SavitzkyGolayFilter_get_filtered_data(&filter_[0], &filtered_data),
+            ModuleBusy);
+
+  EXPECT_EQ(SavitzkyGolayFilter_update(&filter_[0], 1.0F, &filtered_data),
+            ModuleOK);
+  EXPECT_NEAR(filtered_data, 0.0F, 1e-3F);
+}
+
+TEST_F(SavitzkyGolayFilterTest, Polynomial) {
+  // quadratic fit is exact for quadratic data at any evaluated point
+  for (int delay = 0; delay < SG_WINDOW_SIZE; delay += 3) {
+    for (int derivative = 0; derivative <= 2; derivative++) {
+      set_up(SG_WINDOW_SIZE, 2, derivative, delay);
+      for (int i = 0; i < 3 * SG_WINDOW_SIZE; i++) {
+        const float t = i * SAMPLE_PERIOD;
+        float filtered_data;
+        if (SavitzkyGolayFilter_update(&filter_[0],
+                                       1.0F + 2.0F * t + 5.0F * t * t,
+                                       &filtered_data) != ModuleOK) {
+          continue;
+        }
+
+        const float time = (i - delay) * SAMPLE_PERIOD;
+        const float expected[3] = {1.0F + 2.0F * time + 5.0F * time * time,
+                                   2.0F + 10.0F * time, 10.0F};
+        SCOPED_TRACE(delay);
+        SCOPED_TRACE(derivative);
+        EXPECT_NEAR(filtered_data, expected[derivative],
+                    1e-3F * (1.0F + std::fabs(expected[derivative])));
+      }
+    }
+  }
+}
+
+TEST_F(SavitzkyGolayFilterTest, NoisyDerivative) {
+  // derivative of a noisy ramp against finite difference
+  set_up(SG_WINDOW_SIZE, 2, 1, SG_WINDOW_SIZE / 2);
+  double sg_error = 0.0;
+  double difference_error = 0.0;
+  float last_data = 0.0F;
+  int count = 0;
+  for (int i = 0; i < 10 * SG_WINDOW_SIZE; i++) {
+    const float noise = (float)((i * 7919) % 101 - 50) / 5000.0F;
+    const float data = 3.0F * i * SAMPLE_PERIOD + noise;
+    float filtered_data;
+    if (SavitzkyGolayFilter_update(&filter_[0], data, &filtered_data) ==
+        ModuleOK) {
+      const float difference = (data - last_data) / SAMPLE_PERIOD;
+      sg_error += (filtered_data - 3.0F) * (filtered_data - 3.0F);
+      difference_error += (difference - 3.0F) * (difference - 3.0F);
+      count++;
+    }
+    last_data = data;
+  }
+  ASSERT_GT(count, 0);
+  EXPECT_LT(10.0 * sg_error, difference_error);
+}
+
+TEST_F(SavitzkyGolayFilterTest, UpdateBlock) {
+  set_up(SG_WINDOW_SIZE, 3, 1, 0);
+  for (int block = 0; block < 3; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[1][i] = std::sin(0.05F * (block * BLOCK_SIZE + i));
+    }
+
+    int length = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      if (SavitzkyGolayFilter_update(&filter_[0], filtered_data_[1][i],
+                                     &filtered_data_[0][length]) ==
+          ModuleOK) {
+        length++;
+      }
+    }
+
+    int filtered_length;
+    EXPECT_EQ(SavitzkyGolayFilter_update_block(&filter_[1], filtered_data_[1],
+                                               filtered_data_[1], BLOCK_SIZE,
+                                               &filtered_length),
+              ModuleOK);
+    ASSERT_EQ(filtered_length, length);
+    for (int i = 0; i < length; i++) {
+      EXPECT_FLOAT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+    }
+  }
+}
+
+TEST_F(SavitzkyGolayFilterTest, Benchmark) {
+  set_up(SG_WINDOW_SIZE, 2, 1, 0);
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    filtered_data_[0][i] = (float)((i * 37) % 100) / 50.0F;
+  }
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      SavitzkyGolayFilter_update(&filter_[0], filtered_data_[0][i],
+                                 &filtered_data_[1][i]);
+    }
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("savitzky golay filter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int filtered_length;
+    SavitzkyGolayFilter_update_block(&filter_[1], filtered_data_[0],
+                                     filtered_data_[1], BLOCK_SIZE,
+                                     &filtered_length);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("savitzky golay filter block", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* slew rate limiter test ----------------------------------------------------*/
+class SlewRateLimiterTest : public Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; i < 2; i++) {
+      SlewRateLimiter_ctor(&limiter_[i], 0.1F, 0.0F, NULL);
+    }
+  }
+
+  SlewRateLimiter limiter_[2];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(SlewRateLimiterTest, Ramp) {
+  float filtered_data;
+  EXPECT_EQ(SlewRateLimiter_get_filtered_data(&limiter_[0], &filtered_data),
+            ModuleOK);
+  EXPECT_EQ(filtered_data, 0.0F);
+
+  // ramps up and down at the same rate
+  for (int i = 1; i <= 15; i++) {
+    EXPECT_EQ(SlewRateLimiter_update(&limiter_[0], 1.0F, &filtered_data),
+              ModuleOK);
+    EXPECT_NEAR(filtered_data, i < 10 ? 0.1F * i : 1.0F, 1e-5F);
+  }
+  for (int i = 1; i <= 25; i++) {
+    SlewRateLimiter_update(&limiter_[0], -1.0F, &filtered_data);
+    EXPECT_NEAR(filtered_data, i < 20 ? 1.0F - 0.1F * i : -1.0F, 1e-5F);
+  }
+
+  // small changes pass through
+  SlewRateLimiter_update(&limiter_[0], -0.95F, &filtered_data);
+  EXPECT_EQ(filtered_data, -0.95F);
+}
+
+TEST_F(SlewRateLimiterTest, ResetAndMaxStep) {
+  float filtered_data;
+  SlewRateLimiter_reset(&limiter_[0], 0.5F);
+  SlewRateLimiter_update(&limiter_[0], 0.5F, &filtered_data);
+  EXPECT_EQ(filtered_data, 0.5F);
+
+  SlewRateLimiter_set_max_step(&limiter_[0], 0.25F);
+  SlewRateLimiter_update(&limiter_[0], 2.0F, &filtered_data);
+  EXPECT_EQ(filtered_data, 0.75F);
+}
+
+TEST_F(SlewRateLimiterTest, UpdateBlock) {
+  for (int block = 0; block < 3; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[0][i] = 3.0F * std::sin(0.02F * (block * BLOCK_SIZE + i));
+      filtered_data_[1][i] = filtered_data_[0][i];
+    }
+
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      SlewRateLimiter_update(&limiter_[0], filtered_data_[0][i],
+                             &filtered_data_[0][i]);
+    }
+    int filtered_length;
+    EXPECT_EQ(SlewRateLimiter_update_block(&limiter_[1], filtered_data_[1],
+                                           filtered_data_[1], BLOCK_SIZE,
+                                           &filtered_length),
+              ModuleOK);
+    ASSERT_EQ(filtered_length, BLOCK_SIZE);
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      EXPECT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+    }
+  }
+}
+
+TEST_F(SlewRateLimiterTest, Benchmark) {
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    filtered_data_[0][i] = (float)((i * 37) % 100) / 50.0F;
+  }
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      SlewRateLimiter_update(&limiter_[0], filtered_data_[0][i],
+                             &filtered_data_[1][i]);
+    }
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("slew rate limiter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int filtered_length;
+    SlewRateLimiter_update_block(&limiter_[1], filtered_data_[0],
+                                 filtered_data_[1], BLOCK_SIZE,
+                                 &filtered_length);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("slew rate limiter block", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* filter pipeline test ------------------------------------------------------*/
+class FilterPipelineTest : public Test {
+ protected:
+  void SetUp() override {
+    // second order butterworth lowpass at 0.1 of sampling frequency
+    const float coefficients[5] = {0.067455273F, 0.134910546F, 0.067455273F,
+                                   -1.142980502F, 0.412801594F};
+    for (int i = 0; i < 5; i++) {
+      coefficients_[i] = coefficients[i];
+    }
+
+    // filters chained by chained_filter as reference
+    MovingAverageFilter_ctor(&moving_average_filter_[0], buffer_[0],
+                             WINDOW_SIZE, NULL);
+    NormalizeFilter_ctor(&normalize_filter_[0], 0.0F, 1.0F,
+                         (Filter*)&moving_average_filter_[0]);
+    BiquadFilter_ctor(&biquad_filter_[0], coefficients_, state_[0], 1,
+                      (Filter*)&normalize_filter_[0]);
+
+    for (int i = 1; i < 3; i++) {
+      MovingAverageFilter_ctor(&moving_average_filter_[i], buffer_[i],
+                               WINDOW_SIZE, NULL);
+      NormalizeFilter_ctor(&normalize_filter_[i], 0.0F, 1.0F, NULL);
+      BiquadFilter_ctor(&biquad_filter_[i], coefficients_, state_[i], 1, NULL);
+      Filter* const stages[3] = {(Filter*)&moving_average_filter_[i],
+                                 (Filter*)&normalize_filter_[i],
+                                 (Filter*)&biquad_filter_[i]};
+      FilterPipeline_ctor(&pipeline_[i], stages, 3, i == 2, NULL);
+    }
+  }
+
+  MovingAverageFilter moving_average_filter_[3];
+
+  NormalizeFilter normalize_filter_[3];
+
+  BiquadFilter biquad_filter_[3];
+
+  /// @brief Unfused pipeline at 1 and fused pipeline at 2.
+  FilterPipeline pipeline_[3];
+
+  float buffer_[3][WINDOW_SIZE];
+
+  float coefficients_[5];
+
+  float state_[3][2];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(FilterPipelineTest, WarmUp) {
+  float filtered_data;
+  for (int i = 1; i < 3; i++) {
+    for (int j = 0; j < WINDOW_SIZE - 1; j++) {
+      EXPECT_EQ(FilterPipeline_update(&pipeline_[i], 1.0F, &filtered_data),
+                ModuleBusy);
+    }
+    EXPECT_EQ(FilterPipeline_get_filtered_data(&pipeline_[i], &filtered_data),
+              ModuleBusy);
+
+    // the later stages only see data once the moving average is ready
+    EXPECT_EQ(FilterPipeline_update(&pipeline_[i], 1.0F, &filtered_data),
+              ModuleOK);
+    EXPECT_FLOAT_EQ(filtered_data, 0.067455273F);
+    EXPECT_EQ(FilterPipeline_get_filtered_data(&pipeline_[i], &filtered_data),
+              ModuleOK);
+  }
+}
+
+TEST_F(FilterPipelineTest, ChainedFilter) {
+  for (int i = 0; i < 10 * WINDOW_SIZE; i++) {
+    const float data = (float)((i * 37) % 100) / 50.0F - 0.5F;
+    float filtered_data[3];
+    ModuleRet ret[3];
+    ret[0] = BiquadFilter_update(&biquad_filter_[0], data, &filtered_data[0]);
+    for (int j = 1; j < 3; j++) {
+      ret[j] = FilterPipeline_update(&pipeline_[j], data, &filtered_data[j]);
+      ASSERT_EQ(ret[j], ret[0]);
+      if (ret[0] == ModuleOK) {
+        EXPECT_EQ(filtered_data[j], filtered_data[0]);
+      }
+    }
+  }
+}
+
+TEST_F(FilterPipelineTest, PartialWindow) {
+  // fused moving average follows partial mode of the stage
+  for (int i = 0; i < 3; i++) {
+    MovingAverageFilter_set_partial(&moving_average_filter_[i], true);
+  }
+  for (int i = 0; i < WINDOW_SIZE; i++) {
+    const float data = (float)((i * 37) % 100) / 50.0F - 0.5F;
+    float filtered_data[3];
+    ASSERT_EQ(BiquadFilter_update(&biquad_filter_[0], data, &filtered_data[0]),
+              ModuleOK);
+    ASSERT_EQ(FilterPipeline_update(&pipeline_[1], data, &filtered_data[1]),
+              ModuleOK);
+    filtered_data_[0][i] = data;
+    EXPECT_EQ(filtered_data[1], filtered_data[0]);
+  }
+
+  int filtered_length;
+  EXPECT_EQ(FilterPipeline_update_block(&pipeline_[2], filtered_data_[0],
+                                        filtered_data_[1], WINDOW_SIZE,
+                                        &filtered_length),
+            ModuleOK);
+  EXPECT_EQ(filtered_length, WINDOW_SIZE);
+  float filtered_data;
+  EXPECT_EQ(FilterPipeline_get_filtered_data(&pipeline_[1], &filtered_data),
+            ModuleOK);
+  EXPECT_EQ(filtered_data_[1][WINDOW_SIZE - 1], filtered_data);
+}
+
+TEST_F(FilterPipelineTest, UpdateBlock) {
+  for (int block = 0; block < 3; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[1][i] =
+          (float)((i * 37 + block * 11) % 100) / 50.0F - 0.5F;
+    }
+
+    int length = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      if (BiquadFilter_update(&biquad_filter_[0], filtered_data_[1][i],
+                              &filtered_data_[0][length]) == ModuleOK) {
+        length++;
+      }
+    }
+
+    int filtered_length;
+    EXPECT_EQ(FilterPipeline_update_block(&pipeline_[2], filtered_data_[1],
+                                          filtered_data_[1], BLOCK_SIZE,
+                                          &filtered_length),
+              ModuleOK);
+    ASSERT_EQ(filtered_length, length);
+    for (int i = 0; i < length; i++) {
+      EXPECT_EQ(filtered_data_[1][i], filtered_data_[0][i]);
+    }
+  }
+}
+
+TEST_F(FilterPipelineTest, Benchmark) {
+  float sink = 0.0F;
+  float filtered_data = 0.0F;
+
+  // per sample against per sample
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    BiquadFilter_update(&biquad_filter_[0], (float)(i & 0xFF), &filtered_data);
+    sink += filtered_data;
+  }
+  report_benchmark("3 stage chained filter", start, NUM_BENCHMARK_SAMPLES);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    FilterPipeline_update(&pipeline_[1], (float)(i & 0xFF), &filtered_data);
+    sink += filtered_data;
+  }
+  report_benchmark("3 stage pipeline", start, NUM_BENCHMARK_SAMPLES);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    FilterPipeline_update(&pipeline_[2], (float)(i & 0xFF), &filtered_data);
+    sink += filtered_data;
+  }
+  report_benchmark("3 stage fused pipeline", start, NUM_BENCHMARK_SAMPLES);
+
+  // block against block
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    filtered_data_[0][i] = (float)(i & 0xFF);
+  }
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int filtered_length;
+    Filter_update_block((Filter*)&biquad_filter_[0], filtered_data_[0],
+                        filtered_data_[1], BLOCK_SIZE, &filtered_length);
+    sink += filtered_data_[1][0];
+  }
+  report_benchmark("3 stage chained filter block", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  for (int i = 1; i < 3; i++) {
+    start = std::chrono::steady_clock::now();
+    for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+      int filtered_length;
+      FilterPipeline_update_block(&pipeline_[i], filtered_data_[0],
+                                  filtered_data_[1], BLOCK_SIZE,
+                                  &filtered_length);
+      sink += filtered_data_[1][0];
+    }
+    report_benchmark(
+        i == 1 ? "3 stage pipeline block" : "3 stage fused pipeline block",
+        start, NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+  }
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+/* filter publisher test -----------------------------------------------------*/
+class FilterPublisherTest : public Test {
+ protected:
+  void SetUp() override {
+    MovingAverageFilter_ctor(&moving_average_filter_, buffer_, WINDOW_SIZE,
+                             NULL);
+    FilterPublisher_ctor(&publisher_, (Filter*)&moving_average_filter_);
+
+    // kalman filter without measurement noise passes data through
+    KalmanFilter1D_ctor(&kalman_filter_, 0.01F, 0.0F, 0.0F, 1.0F);
+    FilterPublisher_ctor(&pass_through_publisher_, (Filter*)&kalman_filter_);
+  }
+
+  MovingAverageFilter moving_average_filter_;
+
+  KalmanFilter1D kalman_filter_;
+
+  FilterPublisher publisher_;
+
+  FilterPublisher pass_through_publisher_;
+
+  float buffer_[WINDOW_SIZE];
+
+  float filtered_data_[BLOCK_SIZE];
+};
+
+TEST_F(FilterPublisherTest, NotPublished) {
+  float filtered_data;
+  struct filter_snapshot snapshot;
+  EXPECT_EQ(FilterPublisher_get_filtered_data(&publisher_, &filtered_data),
+            ModuleBusy);
+  EXPECT_EQ(FilterPublisher_get_snapshot(&publisher_, &snapshot), ModuleBusy);
+
+  for (int i = 0; i < WINDOW_SIZE - 1; i++) {
+    EXPECT_EQ(FilterPublisher_update(&publisher_, 1.0F, &filtered_data),
+              ModuleBusy);
+  }
+  EXPECT_EQ(FilterPublisher_get_snapshot(&publisher_, &snapshot), ModuleBusy);
+  EXPECT_EQ(FilterPublisher_get_publish_count(&publisher_), 0);
+}
+
+TEST_F(FilterPublisherTest, Publish) {
+  struct filter_snapshot snapshot = {0.0F, 0, 0};
+  TickType_t last_timestamp = 0;
+  uint32_t publish_count = 0;
+  for (int i = 0; i < 4 * WINDOW_SIZE; i++) {
+    float filtered_data;
+    if (FilterPublisher_update(&publisher_, (float)i, &filtered_data) !=
+        ModuleOK) {
+      continue;
+    }
+    publish_count++;
+
+    ASSERT_EQ(FilterPublisher_get_snapshot(&publisher_, &snapshot), ModuleOK);
+    EXPECT_EQ(snapshot.filtered_data, filtered_data);
+    EXPECT_EQ(snapshot.publish_count, publish_count);
+    EXPECT_GE(snapshot.timestamp, last_timestamp);
+    last_timestamp = snapshot.timestamp;
+
+    float published_data;
+    EXPECT_EQ(
+        FilterPublisher_get_filtered_data(&publisher_, &published_data),
+        ModuleOK);
+    EXPECT_EQ(published_data, filtered_data);
+  }
+  EXPECT_EQ(FilterPublisher_get_publish_count(&publisher_),
+            3 * WINDOW_SIZE + 1);
+}
+
+TEST_F(FilterPublisherTest, UpdateBlock) {
+  for (int block = 0; block < 3; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[i] = (float)(i + block * BLOCK_SIZE);
+    }
+
+    int filtered_length;
+    EXPECT_EQ(FilterPublisher_update_block(&publisher_, filtered_data_,
+                                           filtered_data_, BLOCK_SIZE,
+                                           &filtered_length),
+              ModuleOK);
+    ASSERT_GT(filtered_length, 0);
+
+    // only the last filtered data of each block is published
+    struct filter_snapshot snapshot;
+    ASSERT_EQ(FilterPublisher_get_snapshot(&publisher_, &snapshot), ModuleOK);
+    EXPECT_EQ(snapshot.filtered_data, filtered_data_[filtered_length - 1]);
+    EXPECT_EQ(snapshot.publish_count, (uint32_t)block + 1);
+  }
+}
+
+/**
+ * @brief Task reading snapshots, which preempts the publishing test task at a
+ * tick in the middle of its updates, as an interrupt would.
+ */
+struct snapshot_reader {
+  Task super_;
+
+  FilterPublisher* publisher_;
+
+  volatile bool is_stopped_;
+
+  volatile int num_read_;
+
+  volatile int num_inconsistent_;
+
+  StackType_t task_stack_[4 * configMINIMAL_STACK_SIZE];
+};
+
+static void snapshot_reader_task_code(void* const _self) {
+  struct snapshot_reader* const self = (struct snapshot_reader*)_self;
+
+  // read once per tick, so that the test task publishes in between
+  while (!self->is_stopped_) {
+    struct filter_snapshot snapshot;
+    if (FilterPublisher_get_snapshot(self->publisher_, &snapshot) ==
+        ModuleOK) {
+      // data of one publication never comes with the count of another
+      if (snapshot.filtered_data != (float)(snapshot.publish_count - 1)) {
+        self->num_inconsistent_++;
+      }
+      self->num_read_++;
+    }
+    vTaskDelay(1);
+  }
+  vTaskSuspend(NULL);
+}
+
+TEST_F(FilterPublisherTest, ConcurrentRead) {
+  // start the reader before the first publication
+  struct snapshot_reader reader;
+  Task_ctor(&reader.super_, snapshot_reader_task_code);
+  reader.publisher_ = &pass_through_publisher_;
+  reader.is_stopped_ = false;
+  reader.num_read_ = 0;
+  reader.num_inconsistent_ = 0;
+  Task_create_freertos_task(&reader.super_, "snapshot_reader",
+                            TaskPriorityHigh, reader.task_stack_,
+                            4 * configMINIMAL_STACK_SIZE);
+
+  // publish without blocking, hence only preempted by the reader
+  const TickType_t start_tick = xTaskGetTickCount();
+  uint32_t num_published = 0;
+  while (xTaskGetTickCount() - start_tick < NUM_PUBLISH_TICKS) {
+    FilterPublisher_update(&pass_through_publisher_, (float)num_published,
+                           NULL);
+    num_published++;
+  }
+  const int num_read = reader.num_read_;
+  reader.is_stopped_ = true;
+  vTaskDelay(2);
+  Task_delete(&reader.super_);
+
+  EXPECT_GT(num_read, 0);
+  EXPECT_EQ(reader.num_inconsistent_, 0);
+  EXPECT_EQ(FilterPublisher_get_publish_count(&pass_through_publisher_),
+            num_published);
+}
+
+int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }
@@ -0,0 +1,351 @@
+// stl include
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+extern "C" {
+// freertos include
+#include "FreeRTOS.h"
+
+// stm32_module include
+#include "stm32_module/stm32_module.h"
+}
+
+// gtest include
+#include "gtest/gtest.h"
+
+// mock include
+#include "mock/mock.hpp"
+
+using ::testing::Test;
+
+/* macro ---------------------------------------------------------------------*/
+#define WINDOW_SIZE 16
+#define NUM_SAMPLES 10000
+#define BLOCK_SIZE 256
+#define NUM_BENCHMARK_BLOCKS 4000
+
+// error of one least significant bit
+#define Q15_LSB (1.0F / 32768.0F)
+
+/* benchmark helper ----------------------------------------------------------*/
+/**
+ * @brief Function to print the cost per sample of a benchmark.
+ *
+ * @param name The name of the benchmark.
+ * @param start The start time of the benchmark.
+ * @param num_samples The number of samples processed.
+ * @return double Cost per sample in ns.
+ */
+static double report_benchmark(
+    const char* name, const std::chrono::steady_clock::time_point start,
+    const int num_samples) {
+  const double ns_per_sample =
+      std::chrono::duration<double, std::nano>(
+          std::chrono::steady_clock::now() - start)
+          .count() /
+      num_samples;
+  std::cout << "[ BENCHMARK] " << name << ": " << ns_per_sample
+            << " ns/sample" << std::endl;
+  return ns_per_sample;
+}
+
+/**
+ * @brief Function to generate test signal, which is representable in Q15.
+ *
+ * @param i The index of the sample.
+ * @return float The sample.
+ */
+static float test_signal(const int i) {
+  return Q15_to_float(
+      Q15_from_float(0.9F * std::sin(0.01F * i) + 0.05F * std::sin(1.3F * i)));
+}
+
+/* conversion test -----------------------------------------------------------*/
+TEST(FixedPointConversionTest, Q15) {
+  EXPECT_EQ(Q15_from_float(0.0F), 0);
+  EXPECT_EQ(Q15_from_float(0.5F), 0x4000);
+  EXPECT_EQ(Q15_from_float(-1.0F), Q15_MIN);
+  EXPECT_EQ(Q15_from_float(1.0F), Q15_MAX);
+  EXPECT_EQ(Q15_from_float(-2.0F), Q15_MIN);
+  EXPECT_EQ(Q15_from_float(0.6F * Q15_LSB), 1);
+  EXPECT_EQ(Q15_from_float(-0.6F * Q15_LSB), -1);
+  EXPECT_FLOAT_EQ(Q15_to_float(0x4000), 0.5F);
+  EXPECT_FLOAT_EQ(Q15_to_float(Q15_MIN), -1.0F);
+}
+
+TEST(FixedPointConversionTest, Q31) {
+  EXPECT_EQ(Q31_from_float(0.0F), 0);
+  EXPECT_EQ(Q31_from_float(0.5F), 0x40000000L);
+  EXPECT_EQ(Q31_from_float(-1.0F), Q31_MIN);
+  EXPECT_EQ(Q31_from_float(1.0F), Q31_MAX);
+  EXPECT_EQ(Q31_from_float(2.0F), Q31_MAX);
+  EXPECT_FLOAT_EQ(Q31_to_float(0x40000000L), 0.5F);
+  EXPECT_FLOAT_EQ(Q31_to_float(Q31_MIN), -1.0F);
+}
+
+TEST(FixedPointConversionTest, Block) {
+  const float data[4] = {-1.0F, -0.25F, 0.25F, 0.5F};
+  q15_t q15_data[4];
+  q31_t q31_data[4];
+  float converted_data[4];
+
+  Q15_from_float_block(data, q15_data, 4);
+  Q15_to_float_block(q15_data, converted_data, 4);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_FLOAT_EQ(converted_data[i], data[i]);
+  }
+
+  Q31_from_float_block(data, q31_data, 4);
+  Q31_to_float_block(q31_data, converted_data, 4);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_FLOAT_EQ(converted_data[i], data[i]);
+  }
+}
+
+/* fixed point filter test ---------------------------------------------------*/
+class FixedPointFilterTest : public Test {
+ protected:
+  void SetUp() override {
+    MovingAverageFilter_ctor(&moving_average_filter_, float_buffer_,
+                             WINDOW_SIZE, NULL);
+    MovingAverageFilterQ15_ctor(&moving_average_filter_q15_, q15_buffer_,
+                                WINDOW_SIZE, NULL);
+    MovingAverageFilterQ31_ctor(&moving_average_filter_q31_, q31_buffer_,
+                                WINDOW_SIZE, NULL);
+    NormalizeFilter_ctor(&normalize_filter_, -0.5F, 0.5F, NULL);
+    NormalizeFilterQ15_ctor(&normalize_filter_q15_, Q15_from_float(-0.5F),
+                            Q15_from_float(0.5F), NULL);
+    NormalizeFilterQ31_ctor(&normalize_filter_q31_, Q31_from_float(-0.5F),
+                            Q31_from_float(0.5F), NULL);
+    KalmanFilter1D_ctor(&kalman_filter_, 0.0001F, 0.01F, 0.0F, 0.5F);
+    KalmanFilter1DQ15_ctor(&kalman_filter_q15_, Q31_from_float(0.0001F),
+                           Q31_from_float(0.01F), 0, Q31_from_float(0.5F));
+    KalmanFilter1DQ31_ctor(&kalman_filter_q31_, Q31_from_float(0.0001F),
+                           Q31_from_float(0.01F), 0, Q31_from_float(0.5F));
+  }
+
+  float float_buffer_[WINDOW_SIZE];
+
+  q15_t q15_buffer_[WINDOW_SIZE];
+
+  q31_t q31_buffer_[WINDOW_SIZE];
+
+  MovingAverageFilter moving_average_filter_;
+
+  MovingAverageFilterQ15 moving_average_filter_q15_;
+
+  MovingAverageFilterQ31 moving_average_filter_q31_;
+
+  NormalizeFilter normalize_filter_;
+
+  NormalizeFilterQ15 normalize_filter_q15_;
+
+  NormalizeFilterQ31 normalize_filter_q31_;
+
+  KalmanFilter1D kalman_filter_;
+
+  KalmanFilter1DQ15 kalman_filter_q15_;
+
+  KalmanFilter1DQ31 kalman_filter_q31_;
+};
+
+TEST_F(FixedPointFilterTest, MovingAverageFilter) {
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    const float data = test_signal(i);
+    float expected;
+    q15_t q15_filtered_data;
+    q31_t q31_filtered_data;
+
+    const ModuleRet ret =
+        MovingAverageFilter_update(&moving_average_filter_, data, &expected);
+    EXPECT_EQ(MovingAverageFilterQ15_update(&moving_average_filter_q15_,
+                                            Q15_from_float(data),
+                                            &q15_filtered_data),
+              ret);
+    EXPECT_EQ(MovingAverageFilterQ31_update(&moving_average_filter_q31_,
+                                            Q31_from_float(data),
+                                            &q31_filtered_data),
+              ret);
+    if (ret == ModuleOK) {
+      EXPECT_NEAR(Q15_to_float(q15_filtered_data), expected, Q15_LSB);
+      EXPECT_NEAR(Q31_to_float(q31_filtered_data), expected, 1e-6F);
+    }
+  }
+}
+
+TEST_F(FixedPointFilterTest, NormalizeFilter) {
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    const float data = test_signal(i);
+    float expected;
+    q15_t q15_filtered_data;
+    q31_t q31_filtered_data;
+
+    NormalizeFilter_update(&normalize_filter_, data, &expected);
+    NormalizeFilterQ15_update(&normalize_filter_q15_, Q15_from_float(data),
+                              &q15_filtered_data);
+    NormalizeFilterQ31_update(&normalize_filter_q31_, Q31_from_float(data),
+                              &q31_filtered_data);
+    EXPECT_NEAR(Q15_to_float(q15_filtered_data), expected, 2 * Q15_LSB);
+    EXPECT_NEAR(Q31_to_float(q31_filtered_data), expected, 1e-6F);
+  }
+}
+
+TEST_F(FixedPointFilterTest, KalmanFilter1D) {
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    const float data = test_signal(i);
+    const float expected = KalmanFilter1D_update(&kalman_filter_, data);
+
+    EXPECT_NEAR(Q15_to_float(KalmanFilter1DQ15_update(&kalman_filter_q15_,
+                                                      Q15_from_float(data))),
+                expected, 4 * Q15_LSB);
+    EXPECT_NEAR(Q31_to_float(KalmanFilter1DQ31_update(&kalman_filter_q31_,
+                                                      Q31_from_float(data))),
+                expected, 1e-6F);
+  }
+  EXPECT_NEAR(
+      Q31_to_float(KalmanFilter1DQ15_get_covariance(&kalman_filter_q15_)),
+      KalmanFilter1D_get_covariance(&kalman_filter_), 1e-6F);
+}
+
+TEST_F(FixedPointFilterTest, KalmanFilter1DSlowRamp) {
+  // small gain, so that the correction is less than 1 LSB of Q15 per sample
+  KalmanFilter1D_ctor(&kalman_filter_, 1e-7F, 1e-3F, 0.0F, 0.5F);
+  KalmanFilter1DQ15_ctor(&kalman_filter_q15_, Q31_from_float(1e-7F),
+                         Q31_from_float(1e-3F), 0, Q31_from_float(0.5F));
+
+  // ramp of 1 LSB per 64 samples, the float filter lags behind by the same
+  float error_sum = 0.0F;
+  int num_errors = 0;
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    const q15_t z = (q15_t)(i / 64);
+    const float expected =
+        KalmanFilter1D_update(&kalman_filter_, Q15_to_float(z));
+    const float x =
+        Q15_to_float(KalmanFilter1DQ15_update(&kalman_filter_q15_, z));
+
+    // skip the transient before the gain converges
+    if (i >= NUM_SAMPLES / 4) {
+      EXPECT_NEAR(x, expected, Q15_LSB);
+      error_sum += x - expected;
+      num_errors++;
+    }
+  }
+  EXPECT_NEAR(error_sum / num_errors, 0.0F, 0.1F * Q15_LSB);
+}
+
+TEST_F(FixedPointFilterTest, UpdateBlock) {
+  q15_t data[BLOCK_SIZE];
+  q15_t filtered_data[BLOCK_SIZE];
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    data[i] = Q15_from_float(test_signal(i));
+  }
+
+  int length = 0;
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    if (MovingAverageFilterQ15_update(&moving_average_filter_q15_, data[i],
+                                      &filtered_data[length]) == ModuleOK) {
+      length++;
+    }
+  }
+
+  // in place
+  MovingAverageFilterQ15 moving_average_filter;
+  q15_t buffer[WINDOW_SIZE];
+  MovingAverageFilterQ15_ctor(&moving_average_filter, buffer, WINDOW_SIZE,
+                              NULL);
+  int filtered_length;
+  EXPECT_EQ(MovingAverageFilterQ15_update_block(&moving_average_filter, data,
+                                                data, BLOCK_SIZE,
+                                                &filtered_length),
+            ModuleOK);
+  ASSERT_EQ(filtered_length, length);
+  for (int i = 0; i < length; i++) {
+    EXPECT_EQ(data[i], filtered_data[i]);
+  }
+}
+
+TEST_F(FixedPointFilterTest, MixedChain) {
+  // float moving average chained before Q15 normalize, and vice versa
+  NormalizeFilterQ15_ctor(&normalize_filter_q15_, Q15_from_float(-0.5F),
+                          Q15_from_float(0.5F),
+                          (Filter*)&moving_average_filter_);
+  NormalizeFilter_ctor(&normalize_filter_, -0.5F, 0.5F,
+                       (Filter*)&moving_average_filter_q15_);
+
+  float data[BLOCK_SIZE];
+  float q15_chain_data[BLOCK_SIZE];
+  float float_chain_data[BLOCK_SIZE];
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    data[i] = 0.4F * test_signal(i);
+  }
+
+  int q15_chain_length;
+  int float_chain_length;
+  EXPECT_EQ(Filter_update_block((Filter*)&normalize_filter_q15_, data,
+                                q15_chain_data, BLOCK_SIZE, &q15_chain_length),
+            ModuleOK);
+  EXPECT_EQ(Filter_update_block((Filter*)&normalize_filter_, data,
+                                float_chain_data, BLOCK_SIZE,
+                                &float_chain_length),
+            ModuleOK);
+  ASSERT_EQ(q15_chain_length, BLOCK_SIZE - WINDOW_SIZE + 1);
+  ASSERT_EQ(float_chain_length, q15_chain_length);
+  for (int i = 0; i < q15_chain_length; i++) {
+    EXPECT_NEAR(q15_chain_data[i], float_chain_data[i], 4 * Q15_LSB);
+  }
+}
+
+TEST_F(FixedPointFilterTest, Benchmark) {
+  float float_data[BLOCK_SIZE];
+  q15_t q15_data[BLOCK_SIZE];
+  q31_t q31_data[BLOCK_SIZE];
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    float_data[i] = test_signal(i);
+  }
+  Q15_from_float_block(float_data, q15_data, BLOCK_SIZE);
+  Q31_from_float_block(float_data, q31_data, BLOCK_SIZE);
+
+  // host has fast fpu and divider, hence only for reference of the relative
+  // cost on the target
+  int filtered_length;
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    MovingAverageFilter_update_block(&moving_average_filter_, float_data,
+                                     float_data, BLOCK_SIZE,
+                                     &filtered_length);
+  }
+  report_benchmark("float moving average", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    MovingAverageFilterQ15_update_block(&moving_average_filter_q15_, q15_data,
+                                        q15_data, BLOCK_SIZE,
+                                        &filtered_length);
+  }
+  report_benchmark("q15 moving average", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    MovingAverageFilterQ31_update_block(&moving_average_filter_q31_, q31_data,
+                                        q31_data, BLOCK_SIZE,
+                                        &filtered_length);
+  }
+  report_benchmark("q31 moving average", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    KalmanFilter1DQ15_update_block(&kalman_filter_q15_, q15_data, q15_data,
+                                   BLOCK_SIZE, &filtered_length);
+  }
+  report_benchmark("q15 kalman filter", start,
+                   NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+
+  EXPECT_EQ(filtered_length, BLOCK_SIZE);
+}
+
+int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }
@@ -0,0 +1,277 @@
+// stl include
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+extern "C" {
+// freertos include
+#include "FreeRTOS.h"
+
+// stm32_module include
+#include "stm32_module/stm32_module.h"
+}
+
+// gtest include
+#include "gtest/gtest.h"
+
+// mock include
+#include "mock/mock.hpp"
+
+using ::testing::Test;
+
+/* macro ---------------------------------------------------------------------*/
+#define MAX_NUM_STATES KALMAN_FILTER_MAX_NUM_STATES
+#define NUM_STEPS 200
+#define NUM_BENCHMARK_STEPS 200000
+
+/* reference implementation --------------------------------------------------*/
+/// @brief Kalman filter in double with vector measurement by matrix inversion,
+/// for verifying KalmanFilter.
+struct ReferenceKalmanFilter {
+  int n;
+
+  double x[MAX_NUM_STATES];
+
+  double P[MAX_NUM_STATES][MAX_NUM_STATES];
+
+  void predict(const float* F, const float* Q) {
+    double Fx[MAX_NUM_STATES] = {0};
+    double FP[MAX_NUM_STATES][MAX_NUM_STATES] = {{0}};
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        Fx[i] += F[i * n + j] * x[j];
+        for (int k = 0; k < n; k++) {
+          FP[i][j] += F[i * n + k] * P[k][j];
+        }
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      x[i] = Fx[i];
+      for (int j = 0; j < n; j++) {
+        P[i][j] = Q[i * n + j];
+        for (int k = 0; k < n; k++) {
+          P[i][j] += FP[i][k] * F[j * n + k];
+        }
+      }
+    }
+  }
+
+  // update with 1 or 2 measurements of diagonal noise in one step
+  void update(const float* H, const float* R, const float* z, const int m) {
+    double PH[MAX_NUM_STATES][2] = {{0}};
+    double S[2][2] = {{0}};
+    double y[2];
+    for (int a = 0; a < m; a++) {
+      y[a] = z[a];
+      for (int i = 0; i < n; i++) {
+        y[a] -= H[a * n + i] * x[i];
+        for (int j = 0; j < n; j++) {
+          PH[i][a] += P[i][j] * H[a * n + j];
+        }
+      }
+    }
+    for (int a = 0; a < m; a++) {
+      for (int b = 0; b < m; b++) {
+        S[a][b] = a == b ? R[a] : 0.0;
+        for (int i = 0; i < n; i++) {
+          S[a][b] += H[a * n + i] * PH[i][b];
+        }
+      }
+    }
+    double S_inv[2][2];
+    if (m == 1) {
+      S_inv[0][0] = 1.0 / S[0][0];
+    } else {
+      const double det = S[0][0] * S[1][1] - S[0][1] * S[1][0];
+      S_inv[0][0] = S[1][1] / det;
+      S_inv[0][1] = -S[0][1] / det;
+      S_inv[1][0] = -S[1][0] / det;
+      S_inv[1][1] = S[0][0] / det;
+    }
+
+    double K[MAX_NUM_STATES][2] = {{0}};
+    for (int i = 0; i < n; i++) {
+      for (int a = 0; a < m; a++) {
+        for (int b = 0; b < m; b++) {
+          K[i][a] += PH[i][b] * S_inv[b][a];
+        }
+        x[i] += K[i][a] * y[a];
+      }
+    }
+    double P_new[MAX_NUM_STATES][MAX_NUM_STATES];
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        P_new[i][j] = P[i][j];
+        for (int a = 0; a < m; a++) {
+          P_new[i][j] -= K[i][a] * PH[j][a];
+        }
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        P[i][j] = P_new[i][j];
+      }
+    }
+  }
+};
+
+/* kalman filter test --------------------------------------------------------*/
+class KalmanFilterTest : public Test {
+ protected:
+  /**
+   * @brief Function to set up a filter of n states and its reference, where
+   * each state is the integral of the next one.
+   *
+   * @param n The number of states.
+   */
+  void set_up(const int n) {
+    const float dt = 0.01F;
+    for (int i = 0; i < n; i++) {
+      x0_[i] = 0.0F;
+      for (int j = 0; j < n; j++) {
+        F_[i * n + j] = i == j ? 1.0F : (j == i + 1 ? dt : 0.0F);
+        Q_[i * n + j] = i == j ? 1e-4F * (i + 1) : 0.0F;
+        P0_[i * n + j] = i == j ? 1.0F : 0.0F;
+      }
+    }
+    KalmanFilter_ctor(&filter_, n, F_, Q_, x0_, P0_);
+
+    reference_.n = n;
+    for (int i = 0; i < n; i++) {
+      reference_.x[i] = x0_[i];
+      for (int j = 0; j < n; j++) {
+        reference_.P[i][j] = P0_[i * n + j];
+      }
+    }
+  }
+
+  void expect_near_reference(const double tolerance) {
+    const int n = reference_.n;
+    for (int i = 0; i < n; i++) {
+      EXPECT_NEAR(KalmanFilter_get_state(&filter_, i), reference_.x[i],
+                  tolerance * (1.0 + std::fabs(reference_.x[i])));
+      for (int j = 0; j < n; j++) {
+        EXPECT_NEAR(KalmanFilter_get_covariance(&filter_, i, j),
+                    reference_.P[i][j],
+                    tolerance * (1.0 + std::fabs(reference_.P[i][j])));
+      }
+    }
+  }
+
+  KalmanFilter filter_;
+
+  ReferenceKalmanFilter reference_;
+
+  float F_[MAX_NUM_STATES * MAX_NUM_STATES];
+
+  float Q_[MAX_NUM_STATES * MAX_NUM_STATES];
+
+  float x0_[MAX_NUM_STATES];
+
+  float P0_[MAX_NUM_STATES * MAX_NUM_STATES];
+};
+
+TEST_F(KalmanFilterTest, ConstantVelocity) {
+  set_up(2);
+  const float H[2] = {1.0F, 0.0F};
+
+  // position measurement of constant velocity with noise
+  for (int i = 0; i < 2000; i++) {
+    const float noise = (float)((i * 7919) % 101 - 50) / 5000.0F;
+    KalmanFilter_predict(&filter_);
+    EXPECT_EQ(KalmanFilter_update(&filter_, H, 1e-4F, 3.0F * 0.01F * i + noise),
+              ModuleOK);
+  }
+  EXPECT_NEAR(KalmanFilter_get_state(&filter_, 1), 3.0F, 0.1F);
+}
+
+TEST_F(KalmanFilterTest, Reference) {
+  for (int n = KALMAN_FILTER_MIN_NUM_STATES; n <= KALMAN_FILTER_MAX_NUM_STATES;
+       n++) {
+    set_up(n);
+    float H[MAX_NUM_STATES];
+    for (int i = 0; i < n; i++) {
+      H[i] = i == 0 ? 1.0F : 0.1F * i;
+    }
+    const float R = 0.01F;
+
+    for (int i = 0; i < NUM_STEPS; i++) {
+      const float z = std::sin(0.05F * i);
+      KalmanFilter_predict(&filter_);
+      reference_.predict(F_, Q_);
+      EXPECT_EQ(KalmanFilter_update(&filter_, H, R, z), ModuleOK);
+      reference_.update(H, &R, &z, 1);
+    }
+    SCOPED_TRACE(n);
+    expect_near_reference(1e-3);
+  }
+}
+
+TEST_F(KalmanFilterTest, SequentialUpdate) {
+  // sequential scalar updates equal a vector update with diagonal noise
+  set_up(3);
+  const float H[2 * 3] = {1.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.5F};
+  const float R[2] = {0.01F, 0.04F};
+
+  for (int i = 0; i < NUM_STEPS; i++) {
+    const float z[2] = {std::sin(0.05F * i), std::cos(0.05F * i)};
+    KalmanFilter_predict(&filter_);
+    reference_.predict(F_, Q_);
+    EXPECT_EQ(KalmanFilter_update_sequential(&filter_, H, R, z, 2), ModuleOK);
+    reference_.update(H, R, z, 2);
+  }
+  expect_near_reference(1e-3);
+}
+
+TEST_F(KalmanFilterTest, SymmetricCovariance) {
+  set_up(KALMAN_FILTER_MAX_NUM_STATES);
+  const float H[MAX_NUM_STATES] = {1.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F};
+
+  for (int i = 0; i < 10 * NUM_STEPS; i++) {
+    KalmanFilter_predict(&filter_);
+    KalmanFilter_update(&filter_, H, 1e-6F, (float)i);
+  }
+  for (int i = 0; i < MAX_NUM_STATES; i++) {
+    EXPECT_GT(KalmanFilter_get_covariance(&filter_, i, i), 0.0F);
+    for (int j = 0; j < MAX_NUM_STATES; j++) {
+      EXPECT_EQ(KalmanFilter_get_covariance(&filter_, i, j),
+                KalmanFilter_get_covariance(&filter_, j, i));
+    }
+  }
+}
+
+TEST_F(KalmanFilterTest, InvalidMeasurement) {
+  set_up(2);
+  const float H[2] = {0.0F, 0.0F};
+
+  EXPECT_EQ(KalmanFilter_update(&filter_, H, 0.0F, 1.0F), ModuleError);
+  EXPECT_EQ(KalmanFilter_get_state(&filter_, 0), 0.0F);
+  EXPECT_EQ(KalmanFilter_get_covariance(&filter_, 0, 0), 1.0F);
+}
+
+TEST_F(KalmanFilterTest, Benchmark) {
+  float sink = 0.0F;
+  for (int n = KALMAN_FILTER_MIN_NUM_STATES; n <= KALMAN_FILTER_MAX_NUM_STATES;
+       n++) {
+    set_up(n);
+    float H[MAX_NUM_STATES] = {1.0F};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_BENCHMARK_STEPS; i++) {
+      KalmanFilter_predict(&filter_);
+      KalmanFilter_update(&filter_, H, 0.01F, (float)(i & 0xFF));
+    }
+    const double ns_per_step =
+        std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start)
+            .count() /
+        NUM_BENCHMARK_STEPS;
+    std::cout << "[ BENCHMARK] " << n << " state kalman filter: "
+              << ns_per_step << " ns/step" << std::endl;
+    sink += KalmanFilter_get_state(&filter_, 0);
+  }
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }
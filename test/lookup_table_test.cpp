@@ -0,0 +1,381 @@
+// stl include
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+extern "C" {
+// freertos include
+#include "FreeRTOS.h"
+
+// stm32_module include
+#include "stm32_module/stm32_module.h"
+}
+
+// gtest include
+#include "gtest/gtest.h"
+
+// mock include
+#include "mock/mock.hpp"
+
+using ::testing::Test;
+
+/* macro ---------------------------------------------------------------------*/
+#define NUM_POINTS 17
+#define NUM_X 9
+#define NUM_Y 7
+#define NUM_SAMPLES 1000
+#define BLOCK_SIZE 256
+#define NUM_BENCHMARK_BLOCKS 4000
+
+/* reference implementation --------------------------------------------------*/
+/**
+ * @brief Function to interpolate by hand with a linear search and a division
+ * per data, as done before the lookup table.
+ *
+ * @param x Breakpoints in strictly increasing order.
+ * @param y Value at each breakpoint.
+ * @param num_points The number of breakpoints.
+ * @param data The data.
+ * @return float The interpolated value.
+ */
+static float interpolate(const float* x, const float* y, const int num_points,
+                         const float data) {
+  if (data <= x[0]) {
+    return y[0];
+  }
+  for (int i = 1; i < num_points; i++) {
+    if (data < x[i]) {
+      return y[i - 1] +
+             (y[i] - y[i - 1]) * (data - x[i - 1]) / (x[i] - x[i - 1]);
+    }
+  }
+  return y[num_points - 1];
+}
+
+/**
+ * @brief Function to print the cost per lookup of a benchmark.
+ *
+ * @param name The name of the benchmark.
+ * @param start The start time of the benchmark.
+ * @return double Cost per lookup in ns.
+ */
+static double report_benchmark(
+    const char* name, const std::chrono::steady_clock::time_point start) {
+  const double ns_per_lookup =
+      std::chrono::duration<double, std::nano>(
+          std::chrono::steady_clock::now() - start)
+          .count() /
+      (NUM_BENCHMARK_BLOCKS * BLOCK_SIZE);
+  std::cout << "[ BENCHMARK] " << name << ": " << ns_per_lookup
+            << " ns/lookup" << std::endl;
+  return ns_per_lookup;
+}
+
+/* lookup table test ---------------------------------------------------------*/
+class LookupTableTest : public Test {
+ protected:
+  void SetUp() override {
+    // quadratic pedal curve on uniform breakpoints
+    for (int i = 0; i < NUM_POINTS; i++) {
+      uniform_x_[i] = (float)i / (NUM_POINTS - 1);
+      uniform_y_[i] = uniform_x_[i] * uniform_x_[i];
+    }
+
+    // thermistor curve on breakpoints denser at the ends
+    for (int i = 0; i < NUM_POINTS; i++) {
+      const float t = (float)i / (NUM_POINTS - 1) * 2.0F - 1.0F;
+      x_[i] = 0.5F + 0.5F * t * t * t;
+      y_[i] = 25.0F + 100.0F * std::log(1.0F + 3.0F * x_[i]);
+    }
+
+    // torque map of pedal and motor speed on non-uniform speed axis
+    for (int i = 0; i < NUM_X; i++) {
+      pedal_[i] = (float)i / (NUM_X - 1);
+    }
+    const float speed[NUM_Y] = {0.0F,    500.0F,  1000.0F, 2000.0F,
+                                4000.0F, 8000.0F, 12000.0F};
+    for (int j = 0; j < NUM_Y; j++) {
+      speed_[j] = speed[j];
+    }
+    for (int i = 0; i < NUM_X; i++) {
+      for (int j = 0; j < NUM_Y; j++) {
+        torque_[i * NUM_Y + j] =
+            pedal_[i] * 200.0F * (speed_[j] < 4000.0F ? 1.0F
+                                                       : 4000.0F / speed_[j]);
+      }
+    }
+
+    LookupTable1D_ctor(&uniform_table_, uniform_x_, uniform_y_,
+                       uniform_slope_, NUM_POINTS, NULL);
+    LookupTable1D_ctor(&table_, x_, y_, slope_, NUM_POINTS, NULL);
+    LookupTable2D_ctor(&torque_table_, pedal_, speed_, torque_,
+                       inverse_spacing_, NUM_X, NUM_Y);
+
+    for (int i = 0; i < NUM_POINTS; i++) {
+      y_q15_[i] = Q15_from_float(uniform_y_[i]);
+    }
+    // 16 segments of 2048 codes over [0, 1)
+    LookupTable1DQ15_ctor(&table_q15_, y_q15_, NUM_POINTS, 0, 11, NULL);
+
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      data_[i] = (float)((i * 37) % BLOCK_SIZE) / BLOCK_SIZE;
+    }
+  }
+
+  /**
+   * @brief Function to interpolate the torque map bilinearly by hand.
+   *
+   * @param pedal The pedal.
+   * @param speed The motor speed.
+   * @return float The torque.
+   */
+  float torque(const float pedal, const float speed) {
+    float row[NUM_X];
+    for (int i = 0; i < NUM_X; i++) {
+      row[i] = interpolate(speed_, &torque_[i * NUM_Y], NUM_Y, speed);
+    }
+    return interpolate(pedal_, row, NUM_X, pedal);
+  }
+
+  LookupTable1D uniform_table_;
+
+  LookupTable1D table_;
+
+  LookupTable2D torque_table_;
+
+  LookupTable1DQ15 table_q15_;
+
+  float uniform_x_[NUM_POINTS];
+
+  float uniform_y_[NUM_POINTS];
+
+  float uniform_slope_[NUM_POINTS - 1];
+
+  float x_[NUM_POINTS];
+
+  float y_[NUM_POINTS];
+
+  float slope_[NUM_POINTS - 1];
+
+  float pedal_[NUM_X];
+
+  float speed_[NUM_Y];
+
+  float torque_[NUM_X * NUM_Y];
+
+  float inverse_spacing_[NUM_X + NUM_Y - 2];
+
+  q15_t y_q15_[NUM_POINTS];
+
+  float data_[BLOCK_SIZE];
+
+  float filtered_data_[2][BLOCK_SIZE];
+};
+
+TEST_F(LookupTableTest, Uniform) {
+  EXPECT_NE(uniform_table_.inverse_step_, 0.0F);
+  for (int i = 0; i <= NUM_SAMPLES; i++) {
+    const float x = (float)i / NUM_SAMPLES * 1.2F - 0.1F;
+    EXPECT_NEAR(LookupTable1D_lookup(&uniform_table_, x),
+                interpolate(uniform_x_, uniform_y_, NUM_POINTS, x), 1e-6F);
+  }
+}
+
+TEST_F(LookupTableTest, NearUniform) {
+  // kinks at breakpoints off the nominal spacing within the tolerance
+  const float step = 1.0F / (NUM_POINTS - 1);
+  const float deviation = 0.5e-3F * step;
+  float x[NUM_POINTS];
+  float y[NUM_POINTS];
+  float slope[NUM_POINTS - 1];
+  for (int i = 0; i < NUM_POINTS; i++) {
+    x[i] = (float)i * step;
+  }
+  x[4] -= deviation;
+  x[8] += deviation;
+  for (int i = 0; i < NUM_POINTS; i++) {
+    y[i] = 1000.0F * (std::fabs(x[i] - x[4]) + std::fabs(x[i] - x[8]));
+  }
+  LookupTable1D table;
+  LookupTable1D_ctor(&table, x, y, slope, NUM_POINTS, NULL);
+  EXPECT_NE(table.inverse_step_, 0.0F);
+
+  // data between the nominal and the actual breakpoint
+  const float data[] = {4.0F * step - 0.5F * deviation,
+                        8.0F * step + 0.5F * deviation};
+  for (const float d : data) {
+    EXPECT_NEAR(LookupTable1D_lookup(&table, d),
+                interpolate(x, y, NUM_POINTS, d), 1e-3F);
+  }
+  for (int i = 0; i <= NUM_SAMPLES; i++) {
+    const float d = (float)i / NUM_SAMPLES;
+    EXPECT_NEAR(LookupTable1D_lookup(&table, d),
+                interpolate(x, y, NUM_POINTS, d), 1e-3F);
+  }
+}
+
+TEST_F(LookupTableTest, NonUniform) {
+  EXPECT_EQ(table_.inverse_step_, 0.0F);
+  for (int i = 0; i <= NUM_SAMPLES; i++) {
+    const float x = (float)i / NUM_SAMPLES * 1.2F - 0.1F;
+    EXPECT_NEAR(LookupTable1D_lookup(&table_, x),
+                interpolate(x_, y_, NUM_POINTS, x), 1e-4F);
+  }
+}
+
+TEST_F(LookupTableTest, Breakpoints) {
+  for (int i = 0; i < NUM_POINTS; i++) {
+    EXPECT_FLOAT_EQ(LookupTable1D_lookup(&uniform_table_, uniform_x_[i]),
+                    uniform_y_[i]);
+    EXPECT_FLOAT_EQ(LookupTable1D_lookup(&table_, x_[i]), y_[i]);
+  }
+
+  // saturated out of the breakpoints
+  EXPECT_EQ(LookupTable1D_lookup(&table_, -1.0F), y_[0]);
+  EXPECT_EQ(LookupTable1D_lookup(&table_, 2.0F), y_[NUM_POINTS - 1]);
+  EXPECT_EQ(LookupTable1D_lookup(&table_, NAN), y_[0]);
+}
+
+TEST_F(LookupTableTest, FilterStage) {
+  // linearize the moving average of data
+  float buffer[2][4];
+  MovingAverageFilter moving_average_filter[2];
+  LookupTable1D table[2];
+  float slope[2][NUM_POINTS - 1];
+  for (int i = 0; i < 2; i++) {
+    MovingAverageFilter_ctor(&moving_average_filter[i], buffer[i], 4, NULL);
+    LookupTable1D_ctor(&table[i], x_, y_, slope[i], NUM_POINTS,
+                       (Filter*)&moving_average_filter[i]);
+  }
+
+  int length = 0;
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    if (LookupTable1D_update(&table[0], data_[i],
+                             &filtered_data_[0][length]) == ModuleOK) {
+      length++;
+    }
+  }
+  int filtered_length;
+  EXPECT_EQ(LookupTable1D_update_block(&table[1], data_, data_, BLOCK_SIZE,
+                                       &filtered_length),
+            ModuleOK);
+  ASSERT_EQ(filtered_length, length);
+  EXPECT_EQ(length, BLOCK_SIZE - 3);
+  for (int i = 0; i < length; i++) {
+    EXPECT_EQ(data_[i], filtered_data_[0][i]);
+  }
+
+  float filtered_data;
+  EXPECT_EQ(LookupTable1D_get_filtered_data(&table[1], &filtered_data),
+            ModuleOK);
+  EXPECT_EQ(filtered_data, filtered_data_[0][length - 1]);
+}
+
+TEST_F(LookupTableTest, Table2D) {
+  EXPECT_NE(torque_table_.x_inverse_step_, 0.0F);
+  EXPECT_EQ(torque_table_.y_inverse_step_, 0.0F);
+  for (int i = 0; i <= 50; i++) {
+    for (int j = 0; j <= 50; j++) {
+      const float pedal = (float)i / 50 * 1.2F - 0.1F;
+      const float speed = (float)j / 50 * 14000.0F - 1000.0F;
+      EXPECT_NEAR(LookupTable2D_lookup(&torque_table_, pedal, speed),
+                  torque(pedal, speed), 1e-3F);
+    }
+  }
+}
+
+TEST_F(LookupTableTest, Q15) {
+  for (int i = 0; i < NUM_SAMPLES; i++) {
+    const q15_t x = (q15_t)(i * 32767 / NUM_SAMPLES);
+    EXPECT_NEAR(
+        Q15_to_float(LookupTable1DQ15_lookup(&table_q15_, x)),
+        LookupTable1D_lookup(&uniform_table_, Q15_to_float(x)), 2.0F / 32768);
+  }
+  EXPECT_EQ(LookupTable1DQ15_lookup(&table_q15_, -100), y_q15_[0]);
+
+  // same as lookup one by one in place
+  q15_t x[BLOCK_SIZE];
+  q15_t y[BLOCK_SIZE];
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    x[i] = Q15_from_float(data_[i]);
+    y[i] = LookupTable1DQ15_lookup(&table_q15_, x[i]);
+  }
+  LookupTable1DQ15_lookup_block(&table_q15_, x, x, BLOCK_SIZE);
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    EXPECT_EQ(x[i], y[i]);
+  }
+
+  // as a filter stage in float
+  float filtered_data;
+  EXPECT_EQ(Filter_update((Filter*)&table_q15_, 0.5F, &filtered_data),
+            ModuleOK);
+  EXPECT_NEAR(filtered_data, 0.25F, 1.0F / 32768);
+}
+
+TEST_F(LookupTableTest, Benchmark) {
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[0][i] =
+          interpolate(uniform_x_, uniform_y_, NUM_POINTS, data_[i]);
+    }
+    sink += filtered_data_[0][block % BLOCK_SIZE];
+  }
+  report_benchmark("interpolation by hand", start);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[1][i] = LookupTable1D_lookup(&uniform_table_, data_[i]);
+    }
+    sink += filtered_data_[1][block % BLOCK_SIZE];
+  }
+  report_benchmark("uniform lookup table", start);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    int filtered_length;
+    LookupTable1D_update_block(&uniform_table_, data_, filtered_data_[1],
+                               BLOCK_SIZE, &filtered_length);
+    sink += filtered_data_[1][block % BLOCK_SIZE];
+  }
+  report_benchmark("uniform lookup table block", start);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[1][i] = LookupTable1D_lookup(&table_, data_[i]);
+    }
+    sink += filtered_data_[1][block % BLOCK_SIZE];
+  }
+  report_benchmark("non-uniform lookup table", start);
+
+  q15_t x[BLOCK_SIZE];
+  for (int i = 0; i < BLOCK_SIZE; i++) {
+    x[i] = Q15_from_float(data_[i]);
+  }
+  q15_t y[BLOCK_SIZE];
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    LookupTable1DQ15_lookup_block(&table_q15_, x, y, BLOCK_SIZE);
+    sink += y[block % BLOCK_SIZE];
+  }
+  report_benchmark("q15 lookup table block", start);
+
+  start = std::chrono::steady_clock::now();
+  for (int block = 0; block < NUM_BENCHMARK_BLOCKS; block++) {
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+      filtered_data_[1][i] = LookupTable2D_lookup(
+          &torque_table_, data_[i], data_[BLOCK_SIZE - 1 - i] * 12000.0F);
+    }
+    sink += filtered_data_[1][block % BLOCK_SIZE];
+  }
+  report_benchmark("2d lookup table", start);
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }
@@ -378,6 +378,46 @@ TEST_F(SharedResourceTest, AccessTest) {
   SharedResource_end_access(&can_resource_);
 }
 
+/* SeqLock test --------------------------------------------------------------*/
+struct seq_lock_data {
+  uint32_t a;
+  uint32_t b;
+};
+
+class SeqLockTest : public Test {
+ protected:
+  void SetUp() override {
+    SeqLock_ctor(&seq_lock_, seq_lock_buffer_, sizeof(struct seq_lock_data));
+  }
+
+  SeqLock seq_lock_;
+
+  struct seq_lock_data seq_lock_buffer_[2];
+};
+
+TEST_F(SeqLockTest, InitialData) {
+  struct seq_lock_data data = {1, 1};
+
+  EXPECT_EQ(SeqLock_read(&seq_lock_, &data), 0);
+  EXPECT_EQ(data.a, 0);
+  EXPECT_EQ(data.b, 0);
+}
+
+TEST_F(SeqLockTest, WriteRead) {
+  struct seq_lock_data data;
+
+  for (uint32_t i = 1; i <= REPEATED_TEST_TIMES; i++) {
+    data = {i, 2 * i};
+    SeqLock_write(&seq_lock_, &data);
+    EXPECT_EQ(SeqLock_get_sequence(&seq_lock_), 2 * i);
+
+    data = {0, 0};
+    EXPECT_EQ(SeqLock_read(&seq_lock_, &data), 2 * i);
+    EXPECT_EQ(data.a, i);
+    EXPECT_EQ(data.b, 2 * i);
+  }
+}
+
 /* task initialization test --------------------------------------------------*/
 TEST(TaskInitTest, TaskCtor) {
   Task task;
@@ -0,0 +1,206 @@
+// stl include
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+extern "C" {
+// freertos include
+#include "FreeRTOS.h"
+
+// stm32_module include
+#include "stm32_module/stm32_module.h"
+}
+
+// gtest include
+#include "gtest/gtest.h"
+
+// mock include
+#include "mock/mock.hpp"
+
+using ::testing::Test;
+
+/* macro ---------------------------------------------------------------------*/
+#define TIME_CONSTANT 100.0F
+#define PERIOD 10
+#define MAX_LENGTH 8
+#define NUM_BENCHMARK_SAMPLES 1000000
+
+/**
+ * @brief Function to get the timestamp of irregular samples with jitter and
+ * occasional dropouts around a nominal period.
+ *
+ * @param i The index of the sample.
+ * @return uint32_t The timestamp.
+ */
+static uint32_t jittered_timestamp(const int i) {
+  const uint32_t jitter = ((uint32_t)i * 7919U) % 7U;
+  const uint32_t dropout = i >= 50 ? 200 : 0;
+  return (uint32_t)(i * PERIOD) + jitter + dropout;
+}
+
+/* timed filter test ---------------------------------------------------------*/
+class TimedFilterTest : public Test {
+ protected:
+  void SetUp() override {
+    TimedExponentialFilter_ctor(&exponential_filter_, TIME_CONSTANT);
+    TimedKalmanFilter1D_ctor(&kalman_filter_, 0.01F, 1.0F, 0.0F, 1.0F);
+    LinearResampler_ctor(&resampler_, PERIOD);
+  }
+
+  TimedExponentialFilter exponential_filter_;
+
+  TimedKalmanFilter1D kalman_filter_;
+
+  LinearResampler resampler_;
+
+  float resampled_data_[MAX_LENGTH];
+};
+
+TEST_F(TimedFilterTest, ExponentialStepResponse) {
+  float filtered_data;
+  EXPECT_EQ(
+      TimedExponentialFilter_get_filtered_data(&exponential_filter_,
+                                               &filtered_data),
+      ModuleBusy);
+  EXPECT_EQ(TimedExponentialFilter_update(&exponential_filter_, 0.0F, 0),
+            0.0F);
+
+  // step response depends only on time however the step is sampled
+  for (int i = 1; i < 100; i++) {
+    const uint32_t timestamp = jittered_timestamp(i);
+    EXPECT_NEAR(
+        TimedExponentialFilter_update(&exponential_filter_, 1.0F, timestamp),
+        1.0F - std::exp(-(float)timestamp / TIME_CONSTANT), 1e-5F);
+  }
+  EXPECT_EQ(TimedExponentialFilter_get_filtered_data(&exponential_filter_,
+                                                     &filtered_data),
+            ModuleOK);
+
+  // repeated timestamp does not move the filter
+  const uint32_t timestamp = jittered_timestamp(99);
+  EXPECT_EQ(
+      TimedExponentialFilter_update(&exponential_filter_, -1.0F, timestamp),
+      filtered_data);
+}
+
+TEST_F(TimedFilterTest, ExponentialWrapAround) {
+  TimedExponentialFilter reference;
+  TimedExponentialFilter_ctor(&reference, TIME_CONSTANT);
+
+  const uint32_t offset = UINT32_MAX - 5 * PERIOD;
+  for (int i = 0; i < 20; i++) {
+    const float data = std::sin(0.3F * i);
+    const uint32_t timestamp = jittered_timestamp(i);
+    EXPECT_EQ(TimedExponentialFilter_update(&exponential_filter_, data,
+                                            offset + timestamp),
+              TimedExponentialFilter_update(&reference, data, timestamp));
+  }
+}
+
+TEST_F(TimedFilterTest, KalmanDropout) {
+  double x = 0.0;
+  double P = 1.0;
+  uint32_t last_timestamp = 0;
+  for (int i = 0; i < 100; i++) {
+    const float z = 1.0F + 0.1F * std::sin(0.5F * i);
+    const uint32_t timestamp = jittered_timestamp(i);
+
+    // reference in double, without prediction for the first measurement
+    if (i > 0) {
+      P += 0.01 * (timestamp - last_timestamp);
+    }
+    const double K = P / (P + 1.0);
+    x += K * (z - x);
+    P = (1.0 - K) * P;
+    last_timestamp = timestamp;
+
+    EXPECT_NEAR(TimedKalmanFilter1D_update(&kalman_filter_, z, timestamp), x,
+                1e-5);
+  }
+  EXPECT_NEAR(TimedKalmanFilter1D_get_state(&kalman_filter_), x, 1e-5);
+
+  // covariance grows during dropout
+  EXPECT_NEAR(TimedKalmanFilter1D_get_covariance(&kalman_filter_,
+                                                 last_timestamp),
+              P, 1e-5);
+  EXPECT_NEAR(TimedKalmanFilter1D_get_covariance(&kalman_filter_,
+                                                 last_timestamp + 100),
+              P + 1.0, 1e-5);
+}
+
+TEST_F(TimedFilterTest, ResampleRamp) {
+  // irregular samples of a ramp resample to the ramp on the grid
+  const uint32_t start = jittered_timestamp(0);
+  int total_length = 0;
+  for (int i = 0; i < 50; i++) {
+    const uint32_t timestamp = jittered_timestamp(i);
+    const int length = LinearResampler_update(
+        &resampler_, 0.5F * (float)timestamp, timestamp, resampled_data_,
+        MAX_LENGTH);
+    for (int j = 0; j < length; j++) {
+      const uint32_t grid = start + (uint32_t)((total_length + j) * PERIOD);
+      EXPECT_FLOAT_EQ(resampled_data_[j], 0.5F * (float)grid);
+    }
+    total_length += length;
+  }
+  const uint32_t last = jittered_timestamp(49);
+  EXPECT_EQ(total_length, (int)((last - start) / PERIOD) + 1);
+
+  // data not later than the last data is ignored
+  EXPECT_EQ(LinearResampler_update(&resampler_, 0.0F, last, resampled_data_,
+                                   MAX_LENGTH),
+            0);
+}
+
+TEST_F(TimedFilterTest, ResampleDropout) {
+  EXPECT_EQ(LinearResampler_update(&resampler_, 0.0F, 0, resampled_data_,
+                                   MAX_LENGTH),
+            1);
+
+  // grid points beyond max length are skipped but the grid stays aligned
+  EXPECT_EQ(LinearResampler_update(&resampler_, 100.0F, 100 * PERIOD,
+                                   resampled_data_, MAX_LENGTH),
+            MAX_LENGTH);
+  for (int i = 0; i < MAX_LENGTH; i++) {
+    EXPECT_FLOAT_EQ(resampled_data_[i], (float)(i + 1));
+  }
+  EXPECT_EQ(LinearResampler_update(&resampler_, 100.0F, 100 * PERIOD + 25,
+                                   resampled_data_, MAX_LENGTH),
+            2);
+  EXPECT_FLOAT_EQ(resampled_data_[0], 100.0F);
+  EXPECT_FLOAT_EQ(resampled_data_[1], 100.0F);
+}
+
+TEST_F(TimedFilterTest, Benchmark) {
+  float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    sink += TimedExponentialFilter_update(&exponential_filter_,
+                                          (float)(i & 0xFF),
+                                          jittered_timestamp(i));
+  }
+  double ns_per_sample = std::chrono::duration<double, std::nano>(
+                             std::chrono::steady_clock::now() - start)
+                             .count() /
+                         NUM_BENCHMARK_SAMPLES;
+  std::cout << "[ BENCHMARK] timed exponential filter: " << ns_per_sample
+            << " ns/sample" << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+    sink += TimedKalmanFilter1D_update(&kalman_filter_, (float)(i & 0xFF),
+                                       jittered_timestamp(i));
+  }
+  ns_per_sample = std::chrono::duration<double, std::nano>(
+                      std::chrono::steady_clock::now() - start)
+                      .count() /
+                  NUM_BENCHMARK_SAMPLES;
+  std::cout << "[ BENCHMARK] timed kalman filter 1d: " << ns_per_sample
+            << " ns/sample" << std::endl;
+
+  EXPECT_TRUE(std::isfinite(sink));
+}
+
+int main(int argc, char** argv) { return mock::run_freertos_test(&argc, argv); }